@@ -265,6 +265,10 @@ inline void configuration::fast_separator( PartitionConfig & partition_config )
 inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.filename_output                        = "";
         partition_config.use_mmap_io = false;
+        partition_config.relabeling_type                        = RELABELING_NONE;
+        partition_config.hierarchy_memory_budget                = 0;
+        partition_config.hierarchy_spill_directory              = ".";
+        partition_config.compress_finest_level                  = false;
         partition_config.seed                                   = 0;
         partition_config.fast                                   = false;
         partition_config.mode_node_separators                   = false;
@@ -273,6 +277,7 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.first_level_random_matching            = false;
         partition_config.initial_partitioning_repetitions       = 5;
         partition_config.edge_rating_tiebreaking                = false;
+        partition_config.gpa_parallel_sort                      = false;
         partition_config.edge_rating                            = WEIGHT;
         partition_config.matching_type                          = MATCHING_RANDOM;
         partition_config.permutation_quality                    = PERMUTATION_QUALITY_FAST;
@@ -314,6 +319,9 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.mh_penalty_for_unconnected             = false;
         partition_config.mh_no_mh                               = false;
         partition_config.mh_optimize_communication_volume       = false; 
+        partition_config.mh_checkpoint_dir                      = "";
+        partition_config.mh_checkpoint_interval                 = 600;
+        partition_config.mh_resume                              = false;
         partition_config.use_bucket_queues                      = true; 
         partition_config.walshaw_mh_repetitions                 = 50;
         partition_config.scaleing_factor                        = 1;
@@ -451,11 +459,15 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.sep_edge_rating_during_ip     = SEPARATOR_MULTX;
 
         partition_config.enable_mapping                    = false;
+        partition_config.parallel_mapping_local_search     = false;
+        partition_config.parallel_multisection             = false;
         partition_config.ls_neighborhood                   = COMMUNICATIONGRAPH;
         partition_config.communication_neighborhood_dist   = 10;
         partition_config.construction_algorithm            = MAP_CONST_FASTHIERARCHY_TOPDOWN;
         partition_config.distance_construction_algorithm   = DIST_CONST_HIERARCHY;
         partition_config.search_space_s                    = 64;
+        partition_config.topology_filename                 = "";
+        partition_config.topology_cache_size               = 512;
         partition_config.preconfiguration_mapping          = PRE_CONFIG_MAPPING_ECO;
         partition_config.max_recursion_levels_construction = std::numeric_limits< int >::max();
 
@@ -480,6 +492,7 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
                 //triangle_contraction};
 
         partition_config.dissection_rec_limit = 120;
+        partition_config.dissection_auto_rec_limit = false;
         partition_config.disable_reductions = false;
 
         partition_config.ilp_min_gain = -1;
@@ -16,7 +16,7 @@
 #include "balance_configuration.h"
 #include "data_structure/graph_access.h"
 #include "data_structure/matrix/normal_matrix.h"
-#include "data_structure/matrix/online_distance_matrix.h"
+#include "data_structure/matrix/hierarchical_distance_matrix.h"
 #include "graph_io.h"
 #include "mmap_graph_io.h"
 #include "macros_assertions.h"
@@ -118,16 +118,22 @@ int main(int argn, char **argv) {
                 C.setNodeWeight(node, 1);
         } endfor
 
-        if(!power_of_two ) {
+        if( partition_config.distance_construction_algorithm == DIST_CONST_TOPOLOGY ) {
                 t.restart();
                 mapping_algorithms ma;
-                if( partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
+                qap = ma.construct_a_mapping_on_topology(partition_config, C, perm_rank);
+                std::cout <<  "time spent for mapping " << t.elapsed()  << std::endl;
+        } else if(!power_of_two ) {
+                t.restart();
+                mapping_algorithms ma;
+                if( partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY
+                    && partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
                         normal_matrix D(partition_config.k, partition_config.k);
                         ma.construct_a_mapping(partition_config, C, D, perm_rank);
                         std::cout <<  "time spent for mapping " << t.elapsed()  << std::endl;
                         qap = qm.total_qap(C, D, perm_rank );
                 } else {
-                        online_distance_matrix D(partition_config.k, partition_config.k);
+                        hierarchical_distance_matrix D(partition_config.k, partition_config.k);
                         D.setPartitionConfig(partition_config);
                         ma.construct_a_mapping(partition_config, C, D, perm_rank);
                         std::cout <<  "time spent for mapping " << t.elapsed()  << std::endl;
@@ -140,7 +146,7 @@ int main(int argn, char **argv) {
                         perm_rank[i] = i;
                 }
 
-                online_distance_matrix D(partition_config.k, partition_config.k);
+                hierarchical_distance_matrix D(partition_config.k, partition_config.k);
                 D.setPartitionConfig(partition_config);
                 qap = qm.total_qap(C, D, perm_rank );
         }
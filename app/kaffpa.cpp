@@ -16,8 +16,9 @@
 #include "balance_configuration.h"
 #include "data_structure/graph_access.h"
 #include "data_structure/matrix/normal_matrix.h"
-#include "data_structure/matrix/online_distance_matrix.h"
+#include "data_structure/matrix/hierarchical_distance_matrix.h"
 #include "graph_io.h"
+#include "graph_relabeling.h"
 #include "macros_assertions.h"
 #include "mapping/mapping_algorithms.h"
 #include "mmap_graph_io.h"
@@ -66,6 +67,15 @@ int main(int argn, char **argv) {
         }
         std::cout << "io time: " << t.elapsed()  << std::endl;
 
+        graph_relabeling relabeling;
+        std::vector<NodeID> new_id;
+        if(partition_config.relabeling_type != RELABELING_NONE) {
+                t.restart();
+                relabeling.compute_ordering(partition_config, G, new_id);
+                relabeling.relabel(G, new_id);
+                std::cout << "relabeling time: " << t.elapsed()  << std::endl;
+        }
+
         G.set_partition_count(partition_config.k); 
 
         balance_configuration bc;
@@ -132,16 +142,22 @@ int main(int argn, char **argv) {
                         C.setNodeWeight(node, 1);
                 } endfor
 
-                if(!power_of_two ) {
+                if( partition_config.distance_construction_algorithm == DIST_CONST_TOPOLOGY ) {
                         t.restart();
                         mapping_algorithms ma;
-                        if( partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
+                        qap = ma.construct_a_mapping_on_topology(partition_config, C, perm_rank);
+                        std::cout <<  "time spent for mapping " << t.elapsed()  << std::endl;
+                } else if(!power_of_two ) {
+                        t.restart();
+                        mapping_algorithms ma;
+                        if( partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY
+                            && partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
                                 normal_matrix D(partition_config.k, partition_config.k);
                                 ma.construct_a_mapping(partition_config, C, D, perm_rank);
                                 std::cout <<  "time spent for mapping " << t.elapsed()  << std::endl;
                                 qap = qm.total_qap(C, D, perm_rank );
                         } else {
-                                online_distance_matrix D(partition_config.k, partition_config.k);
+                                hierarchical_distance_matrix D(partition_config.k, partition_config.k);
                                 D.setPartitionConfig(partition_config);
                                 ma.construct_a_mapping(partition_config, C, D, perm_rank);
                                 std::cout <<  "time spent for mapping " << t.elapsed()  << std::endl;
@@ -154,7 +170,7 @@ int main(int argn, char **argv) {
                                 perm_rank[i] = i;
                         }
 
-                        online_distance_matrix D(partition_config.k, partition_config.k);
+                        hierarchical_distance_matrix D(partition_config.k, partition_config.k);
                         D.setPartitionConfig(partition_config);
                         qap = qm.total_qap(C, D, perm_rank );
                 }
@@ -174,6 +190,11 @@ int main(int argn, char **argv) {
                         G.setPartitionIndex(node, perm_rank[G.getPartitionIndex(node)]);
                 } endfor
         }
+        if(partition_config.relabeling_type != RELABELING_NONE) {
+                t.restart();
+                relabeling.restore(G, new_id);
+                std::cout << "time spent for restoring the node order " << t.elapsed()  << std::endl;
+        }
         // ******************************* done partitioning *****************************************       
         // output some information about the partition that we have computed 
         std::cout << "cut \t\t"         << qm.edge_cut(G)                 << std::endl;
@@ -0,0 +1,54 @@
+/*
+ * Author: Wolfgang Ost
+ */
+
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "io/graph_io.h"
+#include "node_ordering/ordering_tools.h"
+#include "timer.h"
+
+// Evaluates a node ordering by a symbolic Cholesky factorization of the graph,
+// the ordering is given in the format written by node_ordering
+int main(int argn, char **argv) {
+        if (argn != 3) {
+                std::cout << "Usage: ordering_evaluator FILE ORDERING" << std::endl;
+                exit(0);
+        }
+
+        std::string graph_filename(argv[1]);
+        std::string ordering_filename(argv[2]);
+
+        graph_access G;
+        if (graph_io::readGraphWeighted(G, graph_filename)) {
+                return 1;
+        }
+
+        // Evaluate the elimination of the original matrix, ignore node weights
+        forall_nodes(G, node) {
+                G.setNodeWeight(node, 1);
+        } endfor
+
+        std::vector<NodeID> ordering;
+        if (!read_ordering(ordering_filename, ordering) || ordering.size() != G.number_of_nodes()) {
+                std::cerr << "Ordering " << ordering_filename << " is not a permutation of the "
+                          << G.number_of_nodes() << " nodes of the graph" << std::endl;
+                return 1;
+        }
+
+        timer t;
+        factorization_statistics stats = symbolic_factorization(G, ordering);
+
+        std::cout << "graph has " << G.number_of_nodes() << " nodes and " << G.number_of_edges() << " edges" << std::endl;
+        std::cout << "time spent for symbolic factorization " << t.elapsed() << std::endl;
+        std::cout << "Number of fill-edges: " << stats.fill << std::endl;
+        std::cout << "Nonzeros in factor: " << stats.nonzeros << std::endl;
+        std::cout << "Factorization flops: " << stats.flops << std::endl;
+        std::cout << "Elimination tree height: " << stats.etree_height << std::endl;
+
+        return 0;
+}
@@ -28,7 +28,12 @@ int parse_parameters(int argn, char **argv,
         // Setup argtable parameters.
         struct arg_lit *help                                 = arg_lit0(NULL, "help","Print help.");
         struct arg_lit *use_mmap_io                          = arg_lit0(NULL, "mmap_io", "Use mmap graph IO (experimental).");
+        struct arg_rex *relabeling_type                      = arg_rex0(NULL, "relabel", "^(none|bfs|rcm|degree)$", "TYPE", REG_EXTENDED, "Relabel the nodes of the input graph for locality before partitioning. One of {none, bfs, rcm, degree}. The partition is written in the original node order. Default: none.");
+        struct arg_dbl *hierarchy_memory_budget              = arg_dbl0(NULL, "hierarchy_memory_budget", NULL, "Memory in MB the finer levels of the multilevel hierarchy may use. Levels above the budget are moved to disk until uncoarsening reaches them. Default: 0 (disabled).");
+        struct arg_str *hierarchy_spill_dir                  = arg_str0(NULL, "hierarchy_spill_dir", NULL, "Directory for the levels moved to disk by --hierarchy_memory_budget. Default: current directory.");
+        struct arg_lit *compress_finest_level                = arg_lit0(NULL, "compress_finest_level", "Keep the input graph compressed in memory while the coarser levels are partitioned. Saves memory for graphs with id locality and unit edge weights. Default: disabled.");
         struct arg_lit *edge_rating_tiebreaking              = arg_lit0(NULL, "edge_rating_tiebreaking","Enable random edgerating tiebreaking.");
+        struct arg_lit *gpa_parallel_sort                    = arg_lit0(NULL, "gpa_parallel_sort", "Sort the edges of the GPA matching in parallel. The result does not depend on the number of threads, but differs from the sequential sort. Default: disabled.");
         struct arg_lit *match_islands                        = arg_lit0(NULL, "match_islands","Enable matching of islands during gpa algorithm.");
         struct arg_lit *only_first_level                     = arg_lit0(NULL, "only_first_level","Disable Multilevel Approach. Only perform on the first level. (Currently only initial partitioning).");
         struct arg_lit *graph_weighted                       = arg_lit0(NULL, "weighted","Read the graph as weighted graph.");
@@ -70,6 +75,9 @@ int parse_parameters(int argn, char **argv,
         struct arg_lit *mh_enable_tournament_selection       = arg_lit0(NULL, "mh_enable_tournament_selection", "Enables the tournament selection roule instead of choosing two random inidiviuums.");
         struct arg_lit *mh_cross_combine_original_k          = arg_lit0(NULL, "mh_cross_combine_original_k", "");
         struct arg_lit *mh_optimize_communication_volume     = arg_lit0(NULL, "mh_optimize_communication_volume", "Fitness function is modified to optimize communication volume instead of the number of cut edges.");
+        struct arg_str *mh_checkpoint_dir                    = arg_str0(NULL, "mh_checkpoint_dir", NULL, "Directory to which each island periodically writes its population (Default: disabled).");
+        struct arg_dbl *mh_checkpoint_interval               = arg_dbl0(NULL, "mh_checkpoint_interval", NULL, "Time in s between two checkpoints of an island (Default: 600s).");
+        struct arg_lit *mh_resume                            = arg_lit0(NULL, "mh_resume", "Seed the islands from the checkpoints found in mh_checkpoint_dir.");
         struct arg_lit *disable_balance_singletons           = arg_lit0(NULL, "disable_balance_singletons", "");
         struct arg_lit *gpa_grow_internal                    = arg_lit0(NULL, "gpa_grow_internal", "If the graph is allready partitions the paths are grown only block internally.");
         struct arg_int *initial_partitioning_repetitions     = arg_int0(NULL, "initial_partitioning_repetitions", NULL, "Number of initial partitioning repetitons. Default: 5.");
@@ -189,9 +197,14 @@ int parse_parameters(int argn, char **argv,
 
 #endif
         struct arg_lit *online_distances                     = arg_lit0(NULL, "online_distances", "Do not store processor distances in a matrix, but do recomputation. (Default: disabled)");
+        struct arg_str *topology_graph                       = arg_str0(NULL, "topology_graph", NULL, "Network of the PEs in METIS format. Distances are shortest paths (hops if unweighted) and are computed on demand. Replaces hierarchy and distance strings for the mapping, k has to be the number of nodes of the network.");
+        struct arg_dbl *topology_cache_size                  = arg_dbl0(NULL, "topology_cache_size", NULL, "Memory in MB for cached distances of the --topology_graph network. Default: 512.");
+        struct arg_lit *parallel_multisection                = arg_lit0(NULL, "parallel_multisection", "Partition the blocks of a hierarchy level as parallel tasks. The result does not depend on the number of threads. (Default: disabled)");
+        struct arg_lit *parallel_mapping_ls                  = arg_lit0(NULL, "parallel_mapping_ls", "Use the parallel swap local search for the mapping. Evaluates the swaps of all PEs in parallel and applies independent improving swaps. (Default: disabled)");
 
         // Node Ordering
         struct arg_int *dissection_rec_limit                 = arg_int0(NULL, "dissection_rec_limit", NULL, "Size of the smallest graph to dissect");
+        struct arg_lit *dissection_auto_rec_limit            = arg_lit0(NULL, "dissection_auto_rec_limit", "Try multiples of dissection_rec_limit and keep the ordering with the least factorization flops. (Default: disabled)");
         struct arg_lit *disable_reductions                   = arg_lit0(NULL, "disable_reductions", "Turn graph reductions off");
         struct arg_str *reduction_order                      = arg_str0(NULL, "reduction_order", NULL, "Order in which to apply reductions. Reduction numbers 0-5. Specify as string, for example \"0 4\". Available reductions: 0 simplical node reduction, 1 indistinguishable_nodes, 2 twins, 3 path_compression, 4 degree_2_nodes, 5 triangle_contraction.");
         struct arg_dbl *convergence_factor                   = arg_dbl0(NULL, "convergence_factor", NULL, "Reapply reductions only if the reduction in percent is greater than this factor (0: repeat until perfect convergence, 1: never repeat reductions (default))");
@@ -210,7 +223,7 @@ int parse_parameters(int argn, char **argv,
         struct arg_int *ilp_timeout                          = arg_int0(NULL, "ilp_timeout", NULL, "ILP timeout in seconds (Default: 7200)");
 
         void* argtable_fordeletion[] = {
-                help, use_mmap_io, edge_rating_tiebreaking, match_islands, only_first_level, graph_weighted, enable_corner_refinement, disable_qgraph_refinement, use_fullmultigrid, use_vcycle, compute_vertex_separator, first_level_random_matching, rate_first_level_inner_outer, use_bucket_queues, use_wcycles, disable_refined_bubbling, enable_convergence, enable_omp, wcycle_no_new_initial_partitioning, filename, filename_output, user_seed, version, k, edge_rating, refinement_type, matching_type, mh_pool_size, mh_plain_repetitions, mh_penalty_for_unconnected, mh_disable_nc_combine, mh_disable_cross_combine, mh_disable_combine, mh_enable_quickstart, mh_disable_diversify_islands, mh_disable_diversify, mh_diversify_best, mh_enable_tournament_selection, mh_cross_combine_original_k, mh_optimize_communication_volume, disable_balance_singletons, gpa_grow_internal, initial_partitioning_repetitions, minipreps, aggressive_random_levels, imbalance, initial_partition, initial_partition_optimize, bipartition_algorithm, permutation_quality, permutation_during_refinement, fm_search_limit, bipartition_post_fm_limit, bipartition_post_ml_limit, bipartition_tries, refinement_scheduling_algorithm, bank_account_factor, flow_region_factor, kway_adaptive_limits_alpha, stop_rule, num_vert_stop_factor, kway_search_stop_rule, bubbling_iterations, kway_rounds, kway_fm_limits, global_cycle_iterations, level_split, toposort_iterations, most_balanced_flows, input_partition, recursive_bipartitioning, suppress_output, disable_max_vertex_weight_constraint, local_multitry_fm_alpha, local_multitry_rounds, initial_partition_optimize_fm_limits, initial_partition_optimize_multitry_fm_alpha, initial_partition_optimize_multitry_rounds, preconfiguration, time_limit, unsuccessful_reps, local_partitioning_repetitions, amg_iterations, mh_flip_coin, mh_initial_population_fraction, mh_print_log, mh_sequential_mode, kaba_neg_cycle_algorithm, kabaE_internal_bal, kaba_internal_no_aug_steps_aug, kaba_packing_iterations, kaba_unsucc_iterations, kaba_flip_packings, kaba_lsearch_p, kaffpa_perfectly_balanced_refinement, kaba_disable_zero_weight_cycles, enforce_balance, mh_enable_tabu_search, mh_enable_kabapE, maxT, maxIter, balance_edges, cluster_upperbound, label_propagation_iterations, max_initial_ns_tries, max_flow_improv_steps, most_balanced_flows_node_sep, region_factor_node_separators, sep_flows_disabled, sep_fm_disabled, sep_loc_fm_disabled, sep_greedy_disabled, sep_full_boundary_ip, sep_faster_ns, sep_fm_unsucc_steps, sep_num_fm_reps, sep_loc_fm_unsucc_steps, sep_num_loc_fm_reps, sep_loc_fm_no_snodes, sep_num_vert_stop, sep_edge_rating_during_ip, enable_mapping, hierarchy_parameter_string, distance_parameter_string, online_distances, dissection_rec_limit, disable_reductions, reduction_order, convergence_factor, max_simplicial_degree, ilp_mode, ilp_min_gain, ilp_bfs_depth, ilp_overlap_presets, ilp_limit_nonzeroes, ilp_overlap_runs, ilp_timeout,
+                help, use_mmap_io, relabeling_type, hierarchy_memory_budget, hierarchy_spill_dir, compress_finest_level, gpa_parallel_sort, edge_rating_tiebreaking, match_islands, only_first_level, graph_weighted, enable_corner_refinement, disable_qgraph_refinement, use_fullmultigrid, use_vcycle, compute_vertex_separator, first_level_random_matching, rate_first_level_inner_outer, use_bucket_queues, use_wcycles, disable_refined_bubbling, enable_convergence, enable_omp, wcycle_no_new_initial_partitioning, filename, filename_output, user_seed, version, k, edge_rating, refinement_type, matching_type, mh_pool_size, mh_plain_repetitions, mh_penalty_for_unconnected, mh_disable_nc_combine, mh_disable_cross_combine, mh_disable_combine, mh_enable_quickstart, mh_disable_diversify_islands, mh_disable_diversify, mh_diversify_best, mh_enable_tournament_selection, mh_cross_combine_original_k, mh_optimize_communication_volume, mh_checkpoint_dir, mh_checkpoint_interval, mh_resume, disable_balance_singletons, gpa_grow_internal, initial_partitioning_repetitions, minipreps, aggressive_random_levels, imbalance, initial_partition, initial_partition_optimize, bipartition_algorithm, permutation_quality, permutation_during_refinement, fm_search_limit, bipartition_post_fm_limit, bipartition_post_ml_limit, bipartition_tries, refinement_scheduling_algorithm, bank_account_factor, flow_region_factor, kway_adaptive_limits_alpha, stop_rule, num_vert_stop_factor, kway_search_stop_rule, bubbling_iterations, kway_rounds, kway_fm_limits, global_cycle_iterations, level_split, toposort_iterations, most_balanced_flows, input_partition, recursive_bipartitioning, suppress_output, disable_max_vertex_weight_constraint, local_multitry_fm_alpha, local_multitry_rounds, initial_partition_optimize_fm_limits, initial_partition_optimize_multitry_fm_alpha, initial_partition_optimize_multitry_rounds, preconfiguration, time_limit, unsuccessful_reps, local_partitioning_repetitions, amg_iterations, mh_flip_coin, mh_initial_population_fraction, mh_print_log, mh_sequential_mode, kaba_neg_cycle_algorithm, kabaE_internal_bal, kaba_internal_no_aug_steps_aug, kaba_packing_iterations, kaba_unsucc_iterations, kaba_flip_packings, kaba_lsearch_p, kaffpa_perfectly_balanced_refinement, kaba_disable_zero_weight_cycles, enforce_balance, mh_enable_tabu_search, mh_enable_kabapE, maxT, maxIter, balance_edges, cluster_upperbound, label_propagation_iterations, max_initial_ns_tries, max_flow_improv_steps, most_balanced_flows_node_sep, region_factor_node_separators, sep_flows_disabled, sep_fm_disabled, sep_loc_fm_disabled, sep_greedy_disabled, sep_full_boundary_ip, sep_faster_ns, sep_fm_unsucc_steps, sep_num_fm_reps, sep_loc_fm_unsucc_steps, sep_num_loc_fm_reps, sep_loc_fm_no_snodes, sep_num_vert_stop, sep_edge_rating_during_ip, enable_mapping, hierarchy_parameter_string, distance_parameter_string, online_distances, topology_graph, topology_cache_size, parallel_mapping_ls, parallel_multisection, dissection_rec_limit, dissection_auto_rec_limit, disable_reductions, reduction_order, convergence_factor, max_simplicial_degree, ilp_mode, ilp_min_gain, ilp_bfs_depth, ilp_overlap_presets, ilp_limit_nonzeroes, ilp_overlap_runs, ilp_timeout,
                 end
         };
 
@@ -246,11 +259,17 @@ int parse_parameters(int argn, char **argv,
                 maxT, maxIter, minipreps, mh_penalty_for_unconnected, mh_enable_kabapE,
 #elif defined MODE_KAFFPA
                 use_mmap_io, 
+                relabeling_type,
+                hierarchy_memory_budget,
+                hierarchy_spill_dir,
+                compress_finest_level,
+                gpa_parallel_sort,
                 #ifndef MODE_GLOBALMS
                 k, 
                 #endif
                 imbalance,  
                 preconfiguration, 
+                matching_type,
                 time_limit, 
                 enforce_balance, 
                 #ifndef MODE_GLOBALMS
@@ -260,6 +279,12 @@ int parse_parameters(int argn, char **argv,
                 hierarchy_parameter_string, 
                 distance_parameter_string,
                 online_distances,
+                topology_graph,
+                topology_cache_size,
+                parallel_mapping_ls,
+                #ifdef MODE_GLOBALMS
+                parallel_multisection,
+                #endif
                 filename_output, 
 #elif defined MODE_EVALUATOR
                 k,   
@@ -300,6 +325,7 @@ int parse_parameters(int argn, char **argv,
 
         #if defined MODE_NODEORDERING
                 //dissection_rec_limit,
+                dissection_auto_rec_limit,
                 //disable_reductions,
                 //filename_output, 
                 #ifndef FASTORDERING
@@ -324,6 +350,7 @@ int parse_parameters(int argn, char **argv,
                 mh_enable_quickstart, 
 		mh_print_log, mh_optimize_communication_volume, 
                 mh_enable_tabu_search,
+                mh_checkpoint_dir, mh_checkpoint_interval, mh_resume,
                 maxT, maxIter,  
                 mh_enable_kabapE,
                 kabaE_internal_bal,  
@@ -440,15 +467,48 @@ int parse_parameters(int argn, char **argv,
                 partition_config.use_mmap_io = true;
         }
 
+        if (relabeling_type->count > 0) {
+                if(strcmp("none", relabeling_type->sval[0]) == 0) {
+                        partition_config.relabeling_type = RELABELING_NONE;
+                } else if (strcmp("bfs", relabeling_type->sval[0]) == 0) {
+                        partition_config.relabeling_type = RELABELING_BFS;
+                } else if (strcmp("rcm", relabeling_type->sval[0]) == 0) {
+                        partition_config.relabeling_type = RELABELING_RCM;
+                } else if (strcmp("degree", relabeling_type->sval[0]) == 0) {
+                        partition_config.relabeling_type = RELABELING_DEGREE;
+                } else {
+                        fprintf(stderr, "Invalid relabeling variant: \"%s\"\n", relabeling_type->sval[0]);
+
+                        arg_freetable(argtable_fordeletion, sizeof(argtable_fordeletion) / sizeof(argtable_fordeletion[0]));
+                        exit(0);
+                }
+        }
+
+        if (hierarchy_memory_budget->count > 0) {
+                partition_config.hierarchy_memory_budget = hierarchy_memory_budget->dval[0];
+        }
+
+        if (hierarchy_spill_dir->count > 0) {
+                partition_config.hierarchy_spill_directory = hierarchy_spill_dir->sval[0];
+        }
+
+        if (compress_finest_level->count > 0) {
+                partition_config.compress_finest_level = true;
+        }
+
+        if (gpa_parallel_sort->count > 0) {
+                partition_config.gpa_parallel_sort = true;
+        }
+
         if(enable_mapping->count > 0) {
                 partition_config.enable_mapping = true;
-                if(!hierarchy_parameter_string->count) {
+                if(!hierarchy_parameter_string->count && !topology_graph->count) {
                         std::cout <<  "Please specify the hierarchy using the --hierarchy_parameter_string option."  << std::endl;
                         arg_freetable(argtable_fordeletion, sizeof(argtable_fordeletion) / sizeof(argtable_fordeletion[0]));
                         exit(0);
                 }
 
-                if(!distance_parameter_string->count) {
+                if(!distance_parameter_string->count && !topology_graph->count) {
                         std::cout <<  "Please specify the distances using the --distance_parameter_string option."  << std::endl;
                         arg_freetable(argtable_fordeletion, sizeof(argtable_fordeletion) / sizeof(argtable_fordeletion[0]));
                         exit(0);
@@ -495,6 +555,25 @@ int parse_parameters(int argn, char **argv,
                 partition_config.distance_construction_algorithm = DIST_CONST_HIERARCHY_ONLINE;
         }
 
+        if(topology_graph->count > 0) {
+                partition_config.topology_filename               = topology_graph->sval[0];
+                partition_config.distance_construction_algorithm = DIST_CONST_TOPOLOGY;
+                // the fast hierarchy constructions need group sizes
+                partition_config.construction_algorithm          = MAP_CONST_OLDGROWING_FASTER;
+        }
+
+        if(topology_cache_size->count > 0) {
+                partition_config.topology_cache_size = topology_cache_size->dval[0];
+        }
+
+        if(parallel_mapping_ls->count > 0) {
+                partition_config.parallel_mapping_local_search = true;
+        }
+
+        if(parallel_multisection->count > 0) {
+                partition_config.parallel_multisection = true;
+        }
+
         if(filename_output->count > 0) {
                 partition_config.filename_output = filename_output->sval[0];
         }
@@ -713,6 +792,18 @@ int parse_parameters(int argn, char **argv,
                 partition_config.mh_pool_size = mh_pool_size->ival[0];
         }
 
+        if(mh_checkpoint_dir->count > 0) {
+                partition_config.mh_checkpoint_dir = mh_checkpoint_dir->sval[0];
+        }
+
+        if(mh_checkpoint_interval->count > 0) {
+                partition_config.mh_checkpoint_interval = mh_checkpoint_interval->dval[0];
+        }
+
+        if(mh_resume->count > 0) {
+                partition_config.mh_resume = true;
+        }
+
         if(mh_penalty_for_unconnected->count > 0) {
                 partition_config.mh_penalty_for_unconnected = true;
         }
@@ -1120,6 +1211,8 @@ int parse_parameters(int argn, char **argv,
                         partition_config.matching_type = MATCHING_GPA;
                 } else if (strcmp("randomgpa", matching_type->sval[0]) == 0) {
                         partition_config.matching_type = MATCHING_RANDOM_GPA;
+                } else if (strcmp("localmax", matching_type->sval[0]) == 0) {
+                        partition_config.matching_type = MATCHING_LOCAL_MAX;
                 } else {
                         fprintf(stderr, "Invalid matching variant: \"%s\"\n", matching_type->sval[0]);
 
@@ -1170,6 +1263,10 @@ int parse_parameters(int argn, char **argv,
                 partition_config.dissection_rec_limit = 120;
         }
 
+        if (dissection_auto_rec_limit->count > 0) {
+                partition_config.dissection_auto_rec_limit = true;
+        }
+
         if (disable_reductions->count > 0) {
                 partition_config.disable_reductions = true;
         } else {
@@ -48,6 +48,7 @@ for name in \
     label_propagation \
     node_ordering \
     node_separator \
+    ordering_evaluator \
     partition_to_vertex_separator \
 ;
 do
@@ -16,6 +16,7 @@
 #include "../lib/data_structure/graph_access.h"
 #include "../lib/io/graph_io.h"
 #include "../lib/node_ordering/nested_dissection.h"
+#include "../lib/tools/graph_relabeling.h"
 #include "../lib/tools/timer.h"
 #include "../lib/tools/quality_metrics.h"
 #include "../lib/tools/macros_assertions.h"
@@ -29,7 +30,7 @@
 #include "../app/configuration.h"
 #include "../app/balance_configuration.h"
 #include "../lib/data_structure/matrix/normal_matrix.h"
-#include "../lib/data_structure/matrix/online_distance_matrix.h"
+#include "../lib/data_structure/matrix/hierarchical_distance_matrix.h"
 #include "../lib/mapping/mapping_algorithms.h"
 #include "../lib/spac/spac.h"
 
@@ -117,6 +118,13 @@ void internal_kaffpa_call(PartitionConfig & partition_config,
         graph_access G;     
         internal_build_graph( partition_config, n, vwgt, xadj, adjcwgt, adjncy, G);
 
+        graph_relabeling relabeling;
+        std::vector<NodeID> new_id;
+        if( partition_config.relabeling_type != RELABELING_NONE ) {
+                relabeling.compute_ordering(partition_config, G, new_id);
+                relabeling.relabel(G, new_id);
+        }
+
         graph_partitioner partitioner;
         partitioner.perform_partitioning(partition_config, G);
 
@@ -131,6 +139,10 @@ void internal_kaffpa_call(PartitionConfig & partition_config,
                 cr.perform_refinement(partition_config, G, boundary);
         }
 
+        if( partition_config.relabeling_type != RELABELING_NONE ) {
+                relabeling.restore(G, new_id);
+        }
+
 
         forall_nodes(G, node) {
                 part[node] = G.getPartitionIndex(node);
@@ -188,6 +200,44 @@ void kaffpa_balance(int* n,
         internal_kaffpa_call(partition_config, suppress_output, n, vwgt, xadj, adjcwgt, adjncy, nparts, imbalance, perfectly_balance, edgecut, part);
 }
 
+void kaffpa_relabel(int* n, 
+                   int* vwgt, 
+                   int* xadj, 
+                   int* adjcwgt, 
+                   int* adjncy, 
+                   int* nparts, 
+                   double* imbalance, 
+                   bool suppress_output, 
+                   int seed,
+                   int mode,
+                   int relabel_mode,
+                   int* edgecut, 
+                   int* part) {
+        configuration cfg;
+        PartitionConfig partition_config;
+        partition_config.k = *nparts;
+
+        internal_kaffpa_set_configuration(cfg, partition_config, mode);
+
+        switch( relabel_mode ) {
+                case RELABELMODE_BFS: 
+                        partition_config.relabeling_type = RELABELING_BFS;
+                        break;
+                case RELABELMODE_RCM: 
+                        partition_config.relabeling_type = RELABELING_RCM;
+                        break;
+                case RELABELMODE_DEGREE: 
+                        partition_config.relabeling_type = RELABELING_DEGREE;
+                        break;
+                default: 
+                        partition_config.relabeling_type = RELABELING_NONE;
+                        break;
+        }
+
+        partition_config.seed = seed;
+        internal_kaffpa_call(partition_config, suppress_output, n, vwgt, xadj, adjcwgt, adjncy, nparts, imbalance, false, edgecut, part);
+}
+
 void kaffpa_balance_NE(int* n, 
                    int* vwgt, 
                    int* xadj, 
@@ -373,6 +423,7 @@ void reduced_nd(int* n,
         PartitionConfig partition_config;
         partition_config.k = 2;
         partition_config.dissection_rec_limit = 120;
+        partition_config.dissection_auto_rec_limit = false;
         partition_config.max_simplicial_degree = 12;
         partition_config.disable_reductions = false;
         partition_config.convergence_factor = 1;
@@ -443,6 +494,7 @@ void reduced_nd_fast(int* n,
         PartitionConfig partition_config;
         partition_config.k = 2;
         partition_config.dissection_rec_limit = 120;
+        partition_config.dissection_auto_rec_limit = false;
         partition_config.max_simplicial_degree = 12;
         partition_config.disable_reductions = false;
         partition_config.convergence_factor = 1;
@@ -574,12 +626,13 @@ void internal_processmapping_call(PartitionConfig & partition_config,
 
         if(!power_of_two ) {
                 mapping_algorithms ma;
-                if( partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
+                if( partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY
+                    && partition_config.distance_construction_algorithm != DIST_CONST_HIERARCHY_ONLINE) {
                         normal_matrix D(partition_config.k, partition_config.k);
                         ma.construct_a_mapping(partition_config, C, D, perm_rank);
                         internal_qap = qm.total_qap(C, D, perm_rank );
                 } else {
-                        online_distance_matrix D(partition_config.k, partition_config.k);
+                        hierarchical_distance_matrix D(partition_config.k, partition_config.k);
                         D.setPartitionConfig(partition_config);
                         ma.construct_a_mapping(partition_config, C, D, perm_rank);
                         internal_qap = qm.total_qap(C, D, perm_rank );
@@ -589,7 +642,7 @@ void internal_processmapping_call(PartitionConfig & partition_config,
                         perm_rank[i] = i;
                 }
 
-                online_distance_matrix D(partition_config.k, partition_config.k);
+                hierarchical_distance_matrix D(partition_config.k, partition_config.k);
                 D.setPartitionConfig(partition_config);
                 internal_qap = qm.total_qap(C, D, perm_rank );
         }
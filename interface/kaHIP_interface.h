@@ -24,6 +24,11 @@ const int STRONGSOCIAL   = 5;
 const int MAPMODE_MULTISECTION = 0;
 const int MAPMODE_BISECTION = 1;
 
+const int RELABELMODE_NONE   = 0;
+const int RELABELMODE_BFS    = 1;
+const int RELABELMODE_RCM    = 2;
+const int RELABELMODE_DEGREE = 3;
+
 // same data structures as in metis 
 // edgecut and part are output parameters
 // part has to be an array of n ints
@@ -40,6 +45,14 @@ void kaffpa_balance(int* n, int* vwgt, int* xadj,
                    bool suppress_output, int seed, int mode, 
                    int* edgecut, int* part);
 
+// same as kaffpa, the graph is relabeled for locality before partitioning (one of the RELABELMODE_ constants)
+// part is returned in the original node order
+void kaffpa_relabel(int* n, int* vwgt, int* xadj, 
+                   int* adjcwgt, int* adjncy, int* nparts, 
+                   double* imbalance, bool suppress_output, int seed, int mode, 
+                   int relabel_mode,
+                   int* edgecut, int* part);
+
 // balance constraint on nodes and edges
 void kaffpa_balance_NE(int* n, int* vwgt, int* xadj, 
                 int* adjcwgt, int* adjncy, int* nparts, 
@@ -0,0 +1,131 @@
+/******************************************************************************
+ * compressed_graph.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include "compressed_graph.h"
+
+// differences between neighbors can be negative since the order of the edges is kept
+inline uint64_t zigzag(NodeID target, NodeID previous) {
+        int64_t difference = (int64_t)target - (int64_t)previous;
+        return ((uint64_t)difference << 1) ^ (uint64_t)(difference >> 63);
+}
+
+inline NodeID unzigzag(uint64_t value, NodeID previous) {
+        int64_t difference = (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+        return (NodeID)((int64_t)previous + difference);
+}
+
+inline size_t encoded_length(uint64_t value) {
+        size_t length = 1;
+        while( value >= 0x80 ) {
+                value >>= 7;
+                length++;
+        }
+        return length;
+}
+
+compressed_graph::compressed_graph() : m_number_of_nodes(0), m_number_of_edges(0) {
+
+}
+
+compressed_graph::~compressed_graph() {
+
+}
+
+size_t compressed_graph::size_in_bytes() {
+        return m_adjacency.capacity() + m_node_weights.capacity() * sizeof(NodeWeight);
+}
+
+void compressed_graph::compress(graph_access & G) {
+        m_number_of_nodes      = G.number_of_nodes();
+        m_number_of_edges      = G.number_of_edges();
+        m_uniform_node_weights = true;
+        m_uniform_edge_weights = true;
+        m_node_weight          = m_number_of_nodes > 0 ? G.getNodeWeight(0) : 1;
+        m_edge_weight          = m_number_of_edges > 0 ? G.getEdgeWeight(0) : 1;
+
+        forall_nodes(G, node) {
+                if( G.getNodeWeight(node) != m_node_weight ) m_uniform_node_weights = false;
+        } endfor
+        forall_edges(G, e) {
+                if( G.getEdgeWeight(e) != m_edge_weight ) m_uniform_edge_weights = false;
+        } endfor
+
+        // the size is computed first, so that the encoding does not need more memory than necessary
+        size_t size = 0;
+        forall_nodes(G, node) {
+                size += encoded_length(G.getNodeDegree(node));
+                NodeID previous = node;
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        size += encoded_length(zigzag(target, previous));
+                        if( !m_uniform_edge_weights ) size += encoded_length((uint32_t)G.getEdgeWeight(e));
+                        previous = target;
+                } endfor
+        } endfor
+
+        m_adjacency.clear();
+        m_adjacency.reserve(size);
+        forall_nodes(G, node) {
+                encode(G.getNodeDegree(node));
+                NodeID previous = node;
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        encode(zigzag(target, previous));
+                        if( !m_uniform_edge_weights ) encode((uint32_t)G.getEdgeWeight(e));
+                        previous = target;
+                } endfor
+        } endfor
+
+        m_node_weights.clear();
+        if( !m_uniform_node_weights ) {
+                m_node_weights.resize(m_number_of_nodes);
+                forall_nodes(G, node) {
+                        m_node_weights[node] = G.getNodeWeight(node);
+                } endfor
+        }
+
+        m_partition_count    = G.m_partition_count;
+        m_separator_block_ID = G.m_separator_block_ID;
+        m_refinement_node_props.swap(G.graphref->m_refinement_node_props);
+        m_contraction_offset.swap(G.graphref->m_contraction_offset);
+        m_second_partition_index.swap(G.m_second_partition_index);
+
+        G.release();
+}
+
+void compressed_graph::decompress(graph_access & G) {
+        G.start_construction(m_number_of_nodes, m_number_of_edges);
+
+        size_t pos = 0;
+        for( NodeID i = 0; i < m_number_of_nodes; i++) {
+                NodeID node = G.new_node();
+                G.setNodeWeight(node, m_uniform_node_weights ? m_node_weight : m_node_weights[node]);
+
+                EdgeID degree   = decode(pos);
+                NodeID previous = node;
+                for( EdgeID j = 0; j < degree; j++) {
+                        NodeID target = unzigzag(decode(pos), previous);
+                        EdgeID e = G.new_edge(node, target);
+                        G.setEdgeWeight(e, m_uniform_edge_weights ? m_edge_weight : (EdgeWeight)(uint32_t)decode(pos));
+                        previous = target;
+                }
+        }
+
+        G.finish_construction();
+
+        G.set_partition_count(m_partition_count);
+        G.setSeparatorBlock(m_separator_block_ID);
+        G.graphref->m_refinement_node_props.swap(m_refinement_node_props);
+        G.graphref->m_contraction_offset.swap(m_contraction_offset);
+        G.m_second_partition_index.swap(m_second_partition_index);
+
+        std::vector<uint8_t>().swap(m_adjacency);
+        std::vector<NodeWeight>().swap(m_node_weights);
+        std::vector<refinementNode>().swap(m_refinement_node_props);
+        std::vector<NodeWeight>().swap(m_contraction_offset);
+        std::vector<PartitionID>().swap(m_second_partition_index);
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * compressed_graph.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef COMPRESSED_GRAPH_4TQ8XN2B
+#define COMPRESSED_GRAPH_4TQ8XN2B
+
+#include <stdint.h>
+#include <vector>
+
+#include "graph_access.h"
+
+// compact representation of a graph that is not accessed for a while.
+// every neighbor is stored as the varint encoded difference to the previous
+// neighbor (to the node itself for the first one), so graphs with id locality
+// need one or two bytes per edge. edge and node weights are elided if they are
+// uniform. the order of the edges is kept, i.e. decompress() rebuilds the graph
+// with the same edge ids.
+class compressed_graph {
+public:
+        compressed_graph();
+        virtual ~compressed_graph();
+
+        // encodes G and releases its arrays, G must not be accessed until decompress(G)
+        void compress(graph_access & G);
+
+        // rebuilds G from the encoding and frees the encoding
+        void decompress(graph_access & G);
+
+        NodeID number_of_nodes() { return m_number_of_nodes; };
+        EdgeID number_of_edges() { return m_number_of_edges; };
+
+        // memory used by the encoded adjacency and the node weights
+        size_t size_in_bytes();
+
+private:
+        inline void encode(uint64_t value);
+        inline uint64_t decode(size_t & pos);
+
+        NodeID      m_number_of_nodes;
+        EdgeID      m_number_of_edges;
+        bool        m_uniform_node_weights;
+        bool        m_uniform_edge_weights;
+        NodeWeight  m_node_weight;
+        EdgeWeight  m_edge_weight;
+
+        std::vector<uint8_t>    m_adjacency;
+        std::vector<NodeWeight> m_node_weights;
+
+        // the node properties are kept as they are
+        std::vector<refinementNode> m_refinement_node_props;
+        std::vector<NodeWeight>     m_contraction_offset;
+        std::vector<PartitionID>    m_second_partition_index;
+        unsigned int                m_partition_count;
+        PartitionID                 m_separator_block_ID;
+};
+
+inline void compressed_graph::encode(uint64_t value) {
+        while( value >= 0x80 ) {
+                m_adjacency.push_back((uint8_t)(value | 0x80));
+                value >>= 7;
+        }
+        m_adjacency.push_back((uint8_t)value);
+}
+
+inline uint64_t compressed_graph::decode(size_t & pos) {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        while( m_adjacency[pos] & 0x80 ) {
+                value |= (uint64_t)(m_adjacency[pos++] & 0x7F) << shift;
+                shift += 7;
+        }
+        value |= (uint64_t)m_adjacency[pos++] << shift;
+        return value;
+}
+
+
+#endif /* end of include guard: COMPRESSED_GRAPH_4TQ8XN2B */
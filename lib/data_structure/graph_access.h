@@ -8,6 +8,7 @@
 #ifndef GRAPH_ACCESS_EFRXO4X2
 #define GRAPH_ACCESS_EFRXO4X2
 
+#include <algorithm>
 #include <bitset>
 #include <cassert>
 #include <iostream>
@@ -39,6 +40,8 @@ class graph_access;
 //construction etc. is encapsulated in basicGraph / access to properties etc. is encapsulated in graph_access
 class basicGraph {
     friend class graph_access;
+    friend class graph_spill;
+    friend class compressed_graph;
 
 public:
     basicGraph() : m_building_graph(false) {
@@ -161,8 +164,10 @@ class complete_boundary;
 
 class graph_access {
         friend class complete_boundary;
+        friend class graph_spill;
+        friend class compressed_graph;
         public:
-                graph_access() { m_max_degree_computed = false; m_max_degree = 0; graphref = new basicGraph(); m_separator_block_ID = 2;}
+                graph_access() { m_max_degree_computed = false; m_max_degree = 0; graphref = new basicGraph(); m_separator_block_ID = 2; m_partition_count = 1;}
                 virtual ~graph_access(){ delete graphref; };
 
                 graph_access(const graph_access&) = delete;
@@ -231,6 +236,15 @@ class graph_access {
                 //Count get_node_queue_index(NodeID node);
 
                 void copy(graph_access & Gcopy);
+
+                // exchanges the contents of both graphs in constant time
+                void swap(graph_access & G_bar);
+
+                // makes the graph empty but keeps the allocated memory for the next construction
+                void clear();
+
+                // makes the graph empty and returns its memory
+                void release();
         private:
                 basicGraph * graphref;     
                 bool         m_max_degree_computed;
@@ -535,4 +549,38 @@ inline void graph_access::copy(graph_access & G_bar) {
         G_bar.finish_construction();
 }
 
+inline void graph_access::swap(graph_access & G_bar) {
+        std::swap(graphref, G_bar.graphref);
+        std::swap(m_max_degree_computed, G_bar.m_max_degree_computed);
+        std::swap(m_partition_count, G_bar.m_partition_count);
+        std::swap(m_max_degree, G_bar.m_max_degree);
+        std::swap(m_separator_block_ID, G_bar.m_separator_block_ID);
+        m_second_partition_index.swap(G_bar.m_second_partition_index);
+}
+
+inline void graph_access::clear() {
+        graphref->m_nodes.clear();
+        graphref->m_edges.clear();
+        graphref->m_refinement_node_props.clear();
+        graphref->m_coarsening_edge_props.clear();
+        graphref->m_contraction_offset.clear();
+        graphref->m_building_graph = false;
+
+        m_max_degree_computed = false;
+        m_max_degree          = 0;
+        m_separator_block_ID  = 2;
+        m_partition_count     = 1;
+        m_second_partition_index.clear();
+}
+
+inline void graph_access::release() {
+        clear();
+        std::vector<Node>().swap(graphref->m_nodes);
+        std::vector<Edge>().swap(graphref->m_edges);
+        std::vector<refinementNode>().swap(graphref->m_refinement_node_props);
+        std::vector<coarseningEdge>().swap(graphref->m_coarsening_edge_props);
+        std::vector<NodeWeight>().swap(graphref->m_contraction_offset);
+        std::vector<PartitionID>().swap(m_second_partition_index);
+}
+
 #endif /* end of include guard: GRAPH_ACCESS_EFRXO4X2 */
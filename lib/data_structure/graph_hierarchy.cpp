@@ -7,15 +7,32 @@
 
 #include "graph_hierarchy.h"
 
-graph_hierarchy::graph_hierarchy() : m_current_coarser_graph(NULL), 
-                                     m_current_coarse_mapping(NULL){
+graph_hierarchy::graph_hierarchy( hierarchy_pool * pool ) : m_current_coarser_graph(NULL), 
+                                                             m_current_coarse_mapping(NULL),
+                                                             m_pool(pool),
+                                                             m_memory_budget(0),
+                                                             m_resident_bytes(0),
+                                                             m_compress_finest_level(false),
+                                                             m_compressed_level(NULL) {
 
 }
 
 graph_hierarchy::~graph_hierarchy() {
-        for( unsigned i = 0; i < m_to_delete_mappings.size(); i++) {
-                if(m_to_delete_mappings[i] != NULL)
+        // levels that are still on disk are restored
+        for( auto & level : m_spilled_levels) {
+                delete level.second;
+        }
+        decompress_if_compressed(m_compressed_level);
+
+        // in reverse order, so that the pool hands out the mapping of the finest level first
+        for( unsigned i = m_to_delete_mappings.size(); i-- > 0; ) {
+                if(m_to_delete_mappings[i] == NULL) continue;
+
+                if(m_pool != NULL) {
+                        m_pool->release_mapping(m_to_delete_mappings[i]);
+                } else {
                         delete m_to_delete_mappings[i];
+                }
         }
 
         for( unsigned i = 0; i+1 < m_to_delete_hierachies.size(); i++) {
@@ -29,6 +46,73 @@ void graph_hierarchy::push_back(graph_access * G, CoarseMapping * coarse_mapping
         m_the_mappings.push(coarse_mapping);
 	m_to_delete_mappings.push_back(coarse_mapping);
         m_coarsest_graph = G;
+
+        if( m_compress_finest_level && coarse_mapping != NULL && m_the_graph_hierarchy.size() == 1 ) {
+                m_compressed_finest_level.compress(*G);
+                m_compressed_level = G;
+                return;
+        }
+
+        // a level with a mapping has been contracted and is not needed before uncoarsening
+        if( m_memory_budget == 0 || coarse_mapping == NULL ) return;
+
+        m_resident_bytes += graph_spill::resident_bytes(*G);
+        m_spill_candidates.push_back(G);
+        while( m_resident_bytes > m_memory_budget && !m_spill_candidates.empty() ) {
+                graph_access* level = m_spill_candidates.front();
+                m_spill_candidates.pop_front();
+                m_resident_bytes -= graph_spill::resident_bytes(*level);
+
+                graph_spill* spill = new graph_spill();
+                if( spill->spill(level, m_spill_directory) ) {
+                        m_spilled_levels[level] = spill;
+                } else {
+                        delete spill;
+                }
+        }
+}
+
+void graph_hierarchy::set_memory_budget(size_t budget, const std::string & spill_directory) {
+        m_memory_budget   = budget;
+        m_spill_directory = spill_directory;
+}
+
+void graph_hierarchy::set_compress_finest_level(bool compress) {
+        m_compress_finest_level = compress;
+}
+
+void graph_hierarchy::decompress_if_compressed(graph_access * G) {
+        if( G == NULL || G != m_compressed_level ) return;
+
+        m_compressed_finest_level.decompress(*G);
+        m_compressed_level = NULL;
+}
+
+void graph_hierarchy::load_if_spilled(graph_access * G) {
+        auto level = m_spilled_levels.find(G);
+        if( level == m_spilled_levels.end() ) return;
+
+        level->second->load();
+        delete level->second;
+        m_spilled_levels.erase(level);
+}
+
+graph_access * graph_hierarchy::new_graph() {
+        if(m_pool != NULL) return m_pool->new_graph();
+        return new graph_access();
+}
+
+CoarseMapping * graph_hierarchy::new_mapping() {
+        if(m_pool != NULL) return m_pool->new_mapping();
+        return new CoarseMapping();
+}
+
+void graph_hierarchy::release_graph(graph_access * G) {
+        if(m_pool != NULL) {
+                m_pool->release_graph(G);
+        } else {
+                delete G;
+        }
 }
 
 graph_access* graph_hierarchy::pop_finer_and_project() {
@@ -45,6 +129,8 @@ graph_access* graph_hierarchy::pop_finer_and_project() {
                 coarse_mapping = m_the_mappings.top(); 
                 m_the_mappings.pop();
         }
+        load_if_spilled(finer);
+        decompress_if_compressed(finer);
         
         ASSERT_EQ(m_the_graph_hierarchy.size(), m_the_mappings.size());
 
@@ -78,6 +164,8 @@ graph_access* graph_hierarchy::pop_finer_and_project_ns( PartialBoundary & separ
                 coarse_mapping = m_the_mappings.top(); 
                 m_the_mappings.pop();
         }
+        load_if_spilled(finer);
+        decompress_if_compressed(finer);
         
         ASSERT_EQ(m_the_graph_hierarchy.size(), m_the_mappings.size());
 
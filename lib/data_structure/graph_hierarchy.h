@@ -8,17 +8,38 @@
 #ifndef GRAPH_HIERACHY_UMHG74CO
 #define GRAPH_HIERACHY_UMHG74CO
 
+#include <deque>
 #include <stack>
+#include <string>
+#include <unordered_map>
 
+#include "compressed_graph.h"
 #include "graph_access.h"
+#include "graph_spill.h"
+#include "hierarchy_pool.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/partial_boundary.h"
 
 class graph_hierarchy {
 public:
-        graph_hierarchy( );
+        // if a pool is given the levels are taken from and released to the pool
+        graph_hierarchy( hierarchy_pool * pool = NULL );
         virtual ~graph_hierarchy();
 
         void push_back(graph_access * G, CoarseMapping * coarse_mapping);
+
+        // storage for the levels that are pushed back
+        graph_access  * new_graph();
+        CoarseMapping * new_mapping();
+
+        // to be called for a level that is not needed anymore
+        void release_graph(graph_access * G);
+
+        // if the finer levels take more than budget bytes, the finest ones are moved to files 
+        // in spill_directory until they are needed again during uncoarsening
+        void set_memory_budget(size_t budget, const std::string & spill_directory);
+
+        // the finest level is kept compressed in memory while the coarser levels are processed
+        void set_compress_finest_level(bool compress);
         
         graph_access  * pop_finer_and_project();
         graph_access  * pop_finer_and_project_ns( PartialBoundary & separator );
@@ -30,6 +51,8 @@ public:
 private:
         //private functions
         graph_access * pop_coarsest();
+        void load_if_spilled(graph_access * G);
+        void decompress_if_compressed(graph_access * G);
 
         std::stack<graph_access*>   m_the_graph_hierarchy;
         std::stack<CoarseMapping*>  m_the_mappings;
@@ -38,6 +61,17 @@ private:
         graph_access  * m_current_coarser_graph;
         graph_access  * m_coarsest_graph;
         CoarseMapping * m_current_coarse_mapping;
+        hierarchy_pool* m_pool;
+
+        size_t                      m_memory_budget;
+        size_t                      m_resident_bytes;
+        std::string                 m_spill_directory;
+        std::deque<graph_access*>   m_spill_candidates;
+        std::unordered_map<graph_access*, graph_spill*> m_spilled_levels;
+
+        bool                        m_compress_finest_level;
+        graph_access              * m_compressed_level;
+        compressed_graph            m_compressed_finest_level;
 };
 
 
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * graph_spill.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <iostream>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "graph_spill.h"
+
+graph_spill::graph_spill() : m_graph(NULL), m_file(NULL), m_write_failed(false) {
+
+}
+
+graph_spill::~graph_spill() {
+        // a graph that was never loaded is restored, it may be owned by someone else
+        if( m_graph != NULL ) load();
+}
+
+size_t graph_spill::resident_bytes(graph_access & G) {
+        basicGraph & ref = *G.graphref;
+        return ref.m_nodes.capacity()                 * sizeof(Node)
+             + ref.m_edges.capacity()                 * sizeof(Edge)
+             + ref.m_refinement_node_props.capacity() * sizeof(refinementNode)
+             + ref.m_coarsening_edge_props.capacity() * sizeof(coarseningEdge)
+             + ref.m_contraction_offset.capacity()    * sizeof(NodeWeight)
+             + G.m_second_partition_index.capacity()  * sizeof(PartitionID);
+}
+
+bool graph_spill::spill(graph_access * G, const std::string & directory) {
+        std::string filename = directory + "/kahip_level_XXXXXX";
+        std::vector<char> name(filename.begin(), filename.end());
+        name.push_back('\0');
+
+        int fd = mkstemp(name.data());
+        if( fd == -1 ) {
+                std::cerr << "could not create a temporary file in " << directory << ", the level stays in memory" << std::endl;
+                return false;
+        }
+        // the file is removed when it is closed
+        unlink(name.data());
+
+        m_file = fdopen(fd, "w+b");
+        if( m_file == NULL ) {
+                close(fd);
+                return false;
+        }
+
+        m_graph              = G;
+        m_write_failed       = false;
+        m_partition_count    = G->m_partition_count;
+        m_separator_block_ID = G->m_separator_block_ID;
+
+        m_writer = std::thread(&graph_spill::write, this);
+        return true;
+}
+
+void graph_spill::write() {
+        basicGraph & ref = *m_graph->graphref;
+        bool ok = write_vector(ref.m_nodes)
+               && write_vector(ref.m_edges)
+               && write_vector(ref.m_refinement_node_props)
+               && write_vector(ref.m_contraction_offset)
+               && write_vector(m_graph->m_second_partition_index)
+               && fflush(m_file) == 0;
+
+        if( !ok ) {
+                std::cerr << "could not write a level to disk, it stays in memory" << std::endl;
+                m_write_failed = true;
+                return;
+        }
+
+        // release the memory, the edge ratings are not needed anymore
+        m_graph->release();
+}
+
+void graph_spill::load() {
+        if( m_graph == NULL ) return;
+        m_writer.join();
+
+        if( !m_write_failed ) {
+                rewind(m_file);
+
+                basicGraph & ref = *m_graph->graphref;
+                bool ok = read_vector(ref.m_nodes)
+                       && read_vector(ref.m_edges)
+                       && read_vector(ref.m_refinement_node_props)
+                       && read_vector(ref.m_contraction_offset)
+                       && read_vector(m_graph->m_second_partition_index);
+                if( !ok ) {
+                        std::cerr << "could not read a level from disk" << std::endl;
+                        exit(1);
+                }
+                ref.m_coarsening_edge_props.resize(ref.m_edges.size());
+
+                m_graph->m_partition_count    = m_partition_count;
+                m_graph->m_separator_block_ID = m_separator_block_ID;
+        }
+
+        fclose(m_file);
+        m_file  = NULL;
+        m_graph = NULL;
+}
+
+template< typename T >
+bool graph_spill::write_vector(const std::vector<T> & values) {
+        size_t size = values.size();
+        if( fwrite(&size, sizeof(size_t), 1, m_file) != 1 ) return false;
+        return fwrite(values.data(), sizeof(T), size, m_file) == size;
+}
+
+template< typename T >
+bool graph_spill::read_vector(std::vector<T> & values) {
+        size_t size = 0;
+        if( fread(&size, sizeof(size_t), 1, m_file) != 1 ) return false;
+        values.resize(size);
+        return fread(values.data(), sizeof(T), size, m_file) == size;
+}
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * graph_spill.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef GRAPH_SPILL_8MW2RK5D
+#define GRAPH_SPILL_8MW2RK5D
+
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "graph_access.h"
+
+// moves a graph to an anonymous temporary file and back. the file is written by a
+// background thread, the memory of the graph is released as soon as it is on disk.
+// the graph must not be accessed between spill() and load().
+class graph_spill {
+public:
+        graph_spill();
+        virtual ~graph_spill();
+
+        // returns false if no temporary file could be created in directory, G is not touched then
+        bool spill(graph_access * G, const std::string & directory);
+
+        // waits until the graph is written and reads it back into the same graph object
+        void load();
+
+        bool is_spilled() { return m_graph != NULL; };
+
+        // size of the arrays of G that are released by spill()
+        static size_t resident_bytes(graph_access & G);
+
+private:
+        void write();
+
+        template< typename T >
+        bool write_vector(const std::vector<T> & values);
+
+        template< typename T >
+        bool read_vector(std::vector<T> & values);
+
+        graph_access * m_graph;
+        FILE*          m_file;
+        std::thread    m_writer;
+        bool           m_write_failed;
+
+        unsigned int   m_partition_count;
+        PartitionID    m_separator_block_ID;
+};
+
+
+#endif /* end of include guard: GRAPH_SPILL_8MW2RK5D */
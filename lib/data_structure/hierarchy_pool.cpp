@@ -0,0 +1,66 @@
+/******************************************************************************
+ * hierarchy_pool.cpp 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include "hierarchy_pool.h"
+
+hierarchy_pool::hierarchy_pool() : m_recycle(true) {
+
+}
+
+hierarchy_pool::~hierarchy_pool() {
+        for( unsigned i = 0; i < m_free_graphs.size(); i++) {
+                delete m_free_graphs[i];
+        }
+
+        for( unsigned i = 0; i < m_free_mappings.size(); i++) {
+                delete m_free_mappings[i];
+        }
+}
+
+graph_access * hierarchy_pool::new_graph() {
+        if( m_free_graphs.empty() ) {
+                return new graph_access();
+        }
+
+        graph_access * G = m_free_graphs.back();
+        m_free_graphs.pop_back();
+        return G;
+}
+
+void hierarchy_pool::release_graph(graph_access * G) {
+        if( !m_recycle ) {
+                delete G;
+                return;
+        }
+
+        G->clear();
+        m_free_graphs.push_back(G);
+}
+
+CoarseMapping * hierarchy_pool::new_mapping() {
+        if( m_free_mappings.empty() ) {
+                return new CoarseMapping();
+        }
+
+        CoarseMapping * coarse_mapping = m_free_mappings.back();
+        m_free_mappings.pop_back();
+        return coarse_mapping;
+}
+
+void hierarchy_pool::release_mapping(CoarseMapping * coarse_mapping) {
+        if( !m_recycle ) {
+                delete coarse_mapping;
+                return;
+        }
+
+        coarse_mapping->clear();
+        m_free_mappings.push_back(coarse_mapping);
+}
+
+void hierarchy_pool::stop_recycling() {
+        m_recycle = false;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * hierarchy_pool.h 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef HIERARCHY_POOL_4TQ8JZ2C
+#define HIERARCHY_POOL_4TQ8JZ2C
+
+#include <vector>
+
+#include "definitions.h"
+#include "graph_access.h"
+
+// keeps the graphs and coarse mappings of released levels of a hierarchy alive, 
+// so that the levels of the next hierarchy are built in memory that is already allocated.
+// released objects are handed out again in reverse order, i.e. the finest released level comes first. 
+class hierarchy_pool {
+public:
+        hierarchy_pool();
+        virtual ~hierarchy_pool();
+
+        // an empty graph, a released one if available
+        graph_access  * new_graph();
+        void release_graph(graph_access * G);
+
+        // an empty mapping, a released one if available
+        CoarseMapping * new_mapping();
+        void release_mapping(CoarseMapping * coarse_mapping);
+
+        // objects that are released from now on are deleted, 
+        // to be called before the last hierarchy is built
+        void stop_recycling();
+
+private:
+        bool m_recycle;
+        std::vector<graph_access*>  m_free_graphs;
+        std::vector<CoarseMapping*> m_free_mappings;
+};
+
+
+#endif /* end of include guard: HIERARCHY_POOL_4TQ8JZ2C */
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * hierarchical_distance_matrix.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef HIERARCHICAL_DISTANCE_MATRIX_R7WQ2KXD
+#define HIERARCHICAL_DISTANCE_MATRIX_R7WQ2KXD
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <iostream>
+#include "matrix.h"
+#include "partition_config.h"
+
+// distances of a hierarchical machine (config.group_sizes / config.distances) without
+// storing a matrix. the id of every PE is written in the mixed radix system given by the
+// group sizes and the digits are packed into one key, the lowest level in the lowest bits.
+// the highest bit in which two keys differ is the first level at which the PEs are in
+// different groups, so a query is one xor and one count leading zeros.
+class hierarchical_distance_matrix final : public matrix {
+public:
+        hierarchical_distance_matrix(unsigned int dim_x, unsigned int dim_y) : m_dim_x (dim_x),
+                                                                               m_dim_y (dim_y) {
+        };
+
+        void setPartitionConfig( PartitionConfig & config ) {
+                // bit 0 is never set, so that equal keys are mapped to distances[0]
+                std::vector< unsigned > first_bit(config.group_sizes.size()+1, 1);
+                for( unsigned level = 0; level < config.group_sizes.size(); level++) {
+                        unsigned bits = 0;
+                        while( (1ULL << bits) < (unsigned long long)config.group_sizes[level] ) bits++;
+                        first_bit[level+1] = first_bit[level] + bits;
+                }
+                // k < 2^32 needs at most 41 bits
+                if( first_bit.back() > 64 ) {
+                        std::cout <<  "hierarchy is too deep for the distance oracle"  << std::endl;
+                        exit(0);
+                }
+
+                std::fill(m_distance_of_bit, m_distance_of_bit + 64, 0);
+                for( unsigned level = 0; level < config.group_sizes.size(); level++) {
+                        for( unsigned bit = first_bit[level]; bit < first_bit[level+1]; bit++) {
+                                m_distance_of_bit[bit] = config.distances[level];
+                        }
+                }
+                m_distance_of_bit[0] = config.distances[0];
+
+                unsigned int pes = std::max(m_dim_x, m_dim_y);
+                m_keys.resize(pes);
+                for( unsigned int pe = 0; pe < pes; pe++) {
+                        uint64_t key       = 0;
+                        unsigned int rest  = pe;
+                        for( unsigned level = 0; level < config.group_sizes.size(); level++) {
+                                key  |= (uint64_t)(rest % config.group_sizes[level]) << first_bit[level];
+                                rest /= config.group_sizes[level];
+                        }
+                        m_keys[pe] = key;
+                }
+        }
+
+        virtual ~hierarchical_distance_matrix() {};
+
+        inline int get_xy(unsigned int x, unsigned int y) {
+                return m_distance_of_bit[63 - __builtin_clzll((m_keys[x] ^ m_keys[y]) | 1)];
+        };
+
+        inline void set_xy(unsigned int x, unsigned int y, int value) {
+                // do nothing -- matrix cannot be modified
+        };
+
+        inline unsigned int get_x_dim() {return m_dim_x;};
+        inline unsigned int get_y_dim() {return m_dim_y;};
+
+        void print() {
+                for( unsigned int i = 0; i < get_x_dim(); i++) {
+                        for( unsigned int j = 0; j < get_y_dim(); j++) {
+                                std::cout <<  get_xy(i,j) << " ";
+                        }
+                        std::cout <<  ""  << std::endl;
+                }
+        }
+
+private:
+        unsigned int m_dim_x, m_dim_y;
+        std::vector< uint64_t > m_keys;
+        int m_distance_of_bit[64];
+};
+
+
+#endif /* end of include guard: HIERARCHICAL_DISTANCE_MATRIX_R7WQ2KXD */
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * topology_distance_matrix.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef TOPOLOGY_DISTANCE_MATRIX_6PX3WNQ8
+#define TOPOLOGY_DISTANCE_MATRIX_6PX3WNQ8
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <omp.h>
+#include <queue>
+#include <vector>
+#include "data_structure/graph_access.h"
+#include "matrix.h"
+
+// distances between the PEs of an arbitrary network given as a topology graph, i.e.
+// the length of a shortest path (hops if the graph is unweighted, otherwise the sum
+// of the edge weights). the rows of the matrix are computed on demand by a single
+// source search and kept in a cache of cache_rows rows, the oldest row is replaced.
+// every thread of a team with at most num_threads threads has its own share of the
+// cache, so that concurrent queries need no locking.
+class topology_distance_matrix final : public matrix {
+public:
+        topology_distance_matrix(graph_access & topology, unsigned int cache_rows, int num_threads = 1) : m_topology(topology) {
+                m_dim = topology.number_of_nodes();
+                num_threads = std::max(1, num_threads);
+                cache_rows  = std::max(1u, std::min(cache_rows / num_threads, m_dim));
+
+                m_unweighted = true;
+                forall_edges(topology, e) {
+                        if( topology.getEdgeWeight(e) != 1 ) m_unweighted = false;
+                } endfor
+
+                m_caches.resize(num_threads);
+                for( row_cache & cache : m_caches ) {
+                        cache.rows.resize(cache_rows);
+                        cache.pe_of_row.resize(cache_rows, m_dim);
+                        cache.row_of_pe.resize(m_dim, -1);
+                        cache.next_row = 0;
+                }
+        };
+
+        virtual ~topology_distance_matrix() {};
+
+        inline int get_xy(unsigned int x, unsigned int y) {
+                row_cache & cache = m_caches.size() == 1 ? m_caches[0] : m_caches[omp_get_thread_num()];
+                // the network is undirected, so a cached row of y answers the query as well
+                if( cache.row_of_pe[x] != -1 ) return cache.rows[cache.row_of_pe[x]][y];
+                if( cache.row_of_pe[y] != -1 ) return cache.rows[cache.row_of_pe[y]][x];
+                return cache.rows[compute_row(cache, x)][y];
+        };
+
+        inline void set_xy(unsigned int x, unsigned int y, int value) {
+                // do nothing -- matrix cannot be modified
+        };
+
+        inline unsigned int get_x_dim() {return m_dim;};
+        inline unsigned int get_y_dim() {return m_dim;};
+
+        // the network has to be connected
+        bool is_connected() {
+                std::vector< int > & row = m_caches[0].rows[compute_row(m_caches[0], 0)];
+                for( unsigned int pe = 0; pe < m_dim; pe++) {
+                        if( row[pe] == std::numeric_limits< int >::max() ) return false;
+                }
+                return true;
+        }
+
+private:
+        struct row_cache {
+                std::vector< std::vector< int > > rows;
+                std::vector< unsigned int > pe_of_row;
+                std::vector< int > row_of_pe;
+                unsigned int next_row;
+        };
+
+        int compute_row(row_cache & cache, unsigned int source) {
+                int row = cache.next_row;
+                cache.next_row = (cache.next_row + 1) % cache.rows.size();
+                if( cache.pe_of_row[row] != m_dim ) cache.row_of_pe[cache.pe_of_row[row]] = -1;
+                cache.pe_of_row[row]    = source;
+                cache.row_of_pe[source] = row;
+
+                std::vector< int > & dist = cache.rows[row];
+                dist.assign(m_dim, std::numeric_limits< int >::max());
+                dist[source] = 0;
+
+                if( m_unweighted ) {
+                        std::queue< NodeID > bfsqueue;
+                        bfsqueue.push(source);
+                        while( !bfsqueue.empty() ) {
+                                NodeID node = bfsqueue.front();
+                                bfsqueue.pop();
+                                forall_out_edges(m_topology, e, node) {
+                                        NodeID target = m_topology.getEdgeTarget(e);
+                                        if( dist[target] == std::numeric_limits< int >::max() ) {
+                                                dist[target] = dist[node] + 1;
+                                                bfsqueue.push(target);
+                                        }
+                                } endfor
+                        }
+                } else {
+                        typedef std::pair< int, NodeID > entry;
+                        std::priority_queue< entry, std::vector< entry >, std::greater< entry > > pq;
+                        pq.push(entry(0, source));
+                        while( !pq.empty() ) {
+                                entry top = pq.top();
+                                pq.pop();
+                                if( top.first > dist[top.second] ) continue;
+
+                                forall_out_edges(m_topology, e, top.second) {
+                                        NodeID target = m_topology.getEdgeTarget(e);
+                                        int length    = top.first + m_topology.getEdgeWeight(e);
+                                        if( length < dist[target] ) {
+                                                dist[target] = length;
+                                                pq.push(entry(length, target));
+                                        }
+                                } endfor
+                        }
+                }
+
+                return row;
+        }
+
+        graph_access & m_topology;
+        unsigned int m_dim;
+        bool m_unweighted;
+
+        std::vector< row_cache > m_caches;
+};
+
+
+#endif /* end of include guard: TOPOLOGY_DISTANCE_MATRIX_6PX3WNQ8 */
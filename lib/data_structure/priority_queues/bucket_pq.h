@@ -37,6 +37,8 @@ class bucket_pq : public priority_queue_interface {
 
                 bool contains(NodeID node) override;
 
+                void clear() override;
+
               private:
                 NodeID     m_elements;
                 EdgeWeight m_gain_span;
@@ -153,5 +155,16 @@ inline bool bucket_pq::contains(NodeID node) {
         return m_queue_index.find(node) != m_queue_index.end();
 }
 
+inline void bucket_pq::clear() {
+        // erase the elements one by one, clearing the hash table would touch all of its buckets
+        std::unordered_map<NodeID, std::pair<Count, Gain> >::iterator it = m_queue_index.begin();
+        while( it != m_queue_index.end() ) {
+                m_buckets[it->second.second + m_gain_span].clear();
+                it = m_queue_index.erase(it);
+        }
+
+        m_elements = 0;
+        m_max_idx  = 0;
+}
 
 #endif /* end of include guard: BUCKET_PQ_EM8YJPA9 */
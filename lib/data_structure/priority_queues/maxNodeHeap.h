@@ -83,6 +83,8 @@ class maxNodeHeap : public priority_queue_interface {
                 void changeKey(NodeID node, Gain gain) override;
                 Gain getKey(NodeID node) override;
 
+                void clear() override;
+
         private:
                 std::vector< PQElement >               m_elements;      // elements that contain the data
                 std::unordered_map<NodeID, int>   m_element_index; // stores index of the node in the m_elements array
@@ -279,6 +281,16 @@ inline Gain maxNodeHeap::getKey(NodeID node) {
         return m_heap[m_elements[m_element_index[node]].get_index()].first;
 };
 
+inline void maxNodeHeap::clear() {
+        // erase the elements one by one, clearing the hash table would touch all of its buckets
+        for( unsigned i = 0; i < m_elements.size(); i++) {
+                m_element_index.erase(m_elements[i].get_data().node);
+        }
+
+        m_elements.clear();
+        m_heap.clear();
+}
+
 
 inline bool maxNodeHeap::contains(NodeID node) {
        return m_element_index.find(node) != m_element_index.end();
@@ -104,9 +104,17 @@ typedef enum {
         MATCHING_RANDOM, 
 	MATCHING_GPA, 
 	MATCHING_RANDOM_GPA,
-        CLUSTER_COARSENING
+        CLUSTER_COARSENING,
+        MATCHING_LOCAL_MAX
 } MatchingType;
 
+typedef enum {
+        RELABELING_NONE,
+        RELABELING_BFS,
+        RELABELING_RCM,
+        RELABELING_DEGREE
+} RelabelingType;
+
 typedef enum {
 	INITIAL_PARTITIONING_RECPARTITION, 
 	INITIAL_PARTITIONING_BIPARTITION
@@ -178,7 +186,8 @@ typedef enum {
         DIST_CONST_RANDOM, 
         DIST_CONST_IDENTITY,
         DIST_CONST_HIERARCHY,
-        DIST_CONST_HIERARCHY_ONLINE
+        DIST_CONST_HIERARCHY_ONLINE,
+        DIST_CONST_TOPOLOGY
 } DistanceConstructionAlgorithm;
 
 typedef enum {
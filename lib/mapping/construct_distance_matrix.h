@@ -35,6 +35,7 @@ public:
                                 construct_matrix_hierarchy( config, D);
                                 break;
                         case DIST_CONST_HIERARCHY_ONLINE: 
+                        case DIST_CONST_TOPOLOGY: 
                                 break;
                         default: 
                                 construct_matrix_random( config, D );
@@ -8,6 +8,10 @@
 #ifndef LOCAL_SEARCH_MAPPING_CCR5FJN
 #define LOCAL_SEARCH_MAPPING_CCR5FJN
 
+#include <algorithm>
+#include <omp.h>
+#include <stdint.h>
+
 #include "partition_config.h"
 #include "data_structure/graph_access.h"
 #include "data_structure/matrix/matrix.h"
@@ -19,12 +23,36 @@ public:
         local_search_mapping();
         virtual ~local_search_mapping();
            
-        template < typename search_space > 
-        void perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+        // the distances are a template parameter, so that the queries can be inlined for final matrix types
+        template < typename search_space, typename distance_matrix > 
+        void perform_local_search( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank);
+
+        // swaps with partners in the config.communication_neighborhood_dist neighborhood. in every round
+        // the best swap of each node is computed in parallel, then the improving swaps are applied
+        // best first, skipping swaps that touch a node adjacent to an already swapped node
+        template < typename distance_matrix > 
+        void perform_parallel_local_search( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank);
 
 private:
-        bool perform_single_swap(graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
-        void update_node_contribution( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
+        // decrease of the objective if lhs and rhs are swapped, the mapping is not modified
+        template < typename distance_matrix > 
+        int64_t swap_gain(graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
+
+        // swapping two PEs of the same hierarchy node does not change the objective, other
+        // distance matrices (e.g. a topology graph) may have distances[0] between distinct nodes
+        bool skip_inner_swaps(const PartitionConfig & config) {
+                return config.distance_construction_algorithm == DIST_CONST_HIERARCHY
+                    || config.distance_construction_algorithm == DIST_CONST_HIERARCHY_ONLINE;
+        }
+
+        // all nodes with distance 1..max_depth from node, depth has to be -1 everywhere and is reset afterwards
+        void neighborhood(graph_access & C, NodeID node, int max_depth, std::vector< int > & depth, std::vector< NodeID > & nodes);
+
+        template < typename distance_matrix > 
+        bool perform_single_swap(graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
+
+        template < typename distance_matrix > 
+        void update_node_contribution( graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
 
         // Data Members
         std::vector< NodeID > node_contribution;
@@ -34,8 +62,8 @@ private:
 
 // input a valid initial mapping
 // output a valid hopefully better mapping
-template < typename search_space > 
-void local_search_mapping::perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+template < typename search_space, typename distance_matrix > 
+void local_search_mapping::perform_local_search( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank) {
         timer t; t.restart();
 
         //compute total metric
@@ -57,6 +85,7 @@ void local_search_mapping::perform_local_search( PartitionConfig & config, graph
 
         search_space fss(config, C.number_of_nodes());
 	fss.set_graph_ref( &C);
+        bool skip_inner = skip_inner_swaps(config);
 
         while ( !fss.done() ) {
                 std::pair< NodeID, NodeID > cur_pair = fss.nextPair();
@@ -64,7 +93,7 @@ void local_search_mapping::perform_local_search( PartitionConfig & config, graph
                 NodeID swap_lhs = cur_pair.first;
                 NodeID swap_rhs = cur_pair.second;
 
-                if( D.get_xy(perm_rank[swap_lhs], perm_rank[swap_rhs]) == config.distances[0] ) {
+                if( skip_inner && D.get_xy(perm_rank[swap_lhs], perm_rank[swap_rhs]) == config.distances[0] ) {
                         fss.commit_status(false);
                         continue; // skipping swaps inside nodes 
                 }
@@ -82,4 +111,213 @@ void local_search_mapping::perform_local_search( PartitionConfig & config, graph
 }
 
 
+template < typename distance_matrix > 
+bool local_search_mapping::perform_single_swap(graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs) {
+        NodeWeight old_volume      = total_volume;
+        NodeWeight old_lhs_contrib = node_contribution[swap_lhs];
+        NodeWeight old_rhs_contrib = node_contribution[swap_rhs];
+
+        // we multiply by two since contributions are on both sides
+        total_volume -= 2*node_contribution[swap_lhs];
+        total_volume -= 2*node_contribution[swap_rhs];
+
+        // fix adjacent candiates
+        forall_out_edges(C, e, swap_lhs) {
+                NodeID target = C.getEdgeTarget(e);
+                if( target == swap_rhs ) {
+                        NodeWeight comm_vol     = C.getEdgeWeight(e);
+                        NodeID perm_rank_node   = perm_rank[swap_lhs];
+                        NodeID perm_rank_target = perm_rank[swap_rhs];
+                        NodeWeight cur_vol      = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
+                        total_volume += 2*cur_vol;
+                        break;
+                }
+        } endfor
+
+        node_contribution[swap_lhs] = 0;
+        node_contribution[swap_rhs] = 0;
+
+        std::swap(perm_rank[swap_lhs], perm_rank[swap_rhs]);
+        update_node_contribution( C, D, perm_rank, swap_lhs, swap_rhs );
+
+        total_volume += 2*node_contribution[swap_lhs]; 
+        total_volume += 2*node_contribution[swap_rhs]; 
+
+        // fix adjacent candiates
+        forall_out_edges(C, e, swap_lhs) {
+                NodeID target = C.getEdgeTarget(e);
+                if( target == swap_rhs ) {
+                        NodeWeight comm_vol     = C.getEdgeWeight(e);
+                        NodeID perm_rank_node   = perm_rank[swap_lhs];
+                        NodeID perm_rank_target = perm_rank[swap_rhs];
+                        NodeWeight cur_vol      = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
+                        total_volume -= 2*cur_vol;
+                        break;
+                }
+        } endfor
+
+        if( total_volume < old_volume ) {
+                PRINT(std::cout <<  "log> improvement " <<  total_volume <<  " " <<  old_volume << std::endl;)
+                return true;
+        } else {
+                std::swap(perm_rank[swap_lhs], perm_rank[swap_rhs]);
+                update_node_contribution( C, D, perm_rank, swap_lhs, swap_rhs );
+                node_contribution[swap_lhs] = old_lhs_contrib;
+                node_contribution[swap_rhs] = old_rhs_contrib;
+                total_volume = old_volume;
+                return false;
+        }
+}
+
+template < typename distance_matrix > 
+void local_search_mapping::update_node_contribution( graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs) {
+        forall_out_edges(C, e, swap_lhs) {
+                NodeID target                   = C.getEdgeTarget(e);
+                NodeWeight comm_vol             = C.getEdgeWeight(e);
+                NodeID perm_rank_node           = perm_rank[swap_lhs];
+                NodeID perm_rank_target         = perm_rank[target];
+                NodeWeight cur_vol              = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
+                node_contribution[ swap_lhs ]  += cur_vol;
+
+                // update adjacent node contrib
+                if( target != swap_rhs) {
+                        node_contribution[ target ] -= comm_vol*D.get_xy(perm_rank[swap_rhs], perm_rank_target);
+                        node_contribution[ target ] += cur_vol;
+                }
+        } endfor
+        forall_out_edges(C, e, swap_rhs) {
+                NodeID target                   = C.getEdgeTarget(e);
+                NodeWeight comm_vol             = C.getEdgeWeight(e);
+                NodeID perm_rank_node           = perm_rank[swap_rhs];
+                NodeID perm_rank_target         = perm_rank[target];
+                NodeWeight cur_vol              = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
+                node_contribution[ swap_rhs ]  += cur_vol;
+
+                if( target != swap_lhs) {
+                        node_contribution[ target ] -= comm_vol*D.get_xy(perm_rank[swap_lhs], perm_rank_target);
+                        node_contribution[ target ] += cur_vol;
+                }
+        } endfor
+}
+
+
+template < typename distance_matrix > 
+void local_search_mapping::perform_parallel_local_search( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank) {
+        const NodeID PARALLEL_MAPPING_THRESHOLD = 1000;
+        const NodeID n = C.number_of_nodes();
+        const bool skip_inner = skip_inner_swaps(config);
+
+        //compute total metric
+        int64_t volume = 0;
+        node_contribution.resize(n, 0);
+        #pragma omp parallel for schedule(static) reduction(+:volume) if(n > PARALLEL_MAPPING_THRESHOLD)
+        for( NodeID node = 0; node < n; node++) {
+                NodeWeight contribution = 0;
+                forall_out_edges(C, e, node) {
+                        NodeID target  = C.getEdgeTarget(e);
+                        contribution  += C.getEdgeWeight(e)*D.get_xy(perm_rank[node], perm_rank[target]);
+                } endfor
+                node_contribution[node] = contribution;
+                volume += contribution;
+        }
+        total_volume = volume;
+        PRINT(std::cout <<  "J(C,D,Pi) = " <<  total_volume << std::endl;)
+
+        std::vector< NodeID >  best_partner(n);
+        std::vector< int64_t > best_gain(n);
+        std::vector< NodeID >  candidates;
+        std::vector< bool >    blocked(n);
+
+        bool improved = true;
+        while( improved ) {
+                #pragma omp parallel if(n > PARALLEL_MAPPING_THRESHOLD)
+                {
+                        std::vector< int > depth(n, -1);
+                        std::vector< NodeID > partners;
+
+                        #pragma omp for schedule(dynamic, 16)
+                        for( NodeID node = 0; node < n; node++) {
+                                best_partner[node] = node;
+                                best_gain[node]    = 0;
+
+                                // every pair is evaluated by its smaller node
+                                neighborhood(C, node, config.communication_neighborhood_dist, depth, partners);
+                                for( NodeID partner : partners ) {
+                                        if( partner < node ) continue;
+                                        if( skip_inner && D.get_xy(perm_rank[node], perm_rank[partner]) == config.distances[0] ) {
+                                                continue; // skipping swaps inside nodes 
+                                        }
+
+                                        int64_t gain = swap_gain(C, D, perm_rank, node, partner);
+                                        if( gain > best_gain[node] ) {
+                                                best_partner[node] = partner;
+                                                best_gain[node]    = gain;
+                                        }
+                                }
+                        }
+                }
+
+                candidates.clear();
+                forall_nodes(C, node) {
+                        if( best_partner[node] != node ) candidates.push_back(node);
+                } endfor
+                std::sort(candidates.begin(), candidates.end(), [&](NodeID lhs, NodeID rhs) {
+                                return best_gain[lhs] > best_gain[rhs] || (best_gain[lhs] == best_gain[rhs] && lhs < rhs);
+                                });
+
+                // the gain of a swap stays valid as long as no endpoint and no neighbor of an endpoint has been swapped
+                std::fill(blocked.begin(), blocked.end(), false);
+                improved = false;
+                for( NodeID lhs : candidates ) {
+                        NodeID rhs = best_partner[lhs];
+                        if( blocked[lhs] || blocked[rhs] ) continue;
+
+                        node_contribution[lhs] = 0;
+                        node_contribution[rhs] = 0;
+                        std::swap(perm_rank[lhs], perm_rank[rhs]);
+                        update_node_contribution( C, D, perm_rank, lhs, rhs );
+                        total_volume -= best_gain[lhs];
+                        improved      = true;
+
+                        blocked[lhs] = true;
+                        blocked[rhs] = true;
+                        forall_out_edges(C, e, lhs) {
+                                blocked[C.getEdgeTarget(e)] = true;
+                        } endfor
+                        forall_out_edges(C, e, rhs) {
+                                blocked[C.getEdgeTarget(e)] = true;
+                        } endfor
+                }
+                PRINT(std::cout <<  "log> round " <<  total_volume << std::endl;)
+        }
+
+        if( total_volume != qm.total_qap(C, D, perm_rank)) {
+                std::cout <<  "objective function mismatch"  << std::endl;
+                exit(0);
+        }
+}
+
+template < typename distance_matrix > 
+int64_t local_search_mapping::swap_gain(graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs) {
+        NodeID lhs_rank = perm_rank[swap_lhs];
+        NodeID rhs_rank = perm_rank[swap_rhs];
+
+        // the edge between lhs and rhs keeps its length
+        int64_t new_contribution = 0;
+        forall_out_edges(C, e, swap_lhs) {
+                NodeID target      = C.getEdgeTarget(e);
+                NodeID target_rank = target == swap_rhs ? lhs_rank : perm_rank[target];
+                new_contribution  += C.getEdgeWeight(e)*D.get_xy(rhs_rank, target_rank);
+        } endfor
+        forall_out_edges(C, e, swap_rhs) {
+                NodeID target      = C.getEdgeTarget(e);
+                NodeID target_rank = target == swap_lhs ? rhs_rank : perm_rank[target];
+                new_contribution  += C.getEdgeWeight(e)*D.get_xy(lhs_rank, target_rank);
+        } endfor
+
+        // contributions are on both sides
+        int64_t old_contribution = (int64_t)node_contribution[swap_lhs] + node_contribution[swap_rhs];
+        return 2*(old_contribution - new_contribution);
+}
+
 #endif /* end of include guard: LOCAL_SEARCH_MAPPING_CCR5FJN */
@@ -6,11 +6,13 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <omp.h>
 #include "communication_graph_search_space.h"
 #include "construct_distance_matrix.h"
 #include "construct_mapping.h"
 #include "full_search_space.h"
 #include "full_search_space_pruned.h"
+#include "io/graph_io.h"
 #include "local_search_mapping.h"
 #include "mapping_algorithms.h"
 #include "partition/partition_config.h"
@@ -29,6 +31,39 @@ void mapping_algorithms::construct_a_mapping( PartitionConfig & config, graph_ac
         construct_distance_matrix cdm;
         cdm.construct_matrix( config, D );
 
+        map( config, C, D, perm_rank );
+}
+
+void mapping_algorithms::construct_a_mapping( PartitionConfig & config, graph_access & C, hierarchical_distance_matrix & D, std::vector< NodeID > & perm_rank) {
+        // the distances are computed on the fly
+        map( config, C, D, perm_rank );
+}
+
+NodeWeight mapping_algorithms::construct_a_mapping_on_topology( PartitionConfig & config, graph_access & C, std::vector< NodeID > & perm_rank) {
+        graph_access topology;
+        if( graph_io::readGraphWeighted(topology, config.topology_filename) != 0 ) {
+                std::cout <<  "could not read the topology graph " << config.topology_filename  << std::endl;
+                exit(0);
+        }
+        if( topology.number_of_nodes() != config.k ) {
+                std::cout <<  "the topology graph has " << topology.number_of_nodes() << " PEs but k is " << config.k  << std::endl;
+                exit(0);
+        }
+
+        double rows = config.topology_cache_size*1024*1024 / (sizeof(int) * (double)topology.number_of_nodes());
+        int threads = config.parallel_mapping_local_search ? omp_get_max_threads() : 1;
+        topology_distance_matrix D(topology, (unsigned int)std::min((double)topology.number_of_nodes(), std::max(1.0, rows)), threads);
+        if( !D.is_connected() ) {
+                std::cout <<  "the topology graph is not connected"  << std::endl;
+                exit(0);
+        }
+
+        map( config, C, D, perm_rank );
+        return qm.total_qap(C, D, perm_rank);
+}
+
+template < typename distance_matrix >
+void mapping_algorithms::map( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank) {
         t.restart();
         construct_mapping cm;
         cm.construct_initial_mapping( config, C, D, perm_rank);
@@ -36,6 +71,12 @@ void mapping_algorithms::construct_a_mapping( PartitionConfig & config, graph_ac
         
         t.restart();
         local_search_mapping lsm;
+        if( config.parallel_mapping_local_search ) {
+                lsm.perform_parallel_local_search( config, C, D, perm_rank);
+                PRINT(std::cout <<  "local search took " <<  t.elapsed()  << std::endl;)
+                return;
+        }
+
         switch( config.ls_neighborhood ) {
                 case NSQUARE:
                         lsm.perform_local_search< full_search_space > ( config, C, D, perm_rank);
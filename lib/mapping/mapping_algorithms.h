@@ -9,7 +9,9 @@
 #define MAPPING_ALGORITHMS_W4I4JZHS
 
 #include "data_structure/graph_access.h"
+#include "data_structure/matrix/hierarchical_distance_matrix.h"
 #include "data_structure/matrix/normal_matrix.h"
+#include "data_structure/matrix/topology_distance_matrix.h"
 #include "partition_config.h"
 #include "tools/quality_metrics.h"
 #include "tools/timer.h"
@@ -20,9 +22,19 @@ public:
         virtual ~mapping_algorithms();
 
         void construct_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+        // D has to be initialized with setPartitionConfig
+        void construct_a_mapping( PartitionConfig & config, graph_access & C, hierarchical_distance_matrix & D, std::vector< NodeID > & perm_rank);
+
+        // maps onto the network in config.topology_filename and returns the objective
+        NodeWeight construct_a_mapping_on_topology( PartitionConfig & config, graph_access & C, std::vector< NodeID > & perm_rank);
+
         void graph_to_matrix( graph_access & C, matrix & C_bar);
 
 private:
+        template < typename distance_matrix >
+        void map( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank);
+
         quality_metrics qm; 
         timer t;
 };
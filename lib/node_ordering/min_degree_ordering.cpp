@@ -3,208 +3,408 @@
  */
 
 #include <algorithm>
-#include <functional>
 #include <limits>
-#include <numeric>
-#include <unordered_map>
-#include <unordered_set>
 
 #include "node_ordering/min_degree_ordering.h"
-#include "node_ordering/ordering_tools.h"
 #include "tools/macros_assertions.h"
 
+namespace {
+const std::int64_t EMPTY = -1;
+}
+
 MinDegree::MinDegree(graph_access * const graph, const std::vector<NodeID> &halo_nodes) : graph(graph),
-                                                   memberships(graph->number_of_nodes()),
-                                                   node_links(graph->number_of_nodes()),
-                                                   link_weights(graph->number_of_nodes()),
+                                                   n(graph->number_of_nodes()),
+                                                   total_weight(0), nel(0), lemax(0),
+                                                   pfree(0), wflg(2), mindeg(0),
                                                    is_halo_node(graph->number_of_nodes(), false) {
         for (const auto node: halo_nodes) {
                 is_halo_node[node] = true;
         }
-        std::iota(node_links.begin(), node_links.end(), 0);
-        forall_nodes((*graph), node) {
-                link_weights[node] = graph->getNodeWeight(node);
-        } endfor
 }
 
-void MinDegree::initialize_cliques() {
+void MinDegree::initialize() {
+        amd_int nnz = graph->number_of_edges();
+        // Elbow room for new elements. If it is used up, the workspace is compressed (and grown).
+        iw.resize(nnz + nnz / 5 + 2 * n + 1);
+        pe.resize(n);
+        len.resize(n);
+        elen.assign(n, 0);
+        status.assign(n, VARIABLE);
+        nv.resize(n);
+        degree.resize(n);
+        w.assign(n, 1);
+        next.assign(n, EMPTY);
+        last.assign(n, EMPTY);
+        hash_head.assign(n, EMPTY);
+        chain_next.assign(n, EMPTY);
+        chain_tail.resize(n);
+
+        pfree = 0;
         forall_nodes((*graph), node) {
-                if (!is_halo_node[node]) {
-                        current_nodes.insert(node);
-                        // Instead of the node degree use the adjusted reachable set size
-                        // We use the negative degree, because bucket_pq sorts by maximum
-                        degree_pq.insert(node, -(Gain)compute_reachable_set_size(*graph, node));
-                }
-                // Make each edge a clique
+                nv[node] = graph->getNodeWeight(node);
+                total_weight += nv[node];
+                chain_tail[node] = node;
+                pe[node] = pfree;
                 forall_out_edges((*graph), edge, node) {
-                        auto target = graph->getEdgeTarget(edge);
-                        if (!degree_pq.contains(target) || is_halo_node[target]) {
-                                cliques.push_back(clique( { node, target } ));
-                                memberships[node].push_back(cliques.size()-1);
-                                memberships[target].push_back(cliques.size()-1);
+                        NodeID target = graph->getEdgeTarget(edge);
+                        if (target != node) {
+                                iw[pfree++] = target;
                         }
                 } endfor
+                len[node] = pfree - pe[node];
+        } endfor
+
+        head.assign(total_weight + 1, EMPTY);
+        mindeg = total_weight;
+        forall_nodes((*graph), node) {
+                // Weighted external degree, adjusted by the contraction offset of reduced nodes
+                amd_int deg = 0;
+                for (amd_int p = pe[node]; p < pe[node] + len[node]; ++p) {
+                        deg += nv[iw[p]];
+                }
+                deg -= graph->get_contraction_offset(node);
+                deg = std::max<amd_int>(0, std::min(deg, total_weight));
+                degree[node] = deg;
+                if (!is_halo_node[node]) {
+                        insert_degree_list(node, deg);
+                }
         } endfor
 }
 
 void MinDegree::perform_ordering(std::vector<NodeID> &labels) {
-        initialize_cliques();
+        initialize();
 
         NodeID order = 0;
+        std::vector<amd_int> eliminated;
+        const amd_int max_degree = head.size() - 1;
         // Eliminate nodes until no nodes are left
-        while (!current_nodes.empty()) {
-                if (degree_pq.empty()) {
+        while (true) {
+                while (mindeg <= max_degree && head[mindeg] == EMPTY) {
+                        ++mindeg;
+                }
+                if (mindeg > max_degree) {
                         break;
                 }
 
                 // Select the node with the smallest degree
-                auto min_degree = -degree_pq.maxValue();
-                auto min_degree_node = degree_pq.deleteMax();
-                if (min_degree > 0 && !memberships[min_degree_node].empty()) {
-                        auto merged_clique_index = eliminate_node(min_degree_node);
-                        // Label nodes indistinguishable from min_degree_node before degree update
-                        label_node(min_degree_node, labels, order);
-                        update_node_degrees(min_degree_node, merged_clique_index);
-                } else {
-                        label_node(min_degree_node, labels, order);
-                }
+                amd_int me = head[mindeg];
+                eliminated.clear();
+                eliminate_node(me, eliminated);
 
-                // remove the minimum degree node and order it next
-                current_nodes.erase(current_nodes.find(min_degree_node));
-                // If min_degree_node was a neighbor of an eliminated node,
-                // it no longer is.
-                elimination_neighbors.remove(min_degree_node);
+                // Order the pivot and everything eliminated along with it
+                label_node(me, labels, order);
+                for (auto node: eliminated) {
+                        label_node(node, labels, order);
+                }
         }
         forall_nodes((*graph), node) {
-                if (is_halo_node[node]) {
+                if (is_halo_node[node] && status[node] == VARIABLE) {
                         label_node(node, labels, order);
                 }
         } endfor
 }
 
-size_t MinDegree::eliminate_node(NodeID node) {
-        auto merged_clique_idx = memberships[node].front();
-        auto& merged_clique = cliques[merged_clique_idx];
-        for (size_t idx = 1; idx < memberships[node].size(); ++idx) {
-                auto clique_idx = memberships[node][idx];
-                merged_clique.merge(cliques[clique_idx]);
-        }
-        merged_clique.remove(node);
-        return merged_clique_idx;
-}
+void MinDegree::eliminate_node(amd_int me, std::vector<amd_int> &eliminated) {
+        remove_degree_list(me);
+        amd_int nvpiv = nv[me];
+        nel += nvpiv;
+        nv[me] = -nvpiv;
 
-void MinDegree::update_node_degrees(NodeID eliminated_node, size_t merged_clique_idx) {
-        auto& merged_clique = cliques[merged_clique_idx];
-        // Remove all cliques containing the min degree node
-        // from the clique list of each node that needs to be updated
-        // and update the node degrees
-
-        new_indistinguishable_nodes.clear();
-        clique prototype;
-        bool found_prototype = false;
-        // Place the updated nodes in the elimination neighbors list, before actually updating the degrees
-        for (const auto node: merged_clique) {
-                elimination_neighbors.insert(node);
-        }
-        for (const auto node: merged_clique) {
-                if (is_halo_node[node]) {
-                        // We don't care about the correct degree of halo nodes
-                        // or which cliques they are a member of, so we update them
-                        continue;
-                }
-                // We need the set of all neighbors of 'node' to update the degree
-                // 'isec' is the intersection of all cliques 'node' belongs to,
-                // so we can just sum up the weights of those nodes later.
-                clique isec;
-                auto it = memberships[node].begin();
-                while (it != memberships[node].end()) {
-                        // Remove cliques that are a subset of merged_clique (element absorption)
-                        // and cliques that contain the eliminated node
-                        if (cliques[*it].contains(eliminated_node)) {
-                                // Swap and pop for faster removal
-                                *it = memberships[node].back();
-                                memberships[node].pop_back();
-                        } else if (merged_clique.contains_all_of(cliques[*it].begin(), cliques[*it].end())) {
-                                *it = memberships[node].back();
-                                memberships[node].pop_back();
+        // Construct the new element Lme = iw[pme1, pme2).
+        // Variables in Lme are flagged by a negative nv.
+        amd_int degme = 0;
+        amd_int pme1, pme2;
+        bool built_in_place = elen[me] == 0;
+        if (built_in_place) {
+                // 'me' is not adjacent to an element, Lme replaces its adjacency list
+                pme1 = pe[me];
+                pme2 = pme1;
+                for (amd_int p = pe[me]; p < pe[me] + len[me]; ++p) {
+                        amd_int i = iw[p];
+                        amd_int nvi = nv[i];
+                        if (nvi > 0) {
+                                degme += nvi;
+                                nv[i] = -nvi;
+                                iw[pme2++] = i;
+                                remove_degree_list(i);
+                        }
+                }
+        } else {
+                // Lme is the union of the adjacent elements and variables, built at the end of iw
+                amd_int bound = len[me] - elen[me];
+                for (amd_int p = pe[me]; p < pe[me] + elen[me]; ++p) {
+                        bound += len[iw[p]];
+                }
+                if (pfree + bound > (amd_int)iw.size()) {
+                        compress_workspace(bound);
+                }
+
+                pme1 = pfree;
+                pme2 = pfree;
+                amd_int p = pe[me];
+                for (amd_int k = 0; k <= elen[me]; ++k) {
+                        amd_int e, pj, ln;
+                        if (k == elen[me]) {
+                                e = me;
+                                pj = p;
+                                ln = len[me] - elen[me];
                         } else {
-                                isec.merge(cliques[*it]);
-                                ++it;
+                                e = iw[p++];
+                                if (status[e] != ELEMENT) continue;
+                                pj = pe[e];
+                                ln = len[e];
+                        }
+                        for (amd_int q = pj; q < pj + ln; ++q) {
+                                amd_int i = iw[q];
+                                amd_int nvi = nv[i];
+                                if (nvi > 0) {
+                                        degme += nvi;
+                                        nv[i] = -nvi;
+                                        iw[pme2++] = i;
+                                        remove_degree_list(i);
+                                }
+                        }
+                        if (e != me) {
+                                // element absorption: e is a subset of Lme
+                                status[e] = DEAD;
+                                w[e] = 0;
+                        }
+                }
+                pfree = pme2;
+        }
+        status[me] = ELEMENT;
+        pe[me] = pme1;
+        len[me] = pme2 - pme1;
+        elen[me] = 0;
+
+        // Compute |Le \ Lme| = w[e] - wflg for all elements e adjacent to a variable in Lme
+        clear_flag();
+        for (amd_int p = pme1; p < pme2; ++p) {
+                amd_int i = iw[p];
+                amd_int nvi = -nv[i];
+                amd_int wnvi = wflg - nvi;
+                for (amd_int q = pe[i]; q < pe[i] + elen[i]; ++q) {
+                        amd_int e = iw[q];
+                        amd_int we = w[e];
+                        if (we >= wflg) {
+                                we -= nvi;
+                        } else if (we != 0) {
+                                we = degree[e] + wnvi;
+                        }
+                        w[e] = we;
+                }
+        }
+
+        // Degree update and element absorption. The lists of the variables in Lme
+        // are pruned and 'me' is placed first, the variables are hashed by their lists.
+        for (amd_int p = pme1; p < pme2; ++p) {
+                amd_int i = iw[p];
+                amd_int p1 = pe[i];
+                amd_int p2 = p1 + elen[i];
+                amd_int pn = p1;
+                amd_int deg = 0;
+                std::uint64_t hash = 0;
+
+                for (amd_int q = p1; q < p2; ++q) {
+                        amd_int e = iw[q];
+                        amd_int we = w[e];
+                        if (we != 0) {
+                                amd_int dext = we - wflg;
+                                if (dext > 0) {
+                                        deg += dext;
+                                        iw[pn++] = e;
+                                        hash += e;
+                                } else {
+                                        // aggressive absorption: Le is a subset of Lme
+                                        status[e] = DEAD;
+                                        w[e] = 0;
+                                }
                         }
                 }
-                memberships[node].push_back(merged_clique_idx);
-                isec.merge(merged_clique);
-
-                // Test if 'node' has neighbors only in the 'elimination_neighbors' set,
-                // i.e., if the neighbors of 'node' have all been neighbors of an eliminated node before
-                // TODO: comparing against the first isec gives indistinguishable nodes, but it's not a great solution
-                if (elimination_neighbors.contains_all_of(isec.begin(), isec.end())) {
-                        if (!found_prototype) {
-                                prototype = isec;
-                                new_indistinguishable_nodes.push_back(node);
-                                found_prototype = true;
-                        } else if (isec == prototype) {
-                                new_indistinguishable_nodes.push_back(node);
+                elen[i] = pn - p1 + 1;
+
+                amd_int p3 = pn;
+                amd_int p4 = p1 + len[i];
+                for (amd_int q = p2; q < p4; ++q) {
+                        amd_int j = iw[q];
+                        amd_int nvj = nv[j];
+                        if (nvj > 0) {
+                                // variables in Lme (nvj < 0) are covered by 'me'
+                                deg += nvj;
+                                iw[pn++] = j;
+                                hash += j;
                         }
                 }
 
-                // Perform the degree update.
-                // 'isec' contains the neighbors of 'node' and 'node' itself.
-                // We can ignore the contraction offset here, because
-                // it becomes zero as soon as a neighbor of 'node'
-                // is eliminated.
-                Gain node_degree = 0;
-                for (auto neighbor: isec) {
-                        node_degree += link_weights[neighbor];
+                if (elen[i] == 1 && p3 == pn && !is_halo_node[i]) {
+                        // mass elimination: i is adjacent to 'me' only
+                        amd_int nvi = -nv[i];
+                        degme -= nvi;
+                        nvpiv += nvi;
+                        nel += nvi;
+                        nv[i] = 0;
+                        status[i] = DEAD;
+                        eliminated.push_back(i);
+                } else {
+                        degree[i] = std::min(degree[i], deg);
+                        // move the first element to the end of the elements, the first variable
+                        // to the end of the list and place 'me' first
+                        iw[pn] = iw[p3];
+                        iw[p3] = iw[p1];
+                        iw[p1] = me;
+                        len[i] = pn - p1 + 1;
+
+                        hash %= n;
+                        next[i] = hash_head[hash];
+                        hash_head[hash] = i;
+                        last[i] = hash;
                 }
-                node_degree -= 1;
-                degree_pq.changeKey(node, -node_degree);
         }
-        update_indistinguishable_nodes();
-}
+        degree[me] = degme;
+        lemax = std::max(lemax, degme);
+        wflg += lemax;
+        clear_flag();
 
-void MinDegree::update_indistinguishable_nodes() {
-        if (new_indistinguishable_nodes.size() > 1) {
-                auto representative = new_indistinguishable_nodes[0];
-                auto link = representative;
-                for (unsigned int i = 1; i < new_indistinguishable_nodes.size(); ++i) {
-                        // link from the representative to the next indistinguishable node
-                        // if the representative already links to some other node, link from
-                        // the first node that links to itself
-                        while (node_links[link] != link) {
-                                link = node_links[link];
+        // Supervariable detection: variables with the same hash are compared
+        // and indistinguishable ones are merged into one supervariable.
+        for (amd_int p = pme1; p < pme2; ++p) {
+                amd_int i = iw[p];
+                if (nv[i] >= 0) continue; // mass eliminated or already merged
+
+                amd_int hash = last[i];
+                amd_int j = hash_head[hash];
+                if (j == EMPTY) continue;
+                hash_head[hash] = EMPTY;
+
+                for (; j != EMPTY && next[j] != EMPTY; j = next[j]) {
+                        amd_int ln = len[j];
+                        amd_int eln = elen[j];
+                        for (amd_int q = pe[j] + 1; q < pe[j] + ln; ++q) {
+                                w[iw[q]] = wflg;
                         }
-                        link = node_links[link] = new_indistinguishable_nodes[i];
-                        
-                        // Remove the non-representative nodes from all relevant node sets
-                        // Remove the node from the current_nodes
-                        current_nodes.erase(current_nodes.find(new_indistinguishable_nodes[i]));
-                        degree_pq.deleteNode(new_indistinguishable_nodes[i]);
-                        // Remove the node from all cliques it's a member of
-                        for (auto &clique_id: memberships[new_indistinguishable_nodes[i]]) {
-                                cliques[clique_id].remove(new_indistinguishable_nodes[i]);
+
+                        amd_int jlast = j;
+                        amd_int k = next[j];
+                        while (k != EMPTY) {
+                                bool same = len[k] == ln && elen[k] == eln && is_halo_node[k] == is_halo_node[j];
+                                for (amd_int q = pe[k] + 1; same && q < pe[k] + ln; ++q) {
+                                        same = w[iw[q]] == wflg;
+                                }
+                                if (same) {
+                                        // k is indistinguishable from j
+                                        nv[j] += nv[k];
+                                        nv[k] = 0;
+                                        status[k] = DEAD;
+                                        chain_next[chain_tail[j]] = k;
+                                        chain_tail[j] = chain_tail[k];
+
+                                        k = next[k];
+                                        next[jlast] = k;
+                                } else {
+                                        jlast = k;
+                                        k = next[k];
+                                }
                         }
-                        // Remove the node from elimination_neighbors?
-                        elimination_neighbors.remove(new_indistinguishable_nodes[i]);
+                        ++wflg;
+                        clear_flag();
                 }
-                // Compute total weight of indistinguishable nodes
-                link = representative;
-                link_weights[representative] = graph->getNodeWeight(link);
-                while (node_links[link] != link) {
-                        link = node_links[link];
-                        link_weights[representative] += graph->getNodeWeight(link);
+        }
+
+        // Finalize the degrees, put the variables back into the degree lists
+        // and remove merged variables from Lme
+        amd_int nleft = total_weight - nel;
+        amd_int pme = pme1;
+        for (amd_int p = pme1; p < pme2; ++p) {
+                amd_int i = iw[p];
+                amd_int nvi = -nv[i];
+                if (nvi > 0) {
+                        nv[i] = nvi;
+                        amd_int deg = std::min(degree[i] + degme - nvi, nleft - nvi);
+                        deg = std::max<amd_int>(0, deg);
+                        degree[i] = deg;
+                        if (!is_halo_node[i]) {
+                                insert_degree_list(i, deg);
+                        }
+                        iw[pme++] = i;
                 }
         }
+        nv[me] = nvpiv;
+        len[me] = pme - pe[me];
+        if (len[me] == 0) {
+                status[me] = DEAD;
+                w[me] = 0;
+        }
+        if (!built_in_place) {
+                pfree = pme;
+        }
+}
+
+void MinDegree::insert_degree_list(amd_int i, amd_int deg) {
+        amd_int inext = head[deg];
+        if (inext != EMPTY) {
+                last[inext] = i;
+        }
+        next[i] = inext;
+        last[i] = EMPTY;
+        head[deg] = i;
+        mindeg = std::min(mindeg, deg);
+}
+
+void MinDegree::remove_degree_list(amd_int i) {
+        if (is_halo_node[i]) {
+                return;
+        }
+        amd_int inext = next[i];
+        amd_int ilast = last[i];
+        if (inext != EMPTY) {
+                last[inext] = ilast;
+        }
+        if (ilast != EMPTY) {
+                next[ilast] = inext;
+        } else {
+                head[degree[i]] = inext;
+        }
+}
+
+void MinDegree::clear_flag() {
+        // wflg + lemax must not overflow
+        const amd_int wbig = std::numeric_limits<amd_int>::max() - total_weight - 1;
+        if (wflg < 2 || wflg >= wbig) {
+                for (amd_int x = 0; x < n; ++x) {
+                        if (w[x] != 0) {
+                                w[x] = 1;
+                        }
+                }
+                wflg = 2;
+        }
+}
+
+void MinDegree::compress_workspace(amd_int needed) {
+        std::vector<amd_int> live;
+        for (amd_int i = 0; i < n; ++i) {
+                if (status[i] != DEAD && len[i] > 0) {
+                        live.push_back(i);
+                }
+        }
+        // lists are moved to the front in the order of their position, so they never overlap
+        std::sort(live.begin(), live.end(), [this](amd_int a, amd_int b) { return pe[a] < pe[b]; });
+
+        amd_int dst = 0;
+        for (auto i: live) {
+                std::copy(iw.begin() + pe[i], iw.begin() + pe[i] + len[i], iw.begin() + dst);
+                pe[i] = dst;
+                dst += len[i];
+        }
+        pfree = dst;
+
+        if (pfree + needed > (amd_int)iw.size()) {
+                iw.resize(pfree + needed + (pfree + needed) / 5);
+        }
 }
 
-void MinDegree::label_node(NodeID node, std::vector<NodeID> &labels, NodeID &order) {
-        auto link = node;
-        // Order the node itself
-        labels[link] = order;
-        order += 1;
-        // Order indistinguishable nodes
-        while (node_links[link] != link) {
-                link = node_links[link];
+void MinDegree::label_node(amd_int node, std::vector<NodeID> &labels, NodeID &order) {
+        // Order the node itself and all indistinguishable nodes it represents
+        for (amd_int link = node; link != EMPTY; link = chain_next[link]) {
                 labels[link] = order;
                 order += 1;
         }
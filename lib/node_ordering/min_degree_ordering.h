@@ -5,95 +5,28 @@
 #ifndef MIN_DEGREE_ORDERING
 #define MIN_DEGREE_ORDERING
 
-#include <unordered_set>
+#include <cstdint>
 #include <vector>
 
 #include "data_structure/graph_access.h"
-#include "data_structure/priority_queues/maxNodeHeap.h"
 #include "definitions.h"
 
-// A clique, described by its set of nodes
-class clique {
-
-public:
-        // create a clique from a list of nodes
-        inline clique(std::unordered_set<NodeID> n = {}) : nodes(n) {};
-
-        // check if a node is part of this clique
-        inline bool contains(NodeID node) const { 
-                return nodes.find(node) != nodes.end();
-        }
-
-        template<class InputIt>
-        inline bool contains_all_of(InputIt first, InputIt last) {
-                for (auto it = first; it != last; ++it) {
-                        if (!contains(*it)) {
-                                return false;
-                        }
-                }
-                return true;
-        }
-
-        // merge the nodes of other into this clique
-        inline void merge(clique other) {
-                nodes.insert(other.nodes.begin(), other.nodes.end());
-        }
-
-        // remove node from this clique
-        inline std::unordered_set<NodeID>::const_iterator remove(NodeID node) {
-                auto it = nodes.find(node);
-                if (it != nodes.end()) {
-                        return nodes.erase(it);
-                }
-                return nodes.end();
-        }
-
-        // add node to this clique
-        inline void insert(NodeID node) {
-                nodes.insert(node);
-        }
-
-        inline bool empty() const {
-                return nodes.empty();
-        }
-
-        // return the number of nodes in the clique
-        inline std::unordered_set<NodeID>::size_type size() const {
-                return nodes.size();
-        }
-
-        inline bool operator==(const clique &other) const {
-                return nodes == other.nodes;
-        }
-
-        // iterators over the nodes in the clique
-        inline const std::unordered_set<NodeID>::const_iterator begin() const {
-                return nodes.cbegin();
-        }
-
-        inline const std::unordered_set<NodeID>::const_iterator end() const {
-                return nodes.cend();
-        }
-
-private:
-        std::unordered_set<NodeID> nodes;
-
-};
-
-
 // Use the min degree algorithm to compute a fill-reducing node ordering of G
 // Expectes 'labels' to have the correct size (= number of nodes).
 // Input:  G, the graph to be ordered
 // Output: labels, the order assigned to the nodes
 void min_degree_ordering(graph_access &G, std::vector<NodeID> &labels);
 
-// Reimplementation of the minimum degree algorithm
+// Approximate minimum degree ordering on a quotient graph
 // to get a min-degree ordering for some graph G, call 'MinDegree(&G).perform_ordering(labels);'
 //
-// This implements:
-//  - element absorption
-//  - a simplified version of simplicial node reduction
-//  - indistinguishable nodes, following George, Liu 1980, "A Fast Implementation of the Minimum Degree Algorithm Using Quotient Graphs"
+// This follows Amestoy, Davis, Duff 1996, "An Approximate Minimum Degree Ordering Algorithm".
+// Variables and elements (eliminated nodes) share one workspace array 'iw', the lists of
+// eliminated nodes are never copied into cliques. It implements:
+//  - element absorption (including aggressive absorption)
+//  - approximate external degrees
+//  - mass elimination and supervariable detection (indistinguishable nodes) by hashing
+// Halo nodes take part in the degree computation, but are never eliminated. They are ordered last.
 class MinDegree {
 
 public:
@@ -104,55 +37,67 @@ public:
         void perform_ordering(std::vector<NodeID> &labels);
 
 private:
-        graph_access * const graph;
-
-        // Nodes that haven't been eliminated
-        // This is mainly used to eliminate nodes that are only members of one clique
-        std::unordered_set<NodeID> current_nodes;
-
-        // This "clique" tracks all neighbors of eliminated nodes that are still in the graph
-        // It's not actually a clique, but the clique-class is useful here
-        clique elimination_neighbors;
+        typedef std::int64_t amd_int;
 
-        // Priority queue to store node degrees
-        maxNodeHeap degree_pq;
+        enum node_status { VARIABLE, ELEMENT, DEAD };
 
-        // Cliques used to represent the graph. Cliques never get deleted,
-        // but cliques that aren't used are referenced in the memberships vector
-        std::vector<clique> cliques;
-        // For each node, memberships stores the indices of cliques the node belongs to
-        std::vector<std::vector<size_t>> memberships;
-
-        // For each node, store a link to an indistinguishable node it represents, or itself.
-        std::vector<NodeID> node_links;
-        // Sum of the weights of indistinguishable nodes, per representative
-        std::vector<NodeWeight> link_weights;
-        std::vector<NodeID> new_indistinguishable_nodes;
+        graph_access * const graph;
+        amd_int n;
+        // total node weight, weight of the eliminated nodes and largest element so far
+        amd_int total_weight;
+        amd_int nel;
+        amd_int lemax;
+
+        // Workspace: adjacency lists of variables and elements.
+        // The list of variable i is iw[pe[i], pe[i]+len[i]), its first elen[i] entries are elements.
+        // The list of element e is iw[pe[e], pe[e]+len[e]) and contains only variables.
+        std::vector<amd_int> iw;
+        amd_int pfree;
+        std::vector<amd_int> pe;
+        std::vector<amd_int> len;
+        std::vector<amd_int> elen;
+        std::vector<char> status;
+
+        // Weight of a supervariable, 0 for non-principal variables, negative while in the current element.
+        std::vector<amd_int> nv;
+        // Approximate external degree of a variable, weighted size of an element
+        std::vector<amd_int> degree;
+        // Marker array: w[e] - wflg = |Le \ Lme| during the degree update, w[e] == 0 for absorbed elements
+        std::vector<amd_int> w;
+        amd_int wflg;
+
+        // Degree lists. While a variable is in the current element, 'next' and 'last' hold
+        // the hash bucket chain and the hash value instead.
+        std::vector<amd_int> head;
+        std::vector<amd_int> next;
+        std::vector<amd_int> last;
+        std::vector<amd_int> hash_head;
+        amd_int mindeg;
+
+        // For each principal variable the nodes it represents, linked via chain_next.
+        std::vector<amd_int> chain_next;
+        std::vector<amd_int> chain_tail;
 
         std::vector<bool> is_halo_node;
 
-        // Compute the initial adjusted degrees for the given graph
-        void initialize_degrees();
-        // Create the initial clique cover
-        void initialize_cliques();
+        // Set up the workspace and the initial degree lists
+        void initialize();
+
+        void insert_degree_list(amd_int i, amd_int deg);
+        void remove_degree_list(amd_int i);
 
-        // Eliminate a node
-        // This merges all cliques containing node
-        // Returns the index of the merged clique
-        size_t eliminate_node(NodeID node);
+        // Reset the marker array if wflg becomes too large
+        void clear_flag();
 
-        // update node degrees of neighbors of the eliminated node.
-        // All these neighbors are in the merged clique.
-        // This also detects indistinguishable nodes and stores them in new_indistinguishable_nodes.
-        void update_node_degrees(NodeID eliminatedNode, size_t merged_clique_idx);
+        // Compact the live lists to the front of 'iw' and make room for 'needed' more entries
+        void compress_workspace(amd_int needed);
 
-        // Taking the nodes found to be indistinguishable ('new_indistinguishable_nodes'),
-        // update the vectors 'node_links' and 'link_weights',
-        // and remove the nodes from the relevant sets.
-        void update_indistinguishable_nodes();
+        // Eliminate the variable 'me' and build the new element. Variables that
+        // are eliminated together with 'me' are appended to 'eliminated'.
+        void eliminate_node(amd_int me, std::vector<amd_int> &eliminated);
 
-        // Label the given node and all its indistinguishable nodes
-        void label_node(NodeID node, std::vector<NodeID> &labels, NodeID &order);
+        // Label the given node and all nodes it represents
+        void label_node(amd_int node, std::vector<NodeID> &labels, NodeID &order);
 
 };
 
@@ -4,12 +4,14 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <utility>
 #include <vector>
 
 #include "balance_configuration.h"
 #include "node_ordering/min_degree_ordering.h"
 #include "node_ordering/nested_dissection.h"
+#include "node_ordering/ordering_tools.h"
 #include "node_ordering/reductions.h"
 #include "partition/graph_partitioner.h"
 #include "partition/uncoarsening/separator/area_bfs.h"
@@ -26,6 +28,35 @@ nested_dissection::nested_dissection(graph_access * const G, int recursion_level
 
 
 void nested_dissection::perform_nested_dissection(PartitionConfig &config) {
+        if (m_recursion_level == 0 && config.dissection_auto_rec_limit) {
+                choose_rec_limit(config);
+        } else {
+                dissect(config);
+        }
+}
+
+void nested_dissection::choose_rec_limit(PartitionConfig &config) {
+        const unsigned int base_limit = config.dissection_rec_limit;
+        double best_flops = std::numeric_limits<double>::max();
+        for (double factor: {0.5, 1.0, 2.0, 4.0}) {
+                PartitionConfig candidate_config = config;
+                candidate_config.dissection_rec_limit = std::max(1u, (unsigned int)(factor * base_limit));
+
+                nested_dissection candidate(original_graph, m_recursion_level);
+                candidate.dissect(candidate_config);
+                // Compare the orderings by the cost of the factorization, not only the fill
+                double flops = symbolic_factorization(*original_graph, candidate.m_label).flops;
+                std::cout << "dissection_rec_limit " << candidate_config.dissection_rec_limit
+                          << " factorization flops " << flops << std::endl;
+                if (flops < best_flops) {
+                        best_flops = flops;
+                        config.dissection_rec_limit = candidate_config.dissection_rec_limit;
+                        m_label.swap(candidate.m_label);
+                }
+        }
+}
+
+void nested_dissection::dissect(PartitionConfig &config) {
         if (original_graph->number_of_nodes() == 0) {
                 return;
         }
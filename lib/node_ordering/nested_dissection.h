@@ -43,6 +43,13 @@ private:
 
         std::vector<std::unique_ptr<Reduction>> m_reduction_stack;
 
+        // Perform nested dissection with the recursion limit given in config
+        void dissect(PartitionConfig &config);
+
+        // Perform nested dissection for multiples of config.dissection_rec_limit and keep the
+        // ordering with the least factorization flops. config.dissection_rec_limit is set to the best limit.
+        void choose_rec_limit(PartitionConfig &config);
+
         // Compute a separator of the graph G
         void compute_separator(PartitionConfig &config, graph_access &G);
 
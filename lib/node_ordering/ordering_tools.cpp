@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <fstream>
+#include <limits>
 #include <numeric>
 #include <queue>
 #include <unordered_map>
@@ -84,3 +86,186 @@ Count compute_fill(graph_access &graph, const std::vector<NodeID> &ordering) {
         }
         return fill_edge_count - edge_count;
 }
+
+// Sum of the squares 1^2 + ... + x^2
+static double sum_of_squares(double x) {
+        return x * (x + 1) * (2 * x + 1) / 6;
+}
+
+// The elimination tree is computed with Liu's algorithm using path compression, the column counts with
+// Gilbert et al. "An Efficient Algorithm to Compute Row and Column Counts for Sparse Cholesky Factorization",
+// SIAM J. Matrix Anal. Appl., Vol. 15, No. 4, 1994 (GNP94).
+// All arrays are indexed by the position of a node in the ordering.
+factorization_statistics symbolic_factorization(graph_access &graph, const std::vector<NodeID> &ordering) {
+        const NodeID n = graph.number_of_nodes();
+        const NodeID none = std::numeric_limits<NodeID>::max();
+        factorization_statistics stats = {0, 0, 0.0, 0};
+        if (n == 0) {
+                return stats;
+        }
+
+        std::vector<NodeID> node_at(n);
+        std::vector<NodeWeight> weight(n);
+        forall_nodes(graph, node) {
+                node_at[ordering[node]] = node;
+                weight[ordering[node]] = graph.getNodeWeight(node);
+        } endfor
+
+        // Elimination tree: the parent of j is the first row below the diagonal in column j of L
+        std::vector<NodeID> parent(n, none);
+        std::vector<NodeID> ancestor(n, none);
+        for (NodeID k = 0; k < n; ++k) {
+                forall_out_edges(graph, edge, node_at[k]) {
+                        NodeID i = ordering[graph.getEdgeTarget(edge)];
+                        // climb to the root of the subtree containing i, pointing the path to k
+                        while (i != none && i < k) {
+                                NodeID next = ancestor[i];
+                                ancestor[i] = k;
+                                if (next == none) {
+                                        parent[i] = k;
+                                }
+                                i = next;
+                        }
+                } endfor
+        }
+
+        // Parents are ordered after their children, so depths are computed from the roots downwards
+        std::vector<NodeID> depth(n, 1);
+        for (NodeID j = n; j-- > 0; ) {
+                if (parent[j] != none) {
+                        depth[j] = depth[parent[j]] + 1;
+                }
+                stats.etree_height = std::max(stats.etree_height, depth[j]);
+        }
+
+        // Postorder of the elimination tree
+        std::vector<NodeID> first_child(n, none);
+        std::vector<NodeID> next_sibling(n, none);
+        for (NodeID j = n; j-- > 0; ) {
+                if (parent[j] != none) {
+                        next_sibling[j] = first_child[parent[j]];
+                        first_child[parent[j]] = j;
+                }
+        }
+        std::vector<NodeID> post;
+        post.reserve(n);
+        std::vector<NodeID> stack;
+        for (NodeID root = 0; root < n; ++root) {
+                if (parent[root] != none) {
+                        continue;
+                }
+                stack.push_back(root);
+                while (!stack.empty()) {
+                        NodeID j = stack.back();
+                        NodeID child = first_child[j];
+                        if (child == none) {
+                                stack.pop_back();
+                                post.push_back(j);
+                        } else {
+                                first_child[j] = next_sibling[child];
+                                stack.push_back(child);
+                        }
+                }
+        }
+
+        // Column counts. Row i of L is the row subtree of i in the elimination tree.
+        // Every row adds its weight at the leaves of its row subtree and subtracts it again
+        // at the least common ancestors of consecutive leaves and above its root.
+        // The weighted count of column j is then the sum of 'delta' over the subtree of j.
+        std::vector<NodeID> first(n, none);         // first descendant of j in postorder
+        std::vector<NodeID> max_first(n, none);     // largest first[j] of a leaf seen in row subtree i
+        std::vector<NodeID> prev_leaf(n, none);     // previous leaf of row subtree i
+        std::vector<int64_t> delta(n, 0);
+        for (NodeID k = 0; k < n; ++k) {
+                NodeID j = post[k];
+                if (first[j] == none) {
+                        // j is a leaf of the elimination tree
+                        delta[j] = weight[j];
+                }
+                for (; j != none && first[j] == none; j = parent[j]) {
+                        first[j] = k;
+                }
+        }
+
+        for (NodeID j = 0; j < n; ++j) {
+                ancestor[j] = j;
+        }
+        for (NodeID k = 0; k < n; ++k) {
+                NodeID j = post[k];
+                if (parent[j] != none) {
+                        delta[parent[j]] -= weight[j];
+                }
+                forall_out_edges(graph, edge, node_at[j]) {
+                        NodeID i = ordering[graph.getEdgeTarget(edge)];
+                        if (i <= j || (max_first[i] != none && first[j] <= max_first[i])) {
+                                // j is not a leaf of the row subtree of i
+                                continue;
+                        }
+                        max_first[i] = first[j];
+                        NodeID prev = prev_leaf[i];
+                        prev_leaf[i] = j;
+                        delta[j] += weight[i];
+                        if (prev != none) {
+                                // row i was counted twice above the least common ancestor of prev and j
+                                NodeID lca = prev;
+                                while (lca != ancestor[lca]) {
+                                        lca = ancestor[lca];
+                                }
+                                for (NodeID s = prev; s != lca; ) {
+                                        NodeID s_parent = ancestor[s];
+                                        ancestor[s] = lca;
+                                        s = s_parent;
+                                }
+                                delta[lca] -= weight[i];
+                        }
+                } endfor
+                if (parent[j] != none) {
+                        ancestor[j] = parent[j];
+                }
+        }
+        for (NodeID j = 0; j < n; ++j) {
+                if (parent[j] != none) {
+                        delta[parent[j]] += delta[j];
+                }
+        }
+
+        // A node of weight w stands for w columns, the t-th of which has t rows less than the first
+        uint64_t matrix_entries = 0;
+        for (NodeID j = 0; j < n; ++j) {
+                uint64_t count = delta[j];
+                uint64_t w = weight[j];
+                stats.nonzeros += w * count - w * (w - 1) / 2;
+                stats.flops += sum_of_squares(count) - sum_of_squares(count - w);
+                matrix_entries += w * (w + 1) / 2;
+                forall_out_edges(graph, edge, node_at[j]) {
+                        if (ordering[graph.getEdgeTarget(edge)] > j) {
+                                matrix_entries += w * graph.getNodeWeight(graph.getEdgeTarget(edge));
+                        }
+                } endfor
+        }
+        stats.fill = stats.nonzeros - matrix_entries;
+        return stats;
+}
+
+bool read_ordering(const std::string &filename, std::vector<NodeID> &ordering) {
+        std::ifstream in(filename.c_str());
+        if (!in) {
+                return false;
+        }
+        NodeID n = 0;
+        if (!(in >> n)) {
+                return false;
+        }
+        ordering.assign(n, std::numeric_limits<NodeID>::max());
+        std::vector<bool> used(n, false);
+        for (NodeID line = 0; line < n; ++line) {
+                NodeID node, label;
+                if (!(in >> node >> label) || node < 1 || node > n || label < 1 || label > n || used[label - 1] ||
+                    ordering[node - 1] != std::numeric_limits<NodeID>::max()) {
+                        return false;
+                }
+                ordering[node - 1] = label - 1;
+                used[label - 1] = true;
+        }
+        return true;
+}
@@ -5,10 +5,14 @@
 #ifndef ORDERING_TOOLS_H
 #define ORDERING_TOOLS_H
 
+#include <algorithm>
 #include <iosfwd>
+#include <omp.h>
+#include <string>
 #include <vector>
 
 #include "definitions.h"
+#include "tools/parallel_sort.h"
 
 // Print the ordering given by 'labels' to the stream 'out' in the format used by scotch:
 // the first line contains the number of nodes, each of the following lines contains
@@ -22,4 +26,22 @@ NodeWeight compute_reachable_set_size(graph_access &graph, NodeID node);
 // Compute the number of fill-edges of the given ordering
 Count compute_fill(graph_access &graph, const std::vector<NodeID> &ordering);
 
+// Size of the Cholesky factor L of a matrix with the sparsity pattern of a graph
+struct factorization_statistics {
+        uint64_t nonzeros;      // nonzeros of L, including the diagonal
+        uint64_t fill;          // nonzeros of L that are not in the lower triangle of the matrix (fill-edges)
+        double flops;           // floating point operations of the numerical factorization
+        NodeID etree_height;    // height of the elimination tree, the length of the critical path
+};
+
+// Symbolic factorization of 'graph' eliminated in the order given by 'ordering'.
+// Computes the elimination tree and the column counts of L in near-linear time,
+// without building the filled graph. A node of weight w is treated as w
+// indistinguishable columns, so orderings of reduced graphs can be compared as well.
+factorization_statistics symbolic_factorization(graph_access &graph, const std::vector<NodeID> &ordering);
+
+// Read an ordering in the format written by 'print_ordering'.
+// Returns false if the file could not be read or does not contain a permutation.
+bool read_ordering(const std::string &filename, std::vector<NodeID> &ordering);
+
 #endif /* ORDERING_TOOLS_H */
@@ -5,7 +5,10 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <omp.h>
 #include <queue>
 #include <unordered_set>
 #include <utility>
@@ -32,50 +35,81 @@
 void contract_nodes(graph_access &graph_before, graph_access &graph_after,
                     const std::vector<std::vector<NodeID>> &node_groups,
                     std::unordered_map<NodeID, std::vector<NodeID>> &mapping) {
-        graph_after.start_construction(node_groups.size(), graph_before.number_of_edges());
+        const NodeID num_groups = node_groups.size();
 
         std::vector<NodeID> reverse_map(graph_before.number_of_nodes(), 0);
-        for (const auto &group: node_groups) {
-                auto new_node_id = graph_after.new_node();
-                NodeWeight weight = 0;
-                NodeWeight offset = 0;
-                for (auto old_node_id: group) {
-                        reverse_map[old_node_id] = new_node_id;
-                        weight += graph_before.getNodeWeight(old_node_id);
-                        offset += graph_before.get_contraction_offset(old_node_id);
-                }
-                graph_after.setNodeWeight(new_node_id, weight);
-                graph_after.set_contraction_offset(new_node_id, offset);
-                mapping.insert({new_node_id, group});
+        std::vector<NodeWeight> weights(num_groups, 0);
+        std::vector<NodeWeight> offsets(num_groups, 0);
+        // Each group gets room for the sum of the degrees of its nodes in 'targets'
+        std::vector<EdgeID> group_begin(num_groups + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (long long group_id = 0; group_id < (long long)num_groups; ++group_id) {
+                EdgeID degree_sum = 0;
+                for (auto old_node_id: node_groups[group_id]) {
+                        reverse_map[old_node_id] = group_id;
+                        weights[group_id] += graph_before.getNodeWeight(old_node_id);
+                        offsets[group_id] += graph_before.get_contraction_offset(old_node_id);
+                        degree_sum += graph_before.getNodeDegree(old_node_id);
+                }
+                group_begin[group_id + 1] = degree_sum;
         }
-
-        std::vector<NodeID> visited_by(graph_before.number_of_nodes(), -1); // assuming that there are less than 2^32-1 nodes
-        std::vector<EdgeID> target_edges(graph_before.number_of_nodes(), -1); // new_edge_ids for a target
-        for (NodeID contracted_node_id = 0; contracted_node_id < node_groups.size(); ++contracted_node_id) {
-                const auto &group = node_groups[contracted_node_id];
-                // All out-edges from each node in the group are potential edges in the reduced graph
-                for (auto node: group) {
-                        forall_out_edges(graph_before, edge, node) {
-                                auto target = graph_before.getEdgeTarget(edge);
-                                // don't add edges between contracted nodes
-                                if (reverse_map[target] != contracted_node_id) {
-                                        if (visited_by[reverse_map[target]] != contracted_node_id) {
+        std::partial_sum(group_begin.begin(), group_begin.end(), group_begin.begin());
+
+        // Collect the edges of each contracted node independently, merging parallel edges.
+        // Every thread uses its own marker arrays.
+        std::vector<NodeID> targets(group_begin[num_groups]);
+        std::vector<EdgeWeight> target_weights(group_begin[num_groups]);
+        std::vector<EdgeID> group_degree(num_groups, 0);
+        #pragma omp parallel
+        {
+                std::vector<NodeID> visited_by(num_groups, std::numeric_limits<NodeID>::max());
+                std::vector<EdgeID> target_edges(num_groups, 0); // position of the edge to a target
+                #pragma omp for schedule(dynamic, 1024)
+                for (long long group_id = 0; group_id < (long long)num_groups; ++group_id) {
+                        const NodeID contracted_node_id = group_id;
+                        EdgeID pos = group_begin[contracted_node_id];
+                        // All out-edges from each node in the group are potential edges in the reduced graph
+                        for (auto node: node_groups[contracted_node_id]) {
+                                forall_out_edges(graph_before, edge, node) {
+                                        auto target = reverse_map[graph_before.getEdgeTarget(edge)];
+                                        // don't add edges between contracted nodes
+                                        if (target == contracted_node_id) {
+                                                continue;
+                                        }
+                                        if (visited_by[target] != contracted_node_id) {
                                                 // this edge hasn't been added yet
-                                                auto new_edge_id = graph_after.new_edge(contracted_node_id, reverse_map[target]);
-                                                target_edges[reverse_map[target]] = new_edge_id;
-                                                graph_after.setEdgeWeight(new_edge_id, graph_before.getEdgeWeight(edge));
-                                                visited_by[reverse_map[target]] = contracted_node_id;
+                                                visited_by[target] = contracted_node_id;
+                                                target_edges[target] = pos;
+                                                targets[pos] = target;
+                                                target_weights[pos] = graph_before.getEdgeWeight(edge);
+                                                pos++;
                                         } else {
                                                 // add to the edge weight of an existing edge
-                                                auto edge_id = target_edges[reverse_map[target]];
-                                                auto current_edge_weight = graph_after.getEdgeWeight(edge_id);
-                                                graph_after.setEdgeWeight(edge_id, current_edge_weight + graph_before.getEdgeWeight(edge));
+                                                target_weights[target_edges[target]] += graph_before.getEdgeWeight(edge);
                                         }
-                                }
-                        } endfor
+                                } endfor
+                        }
+                        group_degree[contracted_node_id] = pos - group_begin[contracted_node_id];
                 }
         }
 
+        EdgeID num_edges = 0;
+        for (NodeID contracted_node_id = 0; contracted_node_id < num_groups; ++contracted_node_id) {
+                num_edges += group_degree[contracted_node_id];
+        }
+
+        graph_after.start_construction(num_groups, num_edges);
+        for (NodeID contracted_node_id = 0; contracted_node_id < num_groups; ++contracted_node_id) {
+                auto new_node_id = graph_after.new_node();
+                graph_after.setNodeWeight(new_node_id, weights[contracted_node_id]);
+                graph_after.set_contraction_offset(new_node_id, offsets[contracted_node_id]);
+                EdgeID begin = group_begin[contracted_node_id];
+                for (EdgeID pos = begin; pos < begin + group_degree[contracted_node_id]; ++pos) {
+                        auto new_edge_id = graph_after.new_edge(new_node_id, targets[pos]);
+                        graph_after.setEdgeWeight(new_edge_id, target_weights[pos]);
+                }
+                mapping.insert({new_node_id, node_groups[contracted_node_id]});
+        }
         graph_after.finish_construction();
 }
 
@@ -288,12 +322,15 @@ size_t closed_neighborhood_hash(graph_access &graph, NodeID node) {
 }
 
 void IndistinguishableNodeReduction::apply() {
-        // Vector of hashes of closed neighborhoods
-        std::vector<size_t> hash_vector;
-        hash_vector.reserve(graph_before.number_of_nodes());
-        forall_nodes(graph_before, node) {
-                hash_vector.push_back(closed_neighborhood_hash(graph_before, node));
-        } endfor
+        // Vector of hashes of closed neighborhoods and adjusted degrees for each node
+        const long long num_nodes = graph_before.number_of_nodes();
+        std::vector<size_t> hash_vector(num_nodes);
+        std::vector<NodeWeight> degrees(num_nodes, 0);
+        #pragma omp parallel for schedule(dynamic, 4096)
+        for (long long node = 0; node < num_nodes; ++node) {
+                hash_vector[node] = closed_neighborhood_hash(graph_before, node);
+                degrees[node] = compute_reachable_set_size(graph_before, node);
+        }
 
         // Sets of indistinguishable nodes
         std::vector<std::vector<NodeID>> node_groups;
@@ -305,12 +342,6 @@ void IndistinguishableNodeReduction::apply() {
         // Set to true, if a node has been contracted
         std::vector<bool> contracted(graph_before.number_of_nodes(), false);
 
-        // Store adjusted degrees for each node
-        std::vector<NodeWeight> degrees(graph_before.number_of_nodes(), 0);
-        forall_nodes(graph_before, node) {
-                degrees[node] = compute_reachable_set_size(graph_before, node);
-        } endfor
-
         forall_nodes(graph_before, node_a) {
                 if (contracted[node_a]) {
                         continue;
@@ -355,6 +386,7 @@ void IndistinguishableNodeReduction::apply() {
         contract_nodes(graph_before, graph_after, node_groups, mapping);
 
         // Match reachable set size in reduced and original graph
+        #pragma omp parallel for schedule(dynamic, 4096)
         for (NodeID new_node_id = 0; new_node_id < node_groups.size(); ++new_node_id) {
                 if (graph_before.get_contraction_offset(node_groups[new_node_id][0]) == 0) {
                         continue;
@@ -392,78 +424,93 @@ void IndistinguishableNodeReduction::map(std::vector<NodeID> &reduced_label, std
 /*********/
 
 void TwinReduction::apply() {
-        // Vector of hashes of closed neighborhoods
-        std::vector<std::pair<size_t, NodeID>> hash_vector;
-        hash_vector.reserve(graph_before.number_of_nodes());
-        forall_nodes(graph_before, node) {
-                hash_vector.push_back({open_neighborhood_hash(graph_before, node), node});
-        } endfor
+        // Vector of hashes of open neighborhoods and adjusted degrees for each node
+        const long long num_nodes = graph_before.number_of_nodes();
+        std::vector<std::pair<size_t, NodeID>> hash_vector(num_nodes);
+        std::vector<NodeWeight> degrees(num_nodes, 0);
+        #pragma omp parallel for schedule(dynamic, 4096)
+        for (long long node = 0; node < num_nodes; ++node) {
+                hash_vector[node] = {open_neighborhood_hash(graph_before, node), node};
+                degrees[node] = compute_reachable_set_size(graph_before, node);
+        }
 
         // Sort by hash
-        std::sort(hash_vector.begin(), hash_vector.end());
-
-        // Label nodes to compare neighborhoods
-        std::vector<short> labels(graph_before.number_of_nodes(), 0);
-
-        std::vector<std::vector<NodeID>> node_groups;
-        node_groups.reserve(graph_before.number_of_nodes());
-
-        // Set to true, if a node has been contracted
-        std::vector<bool> contracted(graph_before.number_of_nodes(), false);
-
-        // Store adjusted degrees for each node
-        std::vector<NodeWeight> degrees(graph_before.number_of_nodes(), 0);
-        forall_nodes(graph_before, node) {
-                degrees[node] = compute_reachable_set_size(graph_before, node);
-        } endfor
+        parallel_sort(hash_vector);
+
+        // Runs of equal hashes. Twins always belong to the same run,
+        // so the runs are tested independently of each other.
+        std::vector<size_t> run_begin;
+        for (size_t i = 0; i < hash_vector.size(); ++i) {
+                if (i == 0 || hash_vector[i].first != hash_vector[i - 1].first) {
+                        run_begin.push_back(i);
+                }
+        }
+        run_begin.push_back(hash_vector.size());
+        const long long num_runs = run_begin.size() - 1;
+
+        // Set to true, if a node has been contracted (char instead of bool, threads write concurrently)
+        std::vector<char> contracted(num_nodes, false);
+        std::vector<std::vector<std::vector<NodeID>>> run_groups(num_runs);
+
+        #pragma omp parallel
+        {
+                // Label nodes to compare neighborhoods
+                std::vector<short> labels(num_nodes, 0);
+
+                #pragma omp for schedule(dynamic, 256)
+                for (long long run = 0; run < num_runs; ++run) {
+                        std::vector<std::vector<NodeID>> &node_groups = run_groups[run];
+                        for (size_t first = run_begin[run]; first < run_begin[run + 1]; ++first) {
+                                auto node_a = hash_vector[first].second;
+                                if (contracted[node_a]) {
+                                        continue;
+                                }
+                                node_groups.push_back({node_a});
 
-        size_t first = 0, second;
-        while (first < hash_vector.size()) {
-                auto node_a = hash_vector[first].second;
-                second = first + 1;
+                                forall_out_edges(graph_before, edge, node_a) {
+                                        labels[graph_before.getEdgeTarget(edge)] = 1;
+                                } endfor
 
-                node_groups.push_back({node_a});
+                                for (size_t second = first + 1; second < run_begin[run + 1]; ++second) {
+                                        auto node_b = hash_vector[second].second;
+                                        // ignore contracted nodes
+                                        // If neighborhoods are not equal in terms of degrees, we don't need to test
+                                        if (contracted[node_b] ||
+                                            graph_before.getNodeDegree(node_a) != graph_before.getNodeDegree(node_b) ||
+                                            degrees[node_a] != degrees[node_b]) {
+                                                continue;
+                                        }
 
-                forall_out_edges(graph_before, edge, node_a) {
-                        labels[graph_before.getEdgeTarget(edge)] = 1;
-                } endfor
+                                        EdgeWeight count = 0;
+                                        forall_out_edges(graph_before, edge_b, node_b) {
+                                                count += labels[graph_before.getEdgeTarget(edge_b)];
+                                        } endfor
+                                        if (count == graph_before.getNodeDegree(node_a) && count == graph_before.getNodeDegree(node_b)) {
+                                                node_groups.back().push_back(node_b);
+                                                contracted[node_b] = true;
+                                        }
+                                }
 
-                while (second < hash_vector.size() && hash_vector[first].first == hash_vector[second].first) {
-                        auto node_b = hash_vector[second].second;
-                        // ignore contracted nodes
-                        if (contracted[node_b]) {
-                                second++;
-                                continue;
-                        }
-                        
-                        // If neighborhoods are not equal in terms of degrees, we don't need to test
-                        if (graph_before.getNodeDegree(node_a) != graph_before.getNodeDegree(node_b) ||
-                            degrees[node_a] != degrees[node_b]) {
-                                second++;
-                                continue;
+                                forall_out_edges(graph_before, edge, node_a) {
+                                        labels[graph_before.getEdgeTarget(edge)] = 0;
+                                } endfor
                         }
+                }
+        }
 
-                        EdgeWeight count = 0;
-                        forall_out_edges(graph_before, edge_b, node_b) {
-                                count += labels[graph_before.getEdgeTarget(edge_b)];
-                        } endfor
-                        if (count == graph_before.getNodeDegree(node_a) && count == graph_before.getNodeDegree(node_b)) {
-                                node_groups.back().push_back(node_b);
-                                contracted[node_b] = true;
-                        }
-                        second++;
+        std::vector<std::vector<NodeID>> node_groups;
+        node_groups.reserve(num_nodes);
+        for (auto &groups: run_groups) {
+                for (auto &group: groups) {
+                        node_groups.push_back(std::move(group));
                 }
-                do {
-                        first++;
-                } while(first < hash_vector.size() && contracted[hash_vector[first].second]);
-                forall_out_edges(graph_before, edge, node_a) {
-                        labels[graph_before.getEdgeTarget(edge)] = 0;
-                } endfor
         }
+        std::vector<std::vector<std::vector<NodeID>>>().swap(run_groups);
 
         contract_nodes(graph_before, graph_after, node_groups, mapping);
 
         // Match reachable set size in reduced and original graph
+        #pragma omp parallel for schedule(dynamic, 4096)
         for (NodeID new_node_id = 0; new_node_id < node_groups.size(); ++new_node_id) {
                 auto reach = degrees[node_groups[new_node_id][0]];
                 auto new_reach_without_offset = graph_after.getNodeWeight(new_node_id) - 1;
@@ -910,10 +957,17 @@ void apply_reductions_internal(const PartitionConfig &config,
                                                                 reduction_stack.back()->get_reduced_graph().number_of_nodes(),
                                                                 recursion_level);
 
+                        if (reduction_stack.back()->get_reduced_graph().number_of_nodes() == graph_1->number_of_nodes()) {
+                                // Nothing was removed or contracted. The reduced graph is only a copy
+                                // of graph_1, so the next reduction continues on graph_1 directly and
+                                // the copy is released instead of being kept on the stack.
+                                reduction_stack.pop_back();
+                                continue;
+                        }
                         graph_1 = &reduction_stack.back()->get_reduced_graph();       
                 }
-        } while ( (num_nodes_before - reduction_stack.back()->get_reduced_graph().number_of_nodes()) / (double)num_nodes_before >
-                                config.convergence_factor);
+        } while (num_nodes_before > 0 &&
+                 (num_nodes_before - graph_1->number_of_nodes()) / (double)num_nodes_before > config.convergence_factor);
 }
 
 bool apply_reductions(const PartitionConfig &config,
@@ -924,7 +978,7 @@ bool apply_reductions(const PartitionConfig &config,
                 return false;
         } else {
                 apply_reductions_internal(config, in_graph, reduction_stack, recursion_level);
-                return true;
+                return !reduction_stack.empty();
         }
 }
 
@@ -291,6 +291,7 @@ public:
 
 // Apply reductions to in_graph, based on the given configuration.
 // The reductions applied to the graph are stored in 'reduction_stack'.
+// Reductions that leave the graph unchanged are not stored, the next reduction works on the same graph.
 // Returns false if no reductions were applied, true otherwise.
 // 'recursion_level' is an optional parameter for recording efficiency of reductions per level of recursion.
 bool apply_reductions(const PartitionConfig &config,
@@ -5,12 +5,18 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <algorithm>
 #include <mpi.h>
 
 #include "exchanger.h"
+#include "partition_map_codec.h"
 #include "tools/quality_metrics.h"
 #include "tools/random_functions.h"
 
+// individuals exchanged via exchange_individum are split into chunks of this
+// many words so that decoding overlaps with the arrival of the remaining chunks
+const int EXCHANGE_CHUNK_WORDS = 1 << 18;
+
 exchanger::exchanger(MPI_Comm communicator) {
         m_prev_best_objective = std::numeric_limits<EdgeWeight>::max();
 
@@ -45,16 +51,23 @@ exchanger::~exchanger() {
         
         while(flag) {
                 int message_length;
-                MPI_Get_count(&st, MPI_INT, &message_length);
+                MPI_Get_count(&st, MPI_UNSIGNED, &message_length);
                  
-                int* partition_map = new int[message_length];
+                unsigned* packed_map = new unsigned[message_length];
                 MPI_Status rst;
-                MPI_Recv( partition_map, message_length, MPI_INT, st.MPI_SOURCE, rank, m_communicator, &rst); 
+                MPI_Recv( packed_map, message_length, MPI_UNSIGNED, st.MPI_SOURCE, rank, m_communicator, &rst); 
                 
-                delete[] partition_map;
+                delete[] packed_map;
                 MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, m_communicator, &flag, &st);
         }
 
+        for( unsigned i = 0; i < m_recv_requests.size(); i++) {
+                MPI_Status rst;
+                MPI_Wait( m_recv_requests[i], &rst );
+                delete[] m_recv_buffers[i];
+                delete   m_recv_requests[i];
+        }
+
         MPI_Barrier( m_communicator );
         for( unsigned i = 0; i < m_request_pointers.size(); i++) {
                 MPI_Cancel( m_request_pointers[i] );
@@ -144,14 +157,45 @@ void exchanger::exchange_individum( const PartitionConfig & config,  graph_acces
                                     Individuum & in, Individuum & out) {
         //recv. edge cut, partition_map, cut_edges from "from"
         //send in to "to"
+        partition_map_codec codec(G.number_of_nodes(), config.k);
+
+        std::vector< unsigned > send_buffer;
+        codec.encode( in.partition_map, send_buffer );
+        std::vector< unsigned > recv_buffer( codec.packed_words() );
 
         int* partition_map = new int[G.number_of_nodes()];
         out.partition_map  = partition_map;
         out.cut_edges      = new std::vector<EdgeID>();
 
-        MPI_Status st;
-        MPI_Sendrecv( in.partition_map , G.number_of_nodes(), MPI_INT, to, 0, 
-                      out.partition_map, G.number_of_nodes(), MPI_INT, from, 0, m_communicator, &st); 
+        int words      = codec.packed_words();
+        int num_chunks = std::max(1, (words + EXCHANGE_CHUNK_WORDS - 1) / EXCHANGE_CHUNK_WORDS);
+
+        std::vector< MPI_Request > recv_requests(num_chunks);
+        std::vector< MPI_Request > send_requests(num_chunks);
+        for( int chunk = 0; chunk < num_chunks; chunk++) {
+                int begin  = chunk * EXCHANGE_CHUNK_WORDS;
+                int length = std::min(EXCHANGE_CHUNK_WORDS, words - begin);
+                MPI_Irecv( recv_buffer.data() + begin, length, MPI_UNSIGNED, from, 0, m_communicator, &recv_requests[chunk]);
+                MPI_Isend( send_buffer.data() + begin, length, MPI_UNSIGNED, to,   0, m_communicator, &send_requests[chunk]);
+        }
+
+        // chunks from the same source are matched in order, decode them as they arrive
+        partition_map_codec::stream_decoder decoder(codec, partition_map);
+        for( int chunk = 0; chunk < num_chunks; chunk++) {
+                MPI_Status st;
+                MPI_Wait( &recv_requests[chunk], &st );
+
+                int begin  = chunk * EXCHANGE_CHUNK_WORDS;
+                int length = std::min(EXCHANGE_CHUNK_WORDS, words - begin);
+                decoder.consume( recv_buffer.data(), begin, begin + length);
+        }
+        MPI_Waitall( num_chunks, send_requests.data(), MPI_STATUSES_IGNORE );
+
+        finish_individuum( config, G, out );
+}
+
+void exchanger::finish_individuum( const PartitionConfig & config, graph_access & G, Individuum & out ) {
+        int* partition_map = out.partition_map;
 
         //recompute cut edges and edge cut locally
         forall_nodes(G, node) {
@@ -208,6 +252,14 @@ void exchanger::push_best( PartitionConfig & config, graph_access & G, populatio
                         partition_map[node] = G.getPartitionIndex(node);
                 } endfor
 
+                partition_map_codec codec(G.number_of_nodes(), config.k);
+                std::vector< unsigned > packed;
+                codec.encode( partition_map, packed );
+                delete[] partition_map;
+
+                unsigned* packed_map = new unsigned[codec.packed_words()];
+                std::copy( packed.begin(), packed.end(), packed_map );
+
                 int target = rank;
                 while( m_allready_send_to[target] ) {
                         //while (target == rank) { // m_allready_send_to[rank] always true
@@ -216,12 +268,12 @@ void exchanger::push_best( PartitionConfig & config, graph_access & G, populatio
                 }
 
                 MPI_Request* rq = new MPI_Request;
-                MPI_Isend( partition_map, G.number_of_nodes(), MPI_INT, target, target, m_communicator, rq);
+                MPI_Isend( packed_map, codec.packed_words(), MPI_UNSIGNED, target, target, m_communicator, rq);
                 
                 m_cur_num_pushes++;
 
                 m_request_pointers.push_back( rq );
-                m_partition_map_buffers.push_back( partition_map );
+                m_partition_map_buffers.push_back( packed_map );
 
                 m_allready_send_to[target] = true;
         }
@@ -248,29 +300,54 @@ void exchanger::recv_incoming( PartitionConfig & config, graph_access & G, popul
         int rank;
         MPI_Comm_rank( m_communicator, &rank);
         
-        int flag; MPI_Status st;
-        MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, m_communicator, &flag, &st);
+        // post non-blocking receives for everything that has arrived so far
+        int flag; MPI_Status st; MPI_Message msg;
+        MPI_Improbe(MPI_ANY_SOURCE, rank, m_communicator, &flag, &msg, &st);
         
         while(flag) {
+                int message_length;
+                MPI_Get_count(&st, MPI_UNSIGNED, &message_length);
+
+                unsigned* packed_map = new unsigned[message_length];
+                MPI_Request* rq      = new MPI_Request;
+                MPI_Imrecv( packed_map, message_length, MPI_UNSIGNED, &msg, rq);
+
+                m_recv_buffers.push_back( packed_map );
+                m_recv_requests.push_back( rq );
+                m_recv_sources.push_back( st.MPI_SOURCE );
+
+                MPI_Improbe(MPI_ANY_SOURCE, rank, m_communicator, &flag, &msg, &st);
+        }
+
+        // decode and insert all individuals whose transfer has completed 
+        partition_map_codec codec(G.number_of_nodes(), config.k);
+        for( unsigned i = 0; i < m_recv_requests.size(); ) {
+                int finished = 0;
+                MPI_Status rst;
+                MPI_Test( m_recv_requests[i], &finished, &rst);
+
+                if(!finished) {
+                        i++;
+                        continue;
+                }
+
                 Individuum out;
-                int* partition_map = new int[G.number_of_nodes()];
-                out.partition_map  = partition_map;
+                out.partition_map  = new int[G.number_of_nodes()];
                 out.cut_edges      = new std::vector<EdgeID>();
+                codec.decode( m_recv_buffers[i], out.partition_map );
 
-                MPI_Status rst;
-                MPI_Recv( out.partition_map, G.number_of_nodes(), MPI_INT, st.MPI_SOURCE, rank, m_communicator, &rst); 
-                
-                //recompute cut edges and edge cut locally
-                forall_nodes(G, node) {
-                        forall_out_edges(G, e, node) {
-                                NodeID target = G.getEdgeTarget(e);
-                                if(partition_map[node] != partition_map[target]) {
-                                        out.cut_edges->push_back(e);
-                                }
-                        } endfor
-                } endfor
+                int source = m_recv_sources[i];
+                delete[] m_recv_buffers[i];
+                delete   m_recv_requests[i];
+
+                m_recv_buffers[i]  = m_recv_buffers.back();
+                m_recv_requests[i] = m_recv_requests.back();
+                m_recv_sources[i]  = m_recv_sources.back();
+                m_recv_buffers.pop_back();
+                m_recv_requests.pop_back();
+                m_recv_sources.pop_back();
 
-                out.objective = m_qm.objective(config, G, partition_map);
+                finish_individuum( config, G, out );
                 island.insert( G, out );
 
                 if( (unsigned)out.objective < (unsigned)m_prev_best_objective) {
@@ -279,17 +356,14 @@ void exchanger::recv_incoming( PartitionConfig & config, graph_access & G, popul
                                   <<   ": pool improved (inc) **************************************** " 
                                   <<  out.objective << std::endl;
 
-                        for( unsigned i = 0; i < m_allready_send_to.size(); i++) {
-                                m_allready_send_to[i] = false;
+                        for( unsigned j = 0; j < m_allready_send_to.size(); j++) {
+                                m_allready_send_to[j] = false;
                         }
 
                         m_allready_send_to[rank] = true;
                         m_cur_num_pushes         = 0;
                 }
 
-                m_allready_send_to[st.MPI_SOURCE] = true; // we dont need to send it back - saves us P * 1 messages of length n
-
-                MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, m_communicator, &flag, &st);
+                m_allready_send_to[source] = true; // we dont need to send it back - saves us P * 1 messages of length n
         }
 }
-
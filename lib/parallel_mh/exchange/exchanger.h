@@ -33,8 +33,16 @@ private:
                                 int & to, 
                                 Individuum & in, Individuum & out);
 
-        std::vector< int* >          m_partition_map_buffers;
+        void finish_individuum( const PartitionConfig & config, graph_access & G, Individuum & out );
+
+        // outgoing packed partition maps
+        std::vector< unsigned* >     m_partition_map_buffers;
         std::vector< MPI_Request* > m_request_pointers;
+
+        // incoming packed partition maps that are still in flight
+        std::vector< unsigned* >     m_recv_buffers;
+        std::vector< MPI_Request* > m_recv_requests;
+        std::vector< int >           m_recv_sources;
         std::vector<bool>            m_allready_send_to;
 
         int m_prev_best_objective;
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * partition_map_codec.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef PARTITION_MAP_CODEC_4RZC8W1E
+#define PARTITION_MAP_CODEC_4RZC8W1E
+
+#include <stdint.h>
+#include <vector>
+
+#include "definitions.h"
+
+// packs a partition map into ceil(log2 k) bits per node so that individuals
+// can be exchanged between islands as a short array of MPI_UNSIGNED words
+class partition_map_codec {
+public:
+        partition_map_codec( NodeID number_of_nodes, PartitionID k ) : m_number_of_nodes(number_of_nodes) {
+                m_bits_per_node = 1;
+                while( m_bits_per_node < 32 && ((uint64_t)1 << m_bits_per_node) < (uint64_t)k ) {
+                        m_bits_per_node++;
+                }
+                m_mask         = m_bits_per_node == 32 ? 0xFFFFFFFFu : (((uint32_t)1 << m_bits_per_node) - 1);
+                m_packed_words = (int)(((uint64_t)m_number_of_nodes * m_bits_per_node + 31) / 32);
+        };
+
+        virtual ~partition_map_codec() {};
+
+        int packed_words() const { return m_packed_words; }
+        unsigned bits_per_node() const { return m_bits_per_node; }
+
+        void encode( const int* partition_map, std::vector< unsigned > & buffer ) const {
+                buffer.assign(m_packed_words, 0);
+
+                uint64_t accumulator = 0;
+                unsigned filled      = 0;
+                int      word        = 0;
+                for( NodeID node = 0; node < m_number_of_nodes; node++) {
+                        accumulator |= (uint64_t)((uint32_t)partition_map[node] & m_mask) << filled;
+                        filled      += m_bits_per_node;
+                        if( filled >= 32 ) {
+                                buffer[word++] = (uint32_t)accumulator;
+                                accumulator  >>= 32;
+                                filled        -= 32;
+                        }
+                }
+                if( filled > 0 ) {
+                        buffer[word] = (uint32_t)accumulator;
+                }
+        }
+
+        // decodes the words [begin_word, end_word) of a packed map and writes
+        // all nodes that are completely contained in this prefix of the message.
+        // state is kept between calls so a message can be decoded piece by piece
+        // while the remaining parts are still in flight.
+        class stream_decoder {
+        public:
+                stream_decoder( const partition_map_codec & codec, int* partition_map )
+                        : m_codec(codec), m_partition_map(partition_map),
+                          m_accumulator(0), m_filled(0), m_next_node(0) {};
+
+                void consume( const unsigned* words, int begin_word, int end_word ) {
+                        const unsigned bits = m_codec.m_bits_per_node;
+                        for( int word = begin_word; word < end_word; word++) {
+                                m_accumulator |= (uint64_t)words[word] << m_filled;
+                                m_filled      += 32;
+                                while( m_filled >= bits && m_next_node < m_codec.m_number_of_nodes ) {
+                                        m_partition_map[m_next_node++] = (int)(m_accumulator & m_codec.m_mask);
+                                        m_accumulator >>= bits;
+                                        m_filled       -= bits;
+                                }
+                        }
+                }
+
+                bool finished() const { return m_next_node == m_codec.m_number_of_nodes; }
+
+        private:
+                const partition_map_codec & m_codec;
+                int*     m_partition_map;
+                uint64_t m_accumulator;
+                unsigned m_filled;
+                NodeID   m_next_node;
+        };
+
+        void decode( const unsigned* buffer, int* partition_map ) const {
+                stream_decoder decoder(*this, partition_map);
+                decoder.consume(buffer, 0, m_packed_words);
+        }
+
+private:
+        NodeID   m_number_of_nodes;
+        unsigned m_bits_per_node;
+        uint32_t m_mask;
+        int      m_packed_words;
+};
+
+
+#endif /* end of include guard: PARTITION_MAP_CODEC_4RZC8W1E */
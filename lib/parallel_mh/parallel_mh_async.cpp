@@ -18,6 +18,7 @@
 #include "graph_io.h"
 #include "graph_partitioner.h"
 #include "parallel_mh_async.h"
+#include "population_checkpoint.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
 
@@ -55,7 +56,35 @@ void parallel_mh_async::perform_partitioning(const PartitionConfig & partition_c
         random_functions::setSeed(partition_config.seed*m_size+m_rank);
 
         PartitionConfig ini_working_config  = partition_config; 
-        initialize( ini_working_config, G);
+        population_checkpoint checkpoint(partition_config, m_rank);
+
+        // resume only if every island read its complete checkpoint, otherwise start from scratch.
+        // the individuals are inserted only after all islands agreed
+        int resumed = 0;
+        if( partition_config.mh_resume ) {
+                unsigned pool_size = 0;
+                std::vector< Individuum > individuals;
+                int local_resumed  = checkpoint.resume( ini_working_config, G, individuals, pool_size ) ? 1 : 0;
+                MPI_Allreduce(&local_resumed, &resumed, 1, MPI_INT, MPI_MIN, m_communicator);
+
+                if( resumed ) {
+                        m_island->set_pool_size(pool_size);
+                        for( unsigned i = 0; i < individuals.size(); i++) {
+                                m_island->insert( G, individuals[i] );
+                        }
+
+                        ini_working_config.mh_pool_size = pool_size;
+                        if( m_rank == ROOT ) {
+                                std::cout <<  "resumed islands from checkpoints in " << partition_config.mh_checkpoint_dir << std::endl;
+                        }
+                } else {
+                        population_checkpoint::release( individuals );
+                }
+        }
+
+        if( !resumed ) {
+                initialize( ini_working_config, G);
+        }
 
         m_t.restart();
         exchanger ex(m_communicator);
@@ -67,7 +96,7 @@ void parallel_mh_async::perform_partitioning(const PartitionConfig & partition_c
                         working_config.no_new_initial_partitioning = false;
 
                 working_config.mh_pool_size = ini_working_config.mh_pool_size;
-                if(m_rounds == 0 && working_config.mh_enable_quickstart) {
+                if(m_rounds == 0 && working_config.mh_enable_quickstart && !resumed) {
                         ex.quick_start( working_config, G, *m_island );
                 }
 
@@ -85,6 +114,10 @@ void parallel_mh_async::perform_partitioning(const PartitionConfig & partition_c
                         }
                 }
 
+                if( checkpoint.due(m_t.elapsed()) ) {
+                        checkpoint.write_async( working_config, G, *m_island, m_t.elapsed() );
+                }
+
                 m_rounds++;
         } while( m_t.elapsed() <= m_time_limit );
 
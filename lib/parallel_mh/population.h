@@ -73,6 +73,10 @@ class population {
                 void apply_fittest( graph_access & G, EdgeWeight & objective);
 
                 unsigned size() { return m_internal_population.size(); }
+
+                unsigned pool_size() { return m_population_size; }
+
+                const std::vector<Individuum> & individuals() const { return m_internal_population; }
                 
                 void print();
 
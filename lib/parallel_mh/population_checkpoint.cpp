@@ -0,0 +1,159 @@
+/******************************************************************************
+ * population_checkpoint.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "exchange/partition_map_codec.h"
+#include "population_checkpoint.h"
+#include "quality_metrics.h"
+
+// layout (32 bit words): magic, version, n, k, pool size, #individuals,
+// then for every individual: objective, #words, packed partition map
+const unsigned CHECKPOINT_MAGIC   = 0x4B434B50; // "KCKP"
+const unsigned CHECKPOINT_VERSION = 1;
+
+population_checkpoint::population_checkpoint( const PartitionConfig & config, int rank ) : m_writer_busy(false) {
+        m_interval        = config.mh_checkpoint_interval;
+        m_last_checkpoint = 0;
+
+        if( config.mh_checkpoint_dir != "" ) {
+                std::stringstream filename;
+                filename << config.mh_checkpoint_dir << "/island_" << rank << ".ckpt";
+                m_filename = filename.str();
+        }
+}
+
+population_checkpoint::~population_checkpoint() {
+        wait_for_writer();
+}
+
+void population_checkpoint::wait_for_writer() {
+        if( m_writer.joinable() ) {
+                m_writer.join();
+        }
+}
+
+bool population_checkpoint::due( double elapsed ) {
+        return enabled() && elapsed - m_last_checkpoint >= m_interval;
+}
+
+void population_checkpoint::write_async( const PartitionConfig & config, graph_access & G, population & island, double elapsed ) {
+        if( !enabled() || m_writer_busy.load() ) {
+                return; // try again in the next round
+        }
+        wait_for_writer(); // the thread has finished, only reclaim it
+
+        partition_map_codec codec(G.number_of_nodes(), config.k);
+        const std::vector< Individuum > & individuals = island.individuals();
+
+        std::vector< unsigned > * buffer = new std::vector< unsigned >();
+        buffer->reserve( 6 + individuals.size() * (2 + codec.packed_words()) );
+        buffer->push_back( CHECKPOINT_MAGIC );
+        buffer->push_back( CHECKPOINT_VERSION );
+        buffer->push_back( G.number_of_nodes() );
+        buffer->push_back( config.k );
+        buffer->push_back( island.pool_size() );
+        buffer->push_back( individuals.size() );
+
+        std::vector< unsigned > packed;
+        for( unsigned i = 0; i < individuals.size(); i++) {
+                codec.encode( individuals[i].partition_map, packed );
+                buffer->push_back( (unsigned)individuals[i].objective );
+                buffer->push_back( packed.size() );
+                buffer->insert( buffer->end(), packed.begin(), packed.end() );
+        }
+
+        m_last_checkpoint = elapsed;
+        m_writer_busy.store(true);
+        m_writer = std::thread( write_file, m_filename, buffer, &m_writer_busy );
+}
+
+void population_checkpoint::write_file( std::string filename, std::vector< unsigned > * buffer, std::atomic<bool> * busy ) {
+        // write to a temporary file first so that a preemption during the write
+        // leaves the previous checkpoint intact
+        std::string tmp_filename = filename + ".tmp";
+        std::ofstream f(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+        f.write( (const char*)buffer->data(), buffer->size() * sizeof(unsigned) );
+        f.close();
+
+        if( f.good() ) {
+                std::rename( tmp_filename.c_str(), filename.c_str() );
+        } else {
+                std::cout <<  "could not write checkpoint " << filename << std::endl;
+        }
+
+        delete buffer;
+        busy->store(false);
+}
+
+bool population_checkpoint::resume( const PartitionConfig & config, graph_access & G, 
+                                    std::vector< Individuum > & individuals, unsigned & pool_size ) {
+        if( !enabled() ) return false;
+
+        std::ifstream f(m_filename.c_str(), std::ios::binary);
+        if( !f ) {
+                std::cout <<  "no checkpoint found at " << m_filename << std::endl;
+                return false;
+        }
+
+        unsigned header[6];
+        f.read( (char*)header, sizeof(header) );
+        if( !f || header[0] != CHECKPOINT_MAGIC || header[1] != CHECKPOINT_VERSION
+             || header[2] != G.number_of_nodes() || header[3] != config.k ) {
+                std::cout <<  "checkpoint " << m_filename << " does not match the current instance" << std::endl;
+                return false;
+        }
+
+        pool_size = header[4];
+        unsigned num_individuals = header[5];
+
+        partition_map_codec codec(G.number_of_nodes(), config.k);
+        std::vector< unsigned > packed( codec.packed_words() );
+        quality_metrics qm;
+
+        for( unsigned i = 0; i < num_individuals; i++) {
+                // a truncated file is not used at all, the individuals read so far are dropped
+                unsigned ind_header[2];
+                f.read( (char*)ind_header, sizeof(ind_header) );
+                if( f ) f.read( (char*)packed.data(), packed.size() * sizeof(unsigned) );
+                if( !f || ind_header[1] != (unsigned)codec.packed_words() ) {
+                        std::cout <<  "checkpoint " << m_filename << " is truncated" << std::endl;
+                        release( individuals );
+                        return false;
+                }
+
+                Individuum ind;
+                ind.partition_map = new int[G.number_of_nodes()];
+                ind.cut_edges     = new std::vector<EdgeID>();
+                codec.decode( packed.data(), ind.partition_map );
+
+                forall_nodes(G, node) {
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if(ind.partition_map[node] != ind.partition_map[target]) {
+                                        ind.cut_edges->push_back(e);
+                                }
+                        } endfor
+                } endfor
+
+                ind.objective = qm.objective(config, G, ind.partition_map);
+                individuals.push_back( ind );
+        }
+
+        return num_individuals > 0;
+}
+
+void population_checkpoint::release( std::vector< Individuum > & individuals ) {
+        for( unsigned i = 0; i < individuals.size(); i++) {
+                delete[] individuals[i].partition_map;
+                delete individuals[i].cut_edges;
+        }
+        individuals.clear();
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * population_checkpoint.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef POPULATION_CHECKPOINT_Q8XK2N4D
+#define POPULATION_CHECKPOINT_Q8XK2N4D
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+#include "population.h"
+
+// writes the population of an island (objectives + bit-packed partition maps)
+// to <mh_checkpoint_dir>/island_<rank>.ckpt. the snapshot is taken by the caller,
+// the file itself is written by a background thread so that the combine/mutate
+// loop is not stalled by the file system.
+class population_checkpoint {
+public:
+        population_checkpoint( const PartitionConfig & config, int rank );
+        virtual ~population_checkpoint();
+
+        bool enabled() const { return !m_filename.empty(); }
+
+        // true if the last checkpoint is older than mh_checkpoint_interval
+        bool due( double elapsed );
+
+        // snapshot the island and hand it to the writer thread.
+        // if the previous checkpoint is still being written, nothing happens.
+        void write_async( const PartitionConfig & config, graph_access & G, population & island, double elapsed );
+
+        // reads the individuals of the checkpoint of this island, the island itself is not touched.
+        // returns false (and no individuals) if there is no complete checkpoint for this graph and k.
+        bool resume( const PartitionConfig & config, graph_access & G, 
+                     std::vector< Individuum > & individuals, unsigned & pool_size );
+
+        // frees the individuals returned by resume() that are not inserted
+        static void release( std::vector< Individuum > & individuals );
+
+private:
+        void wait_for_writer();
+        static void write_file( std::string filename, std::vector< unsigned > * buffer, std::atomic<bool> * busy );
+
+        std::string m_filename;
+        double      m_interval;
+        double      m_last_checkpoint;
+
+        std::thread       m_writer;
+        std::atomic<bool> m_writer_busy;
+};
+
+
+#endif /* end of include guard: POPULATION_CHECKPOINT_Q8XK2N4D */
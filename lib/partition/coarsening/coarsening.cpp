@@ -58,8 +58,8 @@ void coarsening::perform_coarsening(const PartitionConfig & partition_config, gr
         unsigned int level    = 0;
         bool contraction_stop = false;
         do {
-                graph_access* coarser = new graph_access();
-                coarse_mapping        = new CoarseMapping();
+                graph_access* coarser = hierarchy.new_graph();
+                coarse_mapping        = hierarchy.new_mapping();
                 Matching edge_matching;
                 NodePermutationMap permutation;
 
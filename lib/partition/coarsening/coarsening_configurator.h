@@ -13,6 +13,7 @@
 #include "definitions.h"
 #include "edge_rating/edge_ratings.h"
 #include "matching/gpa/gpa_matching.h"
+#include "matching/local_max_matching.h"
 #include "matching/random_matching.h"
 #include "clustering/size_constraint_label_propagation.h"
 #include "stop_rules/stop_rules.h"
@@ -43,6 +44,10 @@ inline void coarsening_configurator::configure_coarsening( const PartitionConfig
                         PRINT(std::cout <<  "random gpa matching"  << std::endl;)
                         *edge_matcher = new gpa_matching();
                         break;
+                case MATCHING_LOCAL_MAX:
+                        PRINT(std::cout <<  "local max matching"  << std::endl;)
+                        *edge_matcher = new local_max_matching();
+                        break;
                case CLUSTER_COARSENING:
                         PRINT(std::cout <<  "cluster_coarsening"  << std::endl;)
                         *edge_matcher = new size_constraint_label_propagation();
@@ -6,11 +6,16 @@
  *****************************************************************************/
 
 #include <math.h>
+#include <omp.h>
 
 #include "edge_ratings.h"
 #include "partition_config.h"       
 #include "random_functions.h"
 
+const unsigned ALGDIST_RESTARTS          = 3;
+const unsigned ALGDIST_LANES             = 4; // restarts padded to the width of a vector register
+const NodeID   PARALLEL_RATING_THRESHOLD = 10000;
+
 edge_ratings::edge_ratings(const PartitionConfig & _partition_config) : partition_config(_partition_config){
 
 }
@@ -98,127 +103,139 @@ void edge_ratings::rate(graph_access & G, unsigned level) {
         }
 }
 
-//simd implementation is possible
-void edge_ratings::compute_algdist(graph_access & G, std::vector<float> & dist) {
-        for( unsigned R = 0; R < 3; R++) {
-                std::vector<float> prev(G.number_of_nodes(), 0);
-                forall_nodes(G, node) {
-                        prev[node] = random_functions::nextDouble(-0.5,0.5); 
+// applies rating(node, e, target) to all edges, the nodes are distributed over the threads
+template< typename RatingFunction >
+static void rate_edges(graph_access & G, RatingFunction rating) {
+        const NodeID n = G.number_of_nodes();
+        #pragma omp parallel for schedule(dynamic, 1024) if(n > PARALLEL_RATING_THRESHOLD)
+        for( NodeID node = 0; node < n; node++) {
+                forall_out_edges(G, e, node) {
+                        G.setEdgeRating(e, rating(node, e, G.getEdgeTarget(e)));
                 } endfor
+        }
+}
 
-                std::vector<float> next(G.number_of_nodes(), 0);
-                float w = 0.5;
-
-                for( unsigned k = 0; k < 7; k++) {
-                        forall_nodes(G, node) {
-                                next[node] = 0;
-
-                                forall_out_edges(G, e, node) {
-                                        NodeID target = G.getEdgeTarget(e);
-                                        next[node] += prev[target] * G.getEdgeWeight(e);
-                                } endfor
+// the restarts run concurrently, the positions of a node in all restarts are stored
+// next to each other so that a visit of an edge updates all restarts at once
+void edge_ratings::compute_algdist_positions(graph_access & G, std::vector<float> & prev) {
+        const NodeID n = G.number_of_nodes();
+        prev.assign(ALGDIST_LANES*(size_t)n, 0);
+        for( unsigned R = 0; R < ALGDIST_RESTARTS; R++) {
+                forall_nodes(G, node) {
+                        prev[ALGDIST_LANES*(size_t)node + R] = random_functions::nextDouble(-0.5,0.5); 
+                } endfor
+        }
 
-                                float wdegree = G.getWeightedNodeDegree(node);
-                                if(wdegree > 0) {
-                                        next[node] /= (float)wdegree;
+        std::vector<float> next(ALGDIST_LANES*(size_t)n, 0);
+        float w = 0.5;
 
+        for( unsigned k = 0; k < 7; k++) {
+                #pragma omp parallel for schedule(dynamic, 1024) if(n > PARALLEL_RATING_THRESHOLD)
+                for( NodeID node = 0; node < n; node++) {
+                        float sum[ALGDIST_LANES] = {0, 0, 0, 0};
+                        EdgeWeight wdegree = 0;
+                        forall_out_edges(G, e, node) {
+                                const float * target = &prev[ALGDIST_LANES*(size_t)G.getEdgeTarget(e)];
+                                float weight = G.getEdgeWeight(e);
+                                for( unsigned R = 0; R < ALGDIST_LANES; R++) {
+                                        sum[R] += target[R] * weight;
                                 }
+                                wdegree += G.getEdgeWeight(e);
                         } endfor
 
-                        forall_nodes(G, node) {
-                                prev[node] = (1-w)*prev[node] + w*next[node];
-                        } endfor
+                        for( unsigned R = 0; R < ALGDIST_LANES; R++) {
+                                next[ALGDIST_LANES*(size_t)node + R] = wdegree > 0 ? sum[R] / (float)wdegree : sum[R];
+                        }
+                }
 
+                #pragma omp parallel for schedule(static) if(n > PARALLEL_RATING_THRESHOLD)
+                for( size_t i = 0; i < ALGDIST_LANES*(size_t)n; i++) {
+                        prev[i] = (1-w)*prev[i] + w*next[i];
                 }
+        }
+}
 
-                forall_nodes(G, node) {
-                        forall_out_edges(G, e, node) {
-                                NodeID target = G.getEdgeTarget(e);
-                                //dist[e] = max(dist[e],fabs(prev[node] - prev[target]));
-                                dist[e] += fabs(prev[node] - prev[target]) / 7.0;
-                        } endfor
-                } endfor
+inline float algdist(const std::vector<float> & position, NodeID source, NodeID target) {
+        float dist = 0;
+        for( unsigned R = 0; R < ALGDIST_RESTARTS; R++) {
+                dist += fabs(position[ALGDIST_LANES*(size_t)source + R] - position[ALGDIST_LANES*(size_t)target + R]) / 7.0;
         }
+        return dist + 0.0001;
+}
 
-        forall_nodes(G, node) {
+void edge_ratings::compute_algdist(graph_access & G, std::vector<float> & dist) {
+        std::vector<float> position;
+        compute_algdist_positions(G, position);
+
+        const NodeID n = G.number_of_nodes();
+        #pragma omp parallel for schedule(dynamic, 1024) if(n > PARALLEL_RATING_THRESHOLD)
+        for( NodeID node = 0; node < n; node++) {
                 forall_out_edges(G, e, node) {
-                        dist[e] += 0.0001;
+                        dist[e] += algdist(position, node, G.getEdgeTarget(e));
                 } endfor
-        } endfor
-
+        }
 }
 
 
 void edge_ratings::rate_expansion_star_2_algdist(graph_access & G) {
+        // the distances are computed while rating instead of being stored per edge
+        std::vector<float> position;
+        compute_algdist_positions(G, position);
 
-        std::vector<float> dist(G.number_of_edges(), 0);
-        compute_algdist(G, dist);
-
-        forall_nodes(G,n) {
+        rate_edges(G, [&](NodeID n, EdgeID e, NodeID targetNode) {
                 NodeWeight sourceWeight = G.getNodeWeight(n);
-                forall_out_edges(G, e, n) {
-                        NodeID targetNode = G.getEdgeTarget(e);
-                        NodeWeight targetWeight = G.getNodeWeight(targetNode);
-                        EdgeWeight edgeWeight = G.getEdgeWeight(e);
+                NodeWeight targetWeight = G.getNodeWeight(targetNode);
+                EdgeWeight edgeWeight = G.getEdgeWeight(e);
 
-                        EdgeRatingType rating = 1.0*edgeWeight*edgeWeight / (targetWeight*sourceWeight*dist[e]);
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+                return 1.0*edgeWeight*edgeWeight / (targetWeight*sourceWeight*algdist(position, n, targetNode));
+        });
 }
 
 
 void edge_ratings::rate_expansion_star_2(graph_access & G) {
-        forall_nodes(G,n) {
+        rate_edges(G, [&](NodeID n, EdgeID e, NodeID targetNode) {
                 NodeWeight sourceWeight = G.getNodeWeight(n);
-                forall_out_edges(G, e, n) {
-                        NodeID targetNode = G.getEdgeTarget(e);
-                        NodeWeight targetWeight = G.getNodeWeight(targetNode);
-                        EdgeWeight edgeWeight = G.getEdgeWeight(e);
+                NodeWeight targetWeight = G.getNodeWeight(targetNode);
+                EdgeWeight edgeWeight = G.getEdgeWeight(e);
 
-                        EdgeRatingType rating = 1.0*edgeWeight*edgeWeight / (targetWeight*sourceWeight);
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+                return 1.0*edgeWeight*edgeWeight / (targetWeight*sourceWeight);
+        });
 }
 
 void edge_ratings::rate_inner_outer(graph_access & G) {
-        forall_nodes(G,n) {
+        // the degrees are computed once instead of once per incident edge
+        std::vector<EdgeWeight> degree(G.number_of_nodes());
+        const NodeID n = G.number_of_nodes();
+        #pragma omp parallel for schedule(dynamic, 1024) if(n > PARALLEL_RATING_THRESHOLD)
+        for( NodeID node = 0; node < n; node++) {
 #ifndef WALSHAWMH
-                EdgeWeight sourceDegree = G.getWeightedNodeDegree(n);
+                degree[node] = G.getWeightedNodeDegree(node);
 #else
-                EdgeWeight sourceDegree = G.getNodeDegree(n);
+                degree[node] = G.getNodeDegree(node);
 #endif
-                if(sourceDegree == 0) continue;
+        }
 
-                forall_out_edges(G, e, n) {
-                        NodeID targetNode = G.getEdgeTarget(e);
-#ifndef WALSHAWMH
-                        EdgeWeight targetDegree = G.getWeightedNodeDegree(targetNode);
-#else
-                        EdgeWeight targetDegree = G.getNodeDegree(targetNode);
-#endif
-                        EdgeWeight edgeWeight = G.getEdgeWeight(e);
-                        EdgeRatingType rating = 1.0*edgeWeight/(sourceDegree+targetDegree - edgeWeight);
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+        rate_edges(G, [&](NodeID n, EdgeID e, NodeID targetNode) {
+                EdgeWeight sourceDegree = degree[n];
+                if(sourceDegree == 0) return G.getEdgeRating(e);
+
+                EdgeWeight targetDegree = degree[targetNode];
+                EdgeWeight edgeWeight = G.getEdgeWeight(e);
+                return 1.0*edgeWeight/(sourceDegree+targetDegree - edgeWeight);
+        });
 }
 
 void edge_ratings::rate_expansion_star(graph_access & G) {
-        forall_nodes(G,n) {
+        rate_edges(G, [&](NodeID n, EdgeID e, NodeID targetNode) {
                 NodeWeight sourceWeight = G.getNodeWeight(n);
-                forall_out_edges(G, e, n) {
-                        NodeID targetNode       = G.getEdgeTarget(e);
-                        NodeWeight targetWeight = G.getNodeWeight(targetNode);
-                        EdgeWeight edgeWeight   = G.getEdgeWeight(e);
+                NodeWeight targetWeight = G.getNodeWeight(targetNode);
+                EdgeWeight edgeWeight   = G.getEdgeWeight(e);
 
-                        EdgeRatingType rating = 1.0 * edgeWeight / (targetWeight*sourceWeight);
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+                return 1.0 * edgeWeight / (targetWeight*sourceWeight);
+        });
 }
 
+// sequential since the random terms have to be drawn in a fixed order
 void edge_ratings::rate_pseudogeom(graph_access & G) {
         forall_nodes(G,n) {
                 NodeWeight sourceWeight = G.getNodeWeight(n);
@@ -234,150 +251,79 @@ void edge_ratings::rate_pseudogeom(graph_access & G) {
 }
 
 void edge_ratings::rate_separator_addx(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  1.0 / (G.getNodeDegree(node) + G.getNodeDegree(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
-
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return 1.0 / (G.getNodeDegree(node) + G.getNodeDegree(target));
+        });
 }
 
 void edge_ratings::rate_separator_multx(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  pow( G.getNodeDegree(node) * G.getNodeDegree(target), -0.5);
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
-
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return pow( G.getNodeDegree(node) * G.getNodeDegree(target), -0.5);
+        });
 }
 
 void edge_ratings::rate_separator_max(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating = 1.0/std::max(G.getNodeDegree(node),G.getNodeDegree(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return 1.0/std::max(G.getNodeDegree(node),G.getNodeDegree(target));
+        });
 }
 
 void edge_ratings::rate_separator_log(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating = 1.0/log(G.getNodeDegree(node)*G.getNodeDegree(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return 1.0/log(G.getNodeDegree(node)*G.getNodeDegree(target));
+        });
 }
 
 
 void edge_ratings::rate_separator_r1(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  1.0/(G.getNodeDegree(node) * G.getNodeDegree(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return 1.0/(G.getNodeDegree(node) * G.getNodeDegree(target));
+        });
 }
 
 void edge_ratings::rate_separator_r2(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  1.0/(G.getNodeDegree(node) * G.getNodeDegree(target)*G.getNodeWeight(node)*G.getNodeWeight(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return 1.0/(G.getNodeDegree(node) * G.getNodeDegree(target)*G.getNodeWeight(node)*G.getNodeWeight(target));
+        });
 }
 
 void edge_ratings::rate_separator_r3(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  1.0/(G.getNodeDegree(node) + G.getNodeDegree(target)+G.getNodeWeight(node)+G.getNodeWeight(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
-
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return 1.0/(G.getNodeDegree(node) + G.getNodeDegree(target)+G.getNodeWeight(node)+G.getNodeWeight(target));
+        });
 }
 
 void edge_ratings::rate_separator_r4(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  ((EdgeRatingType)G.getNodeDegree(node) * G.getNodeDegree(target))/(G.getNodeWeight(node)*G.getNodeWeight(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
-
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return ((EdgeRatingType)G.getNodeDegree(node) * G.getNodeDegree(target))/(G.getNodeWeight(node)*G.getNodeWeight(target));
+        });
 }
 
 void edge_ratings::rate_separator_r5(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  ((EdgeRatingType)G.getNodeDegree(node) + G.getNodeDegree(target))/(G.getNodeWeight(node)+G.getNodeWeight(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
-
-
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return ((EdgeRatingType)G.getNodeDegree(node) + G.getNodeDegree(target))/(G.getNodeWeight(node)+G.getNodeWeight(target));
+        });
 }
 
 void edge_ratings::rate_separator_r6(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  1.0/((G.getNodeDegree(node) + G.getNodeDegree(target))*(G.getNodeWeight(node)+G.getNodeWeight(target)));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
-
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return 1.0/((G.getNodeDegree(node) + G.getNodeDegree(target))*(G.getNodeWeight(node)+G.getNodeWeight(target)));
+        });
 }
 
 void edge_ratings::rate_separator_r7(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  G.getEdgeWeight(e)*1.0/(G.getNodeDegree(node) * G.getNodeDegree(target)*G.getNodeWeight(node)*G.getNodeWeight(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return G.getEdgeWeight(e)*1.0/(G.getNodeDegree(node) * G.getNodeDegree(target)*G.getNodeWeight(node)*G.getNodeWeight(target));
+        });
 }
 
 void edge_ratings::rate_realweight(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        EdgeRatingType rating =  G.getEdgeWeight(e);
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return (EdgeRatingType)G.getEdgeWeight(e);
+        });
 }
 void edge_ratings::rate_separator_r8(graph_access & G) {
-        forall_nodes(G,node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-
-                        EdgeRatingType rating =  G.getEdgeWeight(e)*1.0*(G.getNodeDegree(node) * G.getNodeDegree(target))/(G.getNodeWeight(node)*G.getNodeWeight(target));
-                        G.setEdgeRating(e, rating);
-                } endfor
-        } endfor
+        rate_edges(G, [&](NodeID node, EdgeID e, NodeID target) {
+                return G.getEdgeWeight(e)*1.0*(G.getNodeDegree(node) * G.getNodeDegree(target))/(G.getNodeWeight(node)*G.getNodeWeight(target));
+        });
 }
-
@@ -38,6 +38,9 @@ public:
         void rate_realweight(graph_access & G);
 
 private:
+        // positions of the nodes after the relaxation sweeps of all restarts
+        void compute_algdist_positions(graph_access & G, std::vector<float> & position);
+
         const PartitionConfig & partition_config;
 };
 
@@ -12,6 +12,7 @@
 #include "gpa_matching.h"
 #include "macros_assertions.h"
 #include "random_functions.h"
+#include "tools/parallel_sort.h"
 
 gpa_matching::gpa_matching() {
 
@@ -40,14 +41,28 @@ void gpa_matching::match(const PartitionConfig & partition_config,
         init(G, partition_config, permutation, edge_matching, edge_permutation, sources);
 
         //permutation of the edges for random tie breaking
-        if(partition_config.edge_rating_tiebreaking) {
+        //the parallel sort keeps the order of ties, so it needs the permutation as well
+        if(partition_config.edge_rating_tiebreaking || partition_config.gpa_parallel_sort) {
                 PartitionConfig gpa_perm_config     = partition_config;
                 gpa_perm_config.permutation_quality = PERMUTATION_QUALITY_GOOD;
                 random_functions::permutate_entries(gpa_perm_config, edge_permutation, false);
         }
 
         compare_rating cmp(&G);
-        std::sort(edge_permutation.begin(), edge_permutation.end(), cmp);
+        if( partition_config.gpa_parallel_sort ) {
+                // ties are broken by the position in the permutation, then every sort gives the same order
+                std::vector<EdgeID> position(G.number_of_edges());
+                for( EdgeID i = 0; i < edge_permutation.size(); i++) {
+                        position[edge_permutation[i]] = i;
+                }
+                parallel_sort(edge_permutation, [&](const EdgeID lhs, const EdgeID rhs) {
+                                if( cmp(lhs, rhs) ) return true;
+                                if( cmp(rhs, lhs) ) return false;
+                                return position[lhs] < position[rhs];
+                                });
+        } else {
+                std::sort(edge_permutation.begin(), edge_permutation.end(), cmp);
+        }
 
         path_set pathset(&G, &partition_config);
 
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * local_max_matching.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <omp.h>
+#include <stdint.h>
+
+#include "local_max_matching.h"
+#include "macros_assertions.h"
+
+const NodeID PARALLEL_MATCHING_THRESHOLD = 10000;
+
+local_max_matching::local_max_matching() {
+
+}
+
+local_max_matching::~local_max_matching() {
+
+}
+
+// ties between equally rated edges are broken by a hash of both endpoints,
+// so that both endpoints agree on the order of the edges
+inline uint64_t tie_breaker(NodeID source, NodeID target, int seed) {
+        uint64_t key = source < target ? ((uint64_t)source << 32) | target : ((uint64_t)target << 32) | source;
+        key = (key ^ (uint64_t)seed) * 0x9E3779B97F4A7C15ULL;
+        return key ^ (key >> 29);
+}
+
+void local_max_matching::match(const PartitionConfig & partition_config,
+                               graph_access & G,
+                               Matching & edge_matching,
+                               CoarseMapping & coarse_mapping,
+                               NodeID & no_of_coarse_vertices,
+                               NodePermutationMap & permutation) {
+        PRINT(std::cout<< "matching using local max" << std::endl;)
+        const NodeID n = G.number_of_nodes();
+        permutation.resize(n);
+        edge_matching.resize(n);
+        coarse_mapping.resize(n);
+
+        std::vector<NodeID> candidate(n);
+        std::vector<NodeID> active(n);
+        #pragma omp parallel for schedule(static) if(n > PARALLEL_MATCHING_THRESHOLD)
+        for( NodeID node = 0; node < n; node++) {
+                permutation[node]   = node;
+                edge_matching[node] = node;
+                candidate[node]     = node;
+                active[node]        = node;
+
+                if(partition_config.edge_rating == WEIGHT) {
+                        // in that case we need to copy it
+                        forall_out_edges(G, e, node) {
+                                G.setEdgeRating(e, G.getEdgeWeight(e));
+                        } endfor
+                }
+        }
+
+        // every round matches at least the best remaining edge if the ratings are symmetric,
+        // otherwise the loop ends as soon as a round does not match anything
+        bool matched_something = true;
+        while( !active.empty() && matched_something ) {
+                const NodeID num_active = active.size();
+
+                #pragma omp parallel for schedule(dynamic, 1024) if(num_active > PARALLEL_MATCHING_THRESHOLD)
+                for( NodeID i = 0; i < num_active; i++) {
+                        candidate[active[i]] = best_candidate(partition_config, G, edge_matching, active[i]);
+                }
+
+                NodeID newly_matched = 0;
+                #pragma omp parallel for schedule(static) reduction(+:newly_matched) if(num_active > PARALLEL_MATCHING_THRESHOLD)
+                for( NodeID i = 0; i < num_active; i++) {
+                        NodeID node = active[i];
+                        NodeID partner = candidate[node];
+                        if( partner != node && candidate[partner] == node ) {
+                                edge_matching[node] = partner;
+                                newly_matched++;
+                        }
+                }
+                matched_something = newly_matched > 0;
+
+                // nodes that are still unmatched and have an eligible neighbor remain active
+                NodeID pos = 0;
+                for( NodeID i = 0; i < num_active; i++) {
+                        NodeID node = active[i];
+                        if( edge_matching[node] == node && candidate[node] != node ) {
+                                active[pos++] = node;
+                        }
+                }
+                active.resize(pos);
+        }
+
+        // all matched pairs are now in edge_matching
+        // now construct the coarsemapping
+        no_of_coarse_vertices = 0;
+        forall_nodes(G, node) {
+                if( node < edge_matching[node]) {
+                        coarse_mapping[node]                = no_of_coarse_vertices;
+                        coarse_mapping[edge_matching[node]] = no_of_coarse_vertices;
+                        no_of_coarse_vertices++;
+                } else if(node == edge_matching[node]) {
+                        coarse_mapping[node] = no_of_coarse_vertices;
+                        no_of_coarse_vertices++;
+                }
+        } endfor
+}
+
+NodeID local_max_matching::best_candidate(const PartitionConfig & partition_config, graph_access & G,
+                                          Matching & edge_matching, NodeID node) {
+        NodeID best                = node;
+        EdgeRatingType best_rating = 0;
+        uint64_t best_tie          = 0;
+        NodeWeight node_weight     = G.getNodeWeight(node);
+
+        forall_out_edges(G, e, node) {
+                NodeID target = G.getEdgeTarget(e);
+                if( edge_matching[target] != target ) continue;
+
+                EdgeRatingType rating = G.getEdgeRating(e);
+                if( rating == 0.0 ) continue;
+
+                //max vertex weight constraint
+                if( node_weight + G.getNodeWeight(target) > partition_config.max_vertex_weight ) continue;
+
+                if( partition_config.combine ) {
+                        if( G.getSecondPartitionIndex(node) != G.getSecondPartitionIndex(target) ) continue;
+                }
+
+                if( partition_config.graph_allready_partitioned ) {
+                        // v cycle... they shouldnt be contraced
+                        if( G.getPartitionIndex(node) != G.getPartitionIndex(target) ) continue;
+                }
+
+                uint64_t tie = tie_breaker(node, target, partition_config.seed);
+                if( best == node || rating > best_rating || (rating == best_rating && tie > best_tie) ) {
+                        best        = target;
+                        best_rating = rating;
+                        best_tie    = tie;
+                }
+        } endfor
+
+        return best;
+}
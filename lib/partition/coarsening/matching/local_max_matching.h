@@ -0,0 +1,34 @@
+/******************************************************************************
+ * local_max_matching.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef LOCAL_MAX_MATCHING_P7RT2WQX
+#define LOCAL_MAX_MATCHING_P7RT2WQX
+
+#include "matching.h"
+
+// matches locally dominant edges: in every round each unmatched node proposes to the
+// neighbor with the highest rated eligible edge and mutual proposals are matched.
+// the nodes are processed in parallel and no global sort of the edges is needed.
+class local_max_matching : public matching {
+        public:
+                local_max_matching();
+                virtual ~local_max_matching();
+
+                void match(const PartitionConfig & config,
+                           graph_access & G,
+                           Matching & _matching,
+                           CoarseMapping & coarse_mapping,
+                           NodeID & no_of_coarse_vertices,
+                           NodePermutationMap & permutation);
+
+        private:
+                // the neighbor of node with the best eligible edge or node itself if there is none
+                NodeID best_candidate(const PartitionConfig & config, graph_access & G,
+                                      Matching & edge_matching, NodeID node);
+};
+
+#endif /* end of include guard: LOCAL_MAX_MATCHING_P7RT2WQX */
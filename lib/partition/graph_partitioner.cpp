@@ -5,7 +5,10 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <omp.h>
+
 #include "coarsening/coarsening.h"
+#include "data_structure/hierarchy_pool.h"
 #include "graph_extractor.h"
 #include "graph_partitioner.h"
 #include "initial_partitioning/initial_partitioning.h"
@@ -27,7 +30,7 @@ void graph_partitioner::perform_partitioning_krec_hierarchy(PartitionConfig & co
         m_global_k = config.k;
         m_global_upper_bound = config.upper_bound_partition;
         m_rnd_bal = random_functions::nextDouble(1,2);
-        perform_recursive_partitioning_kmodel_internal(config, G, config.group_sizes);
+        perform_recursive_partitioning_kmodel_internal(config, G, config.group_sizes, 0);
 }
 
 void graph_partitioner::perform_recursive_partitioning(PartitionConfig & config, graph_access & G) {
@@ -39,13 +42,14 @@ void graph_partitioner::perform_recursive_partitioning(PartitionConfig & config,
 
 void graph_partitioner::perform_recursive_partitioning_kmodel_internal(PartitionConfig & config, 
                                                                 graph_access & G, 
-                                                                std::vector< int > group_sizes) {
+                                                                std::vector< int > group_sizes,
+                                                                PartitionID offset) {
 
         PartitionID num_parts = group_sizes[group_sizes.size()-1];
         if( num_parts == 1 ) {
                 if( group_sizes.size() == 1 ) return;
                 group_sizes.pop_back();
-                return perform_recursive_partitioning_kmodel_internal( config, G, group_sizes);
+                return perform_recursive_partitioning_kmodel_internal( config, G, group_sizes, offset);
         } 
 
         G.set_partition_count(num_parts);
@@ -87,17 +91,15 @@ void graph_partitioner::perform_recursive_partitioning_kmodel_internal(Partition
         }
         if(remaining_k > 1) {
                 std::vector< PartitionID > partition_ids(G.number_of_nodes());
-                for( PartitionID block = 0; block < num_parts; block++) {
-                        graph_extractor ge; graph_access Q;
-                        std::vector<NodeID> mapping;
-                        ge.extract_block( G, Q, block, mapping);
-                        perform_recursive_partitioning_kmodel_internal( config, Q, group_sizes);
-
-                        Q.set_partition_count(remaining_k);
-                        forall_nodes(Q, node) {
-                                partition_ids[mapping[node]] = Q.getPartitionIndex(node) + block*remaining_k;
-                        } endfor
+                if( config.parallel_multisection && omp_get_level() == 0 ) {
+                        // the top level graph is partitioned with all threads, below the blocks are the tasks
+                        #pragma omp parallel
+                        #pragma omp master
+                        partition_blocks_kmodel(config, G, group_sizes, offset, num_parts, remaining_k, partition_ids);
+                } else {
+                        partition_blocks_kmodel(config, G, group_sizes, offset, num_parts, remaining_k, partition_ids);
                 }
+
                 forall_nodes(G, node) {
                         G.setPartitionIndex(node, partition_ids[node]);
                 } endfor
@@ -107,6 +109,52 @@ void graph_partitioner::perform_recursive_partitioning_kmodel_internal(Partition
         G.set_partition_count(num_parts*remaining_k);
 }
 
+void graph_partitioner::partition_blocks_kmodel(PartitionConfig & config, 
+                                                graph_access & G, 
+                                                std::vector< int > & group_sizes,
+                                                PartitionID offset, 
+                                                PartitionID num_parts, 
+                                                int remaining_k,
+                                                std::vector< PartitionID > & partition_ids) {
+
+        // the blocks are independent. a block is extracted when its task starts, so only the
+        // subgraphs of the running tasks are in memory. every task has its own random stream
+        // that only depends on the position of the block, i.e. the result does not depend on
+        // the number of threads or on the order in which the tasks are executed.
+        for( PartitionID block = 0; block < num_parts; block++) {
+                #pragma omp task if(config.parallel_multisection) firstprivate(block) \
+                                 shared(config, G, group_sizes, partition_ids)
+                {
+                        PartitionID block_offset = offset + block*remaining_k;
+                        if( config.parallel_multisection ) {
+                                random_stream_guard stream(config.seed + block_offset + m_global_k*group_sizes.size());
+                                partition_block_kmodel(config, G, group_sizes, block, block_offset, remaining_k, partition_ids);
+                        } else {
+                                partition_block_kmodel(config, G, group_sizes, block, block_offset, remaining_k, partition_ids);
+                        }
+                }
+        }
+        #pragma omp taskwait
+}
+
+void graph_partitioner::partition_block_kmodel(PartitionConfig & config, 
+                                               graph_access & G, 
+                                               std::vector< int > & group_sizes,
+                                               PartitionID block, 
+                                               PartitionID block_offset, 
+                                               int remaining_k,
+                                               std::vector< PartitionID > & partition_ids) {
+        graph_extractor ge; graph_access Q;
+        std::vector<NodeID> mapping;
+        ge.extract_block( G, Q, block, mapping);
+        perform_recursive_partitioning_kmodel_internal( config, Q, group_sizes, block_offset);
+
+        Q.set_partition_count(remaining_k);
+        forall_nodes(Q, node) {
+                partition_ids[mapping[node]] = Q.getPartitionIndex(node) + block*remaining_k;
+        } endfor
+}
+
 void graph_partitioner::perform_recursive_partitioning_internal(PartitionConfig & config, 
                                                                 graph_access & G, 
                                                                 PartitionID lb, 
@@ -239,8 +287,14 @@ void graph_partitioner::perform_recursive_partitioning_internal(PartitionConfig
 
 void graph_partitioner::single_run( PartitionConfig & config, graph_access & G) {
 
+        // the levels of consecutive cycles are built in the memory of the previous cycle.
+        // with a memory budget the levels are freed instead, the pool would keep the
+        // reloaded levels resident
+        hierarchy_pool pool;
+        if( config.hierarchy_memory_budget > 0 ) pool.stop_recycling();
         for( unsigned i = 1; i <= config.global_cycle_iterations; i++) {
                 PRINT(std::cout <<  "vcycle " << i << " of " << config.global_cycle_iterations  << std::endl;)
+                        if(i == config.global_cycle_iterations) pool.stop_recycling();
                         if(config.use_wcycles || config.use_fullmultigrid)  {
                                 wcycle_partitioner w_partitioner;
                                 w_partitioner.perform_partitioning(config, G);
@@ -249,7 +303,12 @@ void graph_partitioner::single_run( PartitionConfig & config, graph_access & G)
                                 initial_partitioning init_part;
                                 uncoarsening uncoarsen;
 
-                                graph_hierarchy hierarchy;
+                                graph_hierarchy hierarchy(&pool);
+                                if( config.hierarchy_memory_budget > 0 ) {
+                                        hierarchy.set_memory_budget(config.hierarchy_memory_budget*1024*1024, 
+                                                                    config.hierarchy_spill_directory);
+                                }
+                                hierarchy.set_compress_finest_level(config.compress_finest_level);
 
                                 if( config.mode_node_separators ) {
                                         int rnd = random_functions::nextInt(0,3);
@@ -29,7 +29,18 @@ private:
                                                      PartitionID lb, PartitionID ub);
 
         void perform_recursive_partitioning_kmodel_internal(PartitionConfig & graph_partitioner_config, 
-                                                            graph_access & G, std::vector< int > group_sizes);
+                                                            graph_access & G, std::vector< int > group_sizes,
+                                                            PartitionID offset);
+
+        void partition_blocks_kmodel(PartitionConfig & graph_partitioner_config, 
+                                     graph_access & G, std::vector< int > & group_sizes,
+                                     PartitionID offset, PartitionID num_parts, int remaining_k,
+                                     std::vector< PartitionID > & partition_ids);
+
+        void partition_block_kmodel(PartitionConfig & graph_partitioner_config, 
+                                    graph_access & G, std::vector< int > & group_sizes,
+                                    PartitionID block, PartitionID block_offset, int remaining_k,
+                                    std::vector< PartitionID > & partition_ids);
 
         void single_run( PartitionConfig & config, graph_access & G);
 
@@ -19,11 +19,27 @@ struct PartitionConfig
 
         bool use_mmap_io;
 
+        // the input graph is relabeled for locality before partitioning
+        RelabelingType relabeling_type;
+
+        // memory in MB the finer levels of the hierarchy may take before they are
+        // moved to hierarchy_spill_directory, 0 keeps everything in memory
+        double hierarchy_memory_budget;
+
+        std::string hierarchy_spill_directory;
+
+        // the input graph is kept varint compressed while the coarser levels are processed
+        bool compress_finest_level;
+
         //============================================================
         //=======================MATCHING=============================
         //============================================================
         bool edge_rating_tiebreaking;
 
+        // gpa sorts the edges in parallel, equal ratings are ordered by their position in the
+        // edge permutation so that the order does not depend on the number of threads
+        bool gpa_parallel_sort;
+
         EdgeRating edge_rating;
         
         PermutationQuality permutation_quality;
@@ -222,6 +238,12 @@ struct PartitionConfig
 
         unsigned mh_pool_size;
 
+        std::string mh_checkpoint_dir; // empty: no checkpoints are written
+
+        double mh_checkpoint_interval;
+
+        bool mh_resume;
+
         bool combine; // in this case the second index is filled and edges between both partitions are not contracted
 
         unsigned initial_partition_optimize_fm_limits;
@@ -401,6 +423,12 @@ struct PartitionConfig
 
         std::vector< int > distances;
 
+        // network of the PEs in METIS format, used instead of group_sizes and distances
+        std::string topology_filename;
+
+        // memory in MB for the cached rows of the topology distances
+        double topology_cache_size;
+
 	int search_space_s;
 
         PreConfigMapping preconfiguration_mapping;
@@ -409,11 +437,19 @@ struct PartitionConfig
 
         bool enable_mapping;
 
+        bool parallel_mapping_local_search;
+
+        // the blocks of a hierarchy level are partitioned as parallel tasks
+        bool parallel_multisection;
+
         //=======================================
         //========NODE ORDERING==================
         //=======================================
         unsigned int dissection_rec_limit;
 
+        // try several recursion limits, keep the ordering with the least factorization flops
+        bool dissection_auto_rec_limit;
+
         bool disable_reductions;
 
         std::vector<nested_dissection_reduction_type> reduction_order;
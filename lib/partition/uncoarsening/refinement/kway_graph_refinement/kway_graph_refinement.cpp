@@ -23,8 +23,6 @@ kway_graph_refinement::~kway_graph_refinement() {
 EdgeWeight kway_graph_refinement::perform_refinement(PartitionConfig & config, graph_access & G, 
                                                      complete_boundary & boundary) {
 
-        kway_graph_refinement_core refinement_core;
-        
         EdgeWeight overall_improvement = 0;
         int max_number_of_swaps        = (int)(G.number_of_nodes());
         bool sth_changed               = config.no_change_convergence;
@@ -41,10 +39,10 @@ EdgeWeight kway_graph_refinement::perform_refinement(PartitionConfig & config, g
                 int step_limit = (int)((config.kway_fm_search_limit/100.0)*max_number_of_swaps);
                 step_limit = std::max(step_limit, 15);
 
-                vertex_moved_hashtable moved_idx; 
-                improvement += refinement_core.single_kway_refinement_round(config, G, boundary, 
-                                                                            start_nodes, step_limit, 
-                                                                            moved_idx);
+                m_moved_idx.clear(); 
+                improvement += m_refinement_core.single_kway_refinement_round(config, G, boundary, 
+                                                                              start_nodes, step_limit, 
+                                                                              m_moved_idx);
 
                 sth_changed = improvement != 0 && config.no_change_convergence;
                 if(improvement == 0) break; 
@@ -61,7 +59,8 @@ void kway_graph_refinement::setup_start_nodes(PartitionConfig & config, graph_ac
         QuotientGraphEdges quotient_graph_edges;
         boundary.getQuotientGraphEdges(quotient_graph_edges);
 
-        std::unordered_map<NodeID, bool> allready_contained;
+        std::unordered_map<NodeID, bool> & allready_contained = m_allready_contained;
+        allready_contained.clear();
 
         for( unsigned i = 0; i < quotient_graph_edges.size(); i++) {
                 boundary_pair & ret_value = quotient_graph_edges[i];
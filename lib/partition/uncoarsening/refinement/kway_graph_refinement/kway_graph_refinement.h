@@ -8,11 +8,13 @@
 #ifndef KWAY_GRAPH_REFINEMENT_PVGY97EW
 #define KWAY_GRAPH_REFINEMENT_PVGY97EW
 
+#include <unordered_map>
 #include <vector>
 
 #include "data_structure/priority_queues/priority_queue_interface.h"
 #include "definitions.h"
 #include "kway_graph_refinement_commons.h"
+#include "kway_graph_refinement_core.h"
 #include "random_functions.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/2way_fm_refinement/vertex_moved_hashtable.h"
 #include "uncoarsening/refinement/refinement.h"
@@ -30,6 +32,12 @@ class kway_graph_refinement : public refinement {
                                        graph_access & G, 
                                        complete_boundary & boundary,  
                                        boundary_starting_nodes & start_nodes);
+
+        private:
+                // kept across rounds and levels so that their memory is reused
+                kway_graph_refinement_core       m_refinement_core;
+                vertex_moved_hashtable           m_moved_idx;
+                std::unordered_map<NodeID, bool> m_allready_contained;
 };
 
 #endif /* end of include guard: KWAY_GRAPH_REFINEMENT_PVGY97EW */
@@ -14,11 +14,13 @@
 #include "quality_metrics.h"
 #include "random_functions.h"
 
-kway_graph_refinement_core::kway_graph_refinement_core() : commons (NULL){
+kway_graph_refinement_core::kway_graph_refinement_core() : commons (NULL), m_queue (NULL), 
+                                                           m_queue_is_bucket_pq (false), m_queue_gain_span (0) {
 }
 
 kway_graph_refinement_core::~kway_graph_refinement_core() {
         if( commons != NULL)  delete commons;
+        if( m_queue != NULL)  delete m_queue;
 }
 EdgeWeight kway_graph_refinement_core::single_kway_refinement_round(PartitionConfig & config, 
                                                                     graph_access & G, 
@@ -55,21 +57,29 @@ EdgeWeight kway_graph_refinement_core::single_kway_refinement_round_internal(Par
 
         if( commons == NULL ) commons = new kway_graph_refinement_commons(config);
 
-        refinement_pq* queue = NULL;
-        if(config.use_bucket_queues) {
-                EdgeWeight max_degree = G.getMaxDegree();
-                queue                 = new bucket_pq(max_degree);
-        } else {
-                queue                 = new maxNodeHeap(); 
+        EdgeWeight max_degree = config.use_bucket_queues ? G.getMaxDegree() : 0;
+        if( m_queue == NULL || m_queue_is_bucket_pq != config.use_bucket_queues || m_queue_gain_span != max_degree ) {
+                if( m_queue != NULL ) delete m_queue;
+                if(config.use_bucket_queues) {
+                        m_queue       = new bucket_pq(max_degree);
+                } else {
+                        m_queue       = new maxNodeHeap(); 
+                }
+                m_queue_is_bucket_pq  = config.use_bucket_queues;
+                m_queue_gain_span     = max_degree;
         }
+        refinement_pq* queue = m_queue;
 
         init_queue_with_boundary(config, G, start_nodes, queue, moved_idx);  
         
-        if(queue->empty()) {delete queue; return 0;}
+        if(queue->empty()) {return 0;}
 
-        std::vector<NodeID> transpositions;
-        std::vector<PartitionID> from_partitions;
-        std::vector<PartitionID> to_partitions;
+        std::vector<NodeID> & transpositions       = m_transpositions;
+        std::vector<PartitionID> & from_partitions = m_from_partitions;
+        std::vector<PartitionID> & to_partitions   = m_to_partitions;
+        transpositions.clear();
+        from_partitions.clear();
+        to_partitions.clear();
 
         int max_number_of_swaps = (int)(G.number_of_nodes());
         int min_cut_index       = -1;
@@ -165,7 +175,7 @@ EdgeWeight kway_graph_refinement_core::single_kway_refinement_round_internal(Par
         ASSERT_TRUE(boundary.assert_bnodes_in_boundaries());
         ASSERT_TRUE(boundary.assert_boundaries_are_bnodes());
 
-        delete queue;
+        queue->clear();
         delete stopping_rule;
         return initial_cut - best_cut; 
 }
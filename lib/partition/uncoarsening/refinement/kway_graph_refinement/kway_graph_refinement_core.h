@@ -76,6 +76,15 @@ class kway_graph_refinement_core  {
                                                       std::vector<bool> & partition_move_valid); 
                 
                 kway_graph_refinement_commons* commons;
+
+                // scratch of a round, kept for the following rounds. the bucket queue is 
+                // only reused while the maximum degree, i.e. its gain span, stays the same
+                refinement_pq*           m_queue;
+                bool                     m_queue_is_bucket_pq;
+                EdgeWeight               m_queue_gain_span;
+                std::vector<NodeID>      m_transpositions;
+                std::vector<PartitionID> m_from_partitions;
+                std::vector<PartitionID> m_to_partitions;
 };
 
 inline bool kway_graph_refinement_core::move_node(PartitionConfig & config, 
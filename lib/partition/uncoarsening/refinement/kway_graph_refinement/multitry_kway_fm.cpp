@@ -115,10 +115,16 @@ int multitry_kway_fm::start_more_locallized_search(PartitionConfig & config, gra
         random_functions::permutate_vector_good(todolist, false);
         if( commons == NULL ) commons = new kway_graph_refinement_commons(config);
         
-        kway_graph_refinement_core refinement_core;
         int local_step_limit = 0;
 
-        vertex_moved_hashtable moved_idx;
+        // erase the entries one by one, clearing the table would touch all buckets it 
+        // allocated for the largest search so far
+        vertex_moved_hashtable & moved_idx = m_moved_idx;
+        vertex_moved_hashtable::iterator it = moved_idx.begin();
+        while( it != moved_idx.end() ) {
+                it = moved_idx.erase(it);
+        }
+
         unsigned idx            = todolist.size()-1;
         int overall_improvement = 0;
         
@@ -148,17 +154,17 @@ int multitry_kway_fm::start_more_locallized_search(PartitionConfig & config, gra
                         }        
                         int improvement = 0;
                         if(compute_touched_blocks) {
-                                improvement = refinement_core.single_kway_refinement_round(config, G, 
-                                                                                           boundary, real_start_nodes, 
-                                                                                           local_step_limit, moved_idx, 
-                                                                                           touched_blocks);
+                                improvement = m_refinement_core.single_kway_refinement_round(config, G, 
+                                                                                             boundary, real_start_nodes, 
+                                                                                             local_step_limit, moved_idx, 
+                                                                                             touched_blocks);
                                 if(improvement < 0) {
                                         std::cout <<  "buf error improvement < 0"  << std::endl;
                                 }
                         } else {
-                                improvement = refinement_core.single_kway_refinement_round(config, G, 
-                                                                                           boundary, real_start_nodes, 
-                                                                                           local_step_limit, moved_idx);
+                                improvement = m_refinement_core.single_kway_refinement_round(config, G, 
+                                                                                             boundary, real_start_nodes, 
+                                                                                             local_step_limit, moved_idx);
                                 if(improvement < 0) {
                                         std::cout <<  "buf error improvement < 0"  << std::endl;
                                 }
@@ -8,10 +8,12 @@
 #ifndef MULTITRY_KWAYFM_PVGY97EW
 #define MULTITRY_KWAYFM_PVGY97EW
 
+#include <unordered_map>
 #include <vector>
 
 #include "definitions.h"
 #include "kway_graph_refinement_commons.h"
+#include "kway_graph_refinement_core.h"
 #include "uncoarsening/refinement/refinement.h"
 
 class multitry_kway_fm {
@@ -39,6 +41,10 @@ class multitry_kway_fm {
                                                  std::vector<NodeID> & todolist);
 
                 kway_graph_refinement_commons* commons;
+
+                // kept across searches and levels so that their memory is reused
+                kway_graph_refinement_core m_refinement_core;
+                vertex_moved_hashtable     m_moved_idx;
 };
 
 #endif /* end of include guard: MULTITRY_KWAYFM_PVGY97EW  */
@@ -7,23 +7,25 @@
 
 #include "cycle_improvements/cycle_refinement.h"
 #include "kway_graph_refinement/kway_graph_refinement.h"
-#include "kway_graph_refinement/multitry_kway_fm.h"
 #include "mixed_refinement.h"
 #include "quotient_graph_refinement/quotient_graph_refinement.h"
 
 mixed_refinement::mixed_refinement() {
-
+        m_quotient_graph_refinement = new quotient_graph_refinement();
+        m_kway_refinement           = new kway_graph_refinement();
+        m_cycle_refinement          = new cycle_refinement();
 }
 
 mixed_refinement::~mixed_refinement() {
-
+        delete m_quotient_graph_refinement;
+        delete m_kway_refinement;
+        delete m_cycle_refinement;
 }
 
 EdgeWeight mixed_refinement::perform_refinement(PartitionConfig & config, graph_access & G, complete_boundary & boundary) {
-        refinement* refine              = new quotient_graph_refinement();
-        refinement* kway                = new kway_graph_refinement();
-        multitry_kway_fm* multitry_kway = new multitry_kway_fm();
-        cycle_refinement* cycle_refine  = new cycle_refinement();
+        refinement* refine             = m_quotient_graph_refinement;
+        refinement* kway               = m_kway_refinement;
+        refinement* cycle_refine       = m_cycle_refinement;
 
         EdgeWeight overall_improvement = 0; 
         //call refinement
@@ -57,11 +59,6 @@ EdgeWeight mixed_refinement::perform_refinement(PartitionConfig & config, graph_
                 }
         }
 
-        delete refine;
-        delete kway;
-        delete multitry_kway;
-        delete cycle_refine;
-
         return overall_improvement;
 }
 
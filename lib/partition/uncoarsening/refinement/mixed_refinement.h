@@ -19,6 +19,12 @@ public:
         virtual EdgeWeight perform_refinement(PartitionConfig & config, 
                                               graph_access & G, 
                                               complete_boundary & boundary); 
+
+private:
+        // the refinements are kept for all levels of the hierarchy
+        refinement* m_quotient_graph_refinement;
+        refinement* m_kway_refinement;
+        refinement* m_cycle_refinement;
 };
 
 
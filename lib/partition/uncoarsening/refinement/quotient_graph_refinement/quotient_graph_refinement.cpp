@@ -106,16 +106,15 @@ EdgeWeight quotient_graph_refinement::perform_refinement(PartitionConfig & confi
 
                 EdgeWeight multitry_improvement = 0;
                 if(config.refinement_scheduling_algorithm == REFINEMENT_SCHEDULING_ACTIVE_BLOCKS_REF_KWAY ) {
-                        multitry_kway_fm kway_ref;
-                        std::unordered_map<PartitionID, PartitionID> touched_blocks;
+                        m_touched_blocks.clear();
 
-                        multitry_improvement = kway_ref.perform_refinement_around_parts(cfg, G, 
+                        multitry_improvement = m_kway_ref.perform_refinement_around_parts(cfg, G, 
                                                                                 boundary, true, 
                                                                                 config.local_multitry_fm_alpha, lhs, rhs, 
-                                                                                touched_blocks); 
+                                                                                m_touched_blocks); 
 
                         if(multitry_improvement > 0) {
-                                ((active_block_quotient_graph_scheduler*)scheduler)->activate_blocks(touched_blocks);
+                                ((active_block_quotient_graph_scheduler*)scheduler)->activate_blocks(m_touched_blocks);
                         }
 
                 }
@@ -8,7 +8,10 @@
 #ifndef QUOTIENT_GRAPH_REFINEMENT_A0Y1Y6LL
 #define QUOTIENT_GRAPH_REFINEMENT_A0Y1Y6LL
 
+#include <unordered_map>
+
 #include "definitions.h"
+#include "uncoarsening/refinement/kway_graph_refinement/multitry_kway_fm.h"
 #include "uncoarsening/refinement/refinement.h"
 
 class quotient_graph_refinement : public refinement {
@@ -36,6 +39,9 @@ class quotient_graph_refinement : public refinement {
                                                         EdgeWeight & cut,
                                                         bool & something_changed); 
 
+                // kept across block pairs and levels so that their memory is reused
+                multitry_kway_fm                             m_kway_ref;
+                std::unordered_map<PartitionID, PartitionID> m_touched_blocks;
 };
 
 
@@ -67,7 +67,7 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
 
         NodeID coarser_no_nodes = coarsest->number_of_nodes();
         graph_access* finest    = NULL;
-        graph_access* to_delete = NULL;
+        graph_access* to_delete = coarsest;
         unsigned int hierarchy_deepth = hierarchy.size();
 
         while(!hierarchy.isEmpty()) {
@@ -75,8 +75,10 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
 
                 PRINT(std::cout << "log>" << "unrolling graph with " << G->number_of_nodes()<<  std::endl;)
                 
+                // the boundary is not pooled: it is built from the coarser boundary, which has to be alive
+                // at that point, and its hashed block pair boundaries are sized by the nodes of this level
                 if(!config.label_propagation_refinement) {
-                        finer_boundary = new complete_boundary(G); 
+                        finer_boundary = new complete_boundary(G);
                         finer_boundary->build_from_coarser(coarser_boundary, coarser_no_nodes, hierarchy.get_mapping_of_current_finer());
                 }
 
@@ -98,7 +100,7 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
 
 		//clean up 
 		if(to_delete != NULL) {
-			delete to_delete;
+			hierarchy.release_graph(to_delete);
 		}
 		if(!hierarchy.isEmpty()) {
 			to_delete = G;
@@ -115,7 +117,6 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
 
         delete refine;
         if(finer_boundary != NULL) delete finer_boundary;
-	delete coarsest;
 
         return improvement;
 }
@@ -157,7 +158,7 @@ int uncoarsening::perform_uncoarsening_nodeseparator(const PartitionConfig & con
                 }
         }
 
-        graph_access* to_delete = NULL;
+        graph_access* to_delete = coarsest;
         while(!hierarchy.isEmpty()) {
                 graph_access* G = hierarchy.pop_finer_and_project();
                 PRINT(std::cout << "log>" << "unrolling graph with " << G->number_of_nodes() << std::endl;)
@@ -202,13 +203,12 @@ int uncoarsening::perform_uncoarsening_nodeseparator(const PartitionConfig & con
                         }
                 }
                 if(to_delete != NULL) {
-			delete to_delete;
+			hierarchy.release_graph(to_delete);
 		}
 		if(!hierarchy.isEmpty()) {
 			to_delete = G;
 		}
         }
-	delete coarsest;
 
         return 0;
 }
@@ -252,7 +252,7 @@ int uncoarsening::perform_uncoarsening_nodeseparator_fast(const PartitionConfig
                 }
         }
 
-        graph_access* to_delete = NULL;
+        graph_access* to_delete = coarsest;
         while(!hierarchy.isEmpty()) {
                 graph_access* G = hierarchy.pop_finer_and_project_ns(current_separator);
                 PRINT(std::cout << "log>" << "unrolling graph with " << G->number_of_nodes() << std::endl;)
@@ -293,13 +293,12 @@ int uncoarsening::perform_uncoarsening_nodeseparator_fast(const PartitionConfig
                         }
                 }
                 if(to_delete != NULL) {
-			delete to_delete;
+			hierarchy.release_graph(to_delete);
 		}
 		if(!hierarchy.isEmpty()) {
 			to_delete = G;
 		}
         }
-	delete coarsest;
 
         return 0;
 }
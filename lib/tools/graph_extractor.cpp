@@ -25,16 +25,22 @@ void graph_extractor::extract_block(graph_access & G,
         // build reverse mapping
         std::vector<NodeID> reverse_mapping;
         NodeID nodes = 0;
+        EdgeID edges = 0;
         NodeID dummy_node = G.number_of_nodes() + 1;
         forall_nodes(G, node) {
                 if(G.getPartitionIndex(node) == block) {
                         reverse_mapping.push_back(nodes++);
+                        forall_out_edges(G, e, node) {
+                                if( G.getPartitionIndex( G.getEdgeTarget(e) ) == block ) edges++;
+                        } endfor
                 } else {
                         reverse_mapping.push_back(dummy_node);
                 }
         } endfor
 
-        extracted_block.start_construction(nodes, G.number_of_edges());
+        // the edges are counted, so that the block does not reserve the edges of G
+        // (blocks are extracted concurrently in the parallel multisection)
+        extracted_block.start_construction(nodes, edges);
 
         forall_nodes(G, node) {
                 if(G.getPartitionIndex(node) == block) {
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * graph_relabeling.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "graph_relabeling.h"
+
+graph_relabeling::graph_relabeling() {
+
+}
+
+graph_relabeling::~graph_relabeling() {
+
+}
+
+void graph_relabeling::compute_ordering(const PartitionConfig & config, graph_access & G, std::vector<NodeID> & new_id) {
+        std::vector<NodeID> order;
+        switch( config.relabeling_type ) {
+                case RELABELING_BFS:
+                        bfs_ordering(G, order);
+                        break;
+                case RELABELING_RCM:
+                        rcm_ordering(G, order);
+                        break;
+                case RELABELING_DEGREE:
+                        degree_ordering(G, order);
+                        break;
+                default:
+                        order.resize(G.number_of_nodes());
+                        forall_nodes(G, node) {
+                                order[node] = node;
+                        } endfor
+                        break;
+        }
+
+        new_id.resize(G.number_of_nodes());
+        for( NodeID i = 0; i < order.size(); i++) {
+                new_id[order[i]] = i;
+        }
+}
+
+void graph_relabeling::relabel(graph_access & G, const std::vector<NodeID> & new_id) {
+        std::vector<NodeID> order(G.number_of_nodes());
+        forall_nodes(G, node) {
+                order[new_id[node]] = node;
+        } endfor
+
+        graph_access H;
+        H.start_construction(G.number_of_nodes(), G.number_of_edges());
+        H.set_partition_count(G.get_partition_count());
+
+        // the edges of a node are sorted by their new targets
+        std::vector< std::pair<NodeID, EdgeWeight> > adjacency;
+        for( NodeID i = 0; i < order.size(); i++) {
+                NodeID node = order[i];
+                NodeID shadow_node = H.new_node();
+                H.setNodeWeight(shadow_node, G.getNodeWeight(node));
+                H.setPartitionIndex(shadow_node, G.getPartitionIndex(node));
+
+                adjacency.clear();
+                forall_out_edges(G, e, node) {
+                        adjacency.push_back(std::make_pair(new_id[G.getEdgeTarget(e)], G.getEdgeWeight(e)));
+                } endfor
+                std::sort(adjacency.begin(), adjacency.end());
+
+                for( unsigned j = 0; j < adjacency.size(); j++) {
+                        EdgeID shadow_edge = H.new_edge(shadow_node, adjacency[j].first);
+                        H.setEdgeWeight(shadow_edge, adjacency[j].second);
+                }
+        }
+        H.finish_construction();
+
+        G.swap(H);
+}
+
+void graph_relabeling::restore(graph_access & G, const std::vector<NodeID> & new_id) {
+        std::vector<NodeID> old_id(new_id.size());
+        for( NodeID node = 0; node < new_id.size(); node++) {
+                old_id[new_id[node]] = node;
+        }
+        relabel(G, old_id);
+}
+
+void graph_relabeling::bfs_ordering(graph_access & G, std::vector<NodeID> & order) {
+        std::vector<bool> visited(G.number_of_nodes(), false);
+        order.clear();
+        order.reserve(G.number_of_nodes());
+
+        // the order itself is the queue of the bfs
+        forall_nodes(G, start) {
+                if( visited[start] ) continue;
+                visited[start] = true;
+                order.push_back(start);
+
+                for( NodeID head = order.size()-1; head < order.size(); head++) {
+                        NodeID node = order[head];
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if( !visited[target] ) {
+                                        visited[target] = true;
+                                        order.push_back(target);
+                                }
+                        } endfor
+                }
+        } endfor
+}
+
+void graph_relabeling::rcm_ordering(graph_access & G, std::vector<NodeID> & order) {
+        std::vector<NodeID> by_degree;
+        sort_by_degree(G, false, by_degree);
+
+        std::vector<bool> visited(G.number_of_nodes(), false);
+        order.clear();
+        order.reserve(G.number_of_nodes());
+
+        // cuthill mckee: every component is traversed from its node with the smallest degree
+        // and the unvisited neighbors of a node are appended by ascending degree
+        for( NodeID i = 0; i < by_degree.size(); i++) {
+                NodeID start = by_degree[i];
+                if( visited[start] ) continue;
+                visited[start] = true;
+                order.push_back(start);
+
+                for( NodeID head = order.size()-1; head < order.size(); head++) {
+                        NodeID node  = order[head];
+                        NodeID begin = order.size();
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if( !visited[target] ) {
+                                        visited[target] = true;
+                                        order.push_back(target);
+                                }
+                        } endfor
+
+                        std::sort(order.begin() + begin, order.end(), [&](NodeID lhs, NodeID rhs) {
+                                        EdgeID lhs_degree = G.getNodeDegree(lhs);
+                                        EdgeID rhs_degree = G.getNodeDegree(rhs);
+                                        return lhs_degree < rhs_degree || (lhs_degree == rhs_degree && lhs < rhs);
+                                        });
+                }
+        }
+
+        std::reverse(order.begin(), order.end());
+}
+
+void graph_relabeling::degree_ordering(graph_access & G, std::vector<NodeID> & order) {
+        // high degree nodes are accessed most often, so they are grouped at the front
+        sort_by_degree(G, true, order);
+}
+
+void graph_relabeling::sort_by_degree(graph_access & G, bool descending, std::vector<NodeID> & nodes) {
+        EdgeID max_degree = 0;
+        forall_nodes(G, node) {
+                max_degree = std::max(max_degree, (EdgeID)G.getNodeDegree(node));
+        } endfor
+
+        std::vector<NodeID> bucket_begin(max_degree + 2, 0);
+        forall_nodes(G, node) {
+                EdgeID degree = G.getNodeDegree(node);
+                bucket_begin[(descending ? max_degree - degree : degree) + 1]++;
+        } endfor
+        for( EdgeID i = 1; i < bucket_begin.size(); i++) {
+                bucket_begin[i] += bucket_begin[i-1];
+        }
+
+        nodes.resize(G.number_of_nodes());
+        forall_nodes(G, node) {
+                EdgeID degree = G.getNodeDegree(node);
+                nodes[bucket_begin[descending ? max_degree - degree : degree]++] = node;
+        } endfor
+}
@@ -0,0 +1,47 @@
+/******************************************************************************
+ * graph_relabeling.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef GRAPH_RELABELING_Q8ZK3MVT
+#define GRAPH_RELABELING_Q8ZK3MVT
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "definitions.h"
+#include "partition_config.h"
+
+// relabels the nodes of a graph such that neighbors get close ids, i.e. the
+// accesses to the node arrays while iterating over the edges become more local.
+// the multilevel algorithm then runs on the relabeled graph and the partition
+// is mapped back to the original ids afterwards.
+class graph_relabeling {
+        public:
+                graph_relabeling();
+                virtual ~graph_relabeling();
+
+                // computes the new id of every node according to config.relabeling_type
+                void compute_ordering(const PartitionConfig & config, graph_access & G, std::vector<NodeID> & new_id);
+
+                // replaces G by the graph in which node v has the id new_id[v].
+                // node weights, edge weights and the partition are kept
+                void relabel(graph_access & G, const std::vector<NodeID> & new_id);
+
+                // undoes relabel(G, new_id)
+                void restore(graph_access & G, const std::vector<NodeID> & new_id);
+
+        private:
+                // the ordering fills order with the nodes in the order of their new ids
+                void bfs_ordering(graph_access & G, std::vector<NodeID> & order);
+                void rcm_ordering(graph_access & G, std::vector<NodeID> & order);
+                void degree_ordering(graph_access & G, std::vector<NodeID> & order);
+
+                // bucket sort of all nodes by degree, equal degrees in the order of their ids
+                void sort_by_degree(graph_access & G, bool descending, std::vector<NodeID> & nodes);
+};
+
+
+#endif /* end of include guard: GRAPH_RELABELING_Q8ZK3MVT */
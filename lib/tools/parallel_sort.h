@@ -0,0 +1,53 @@
+/******************************************************************************
+ * parallel_sort.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef PARALLEL_SORT_K3D9WQ2E
+#define PARALLEL_SORT_K3D9WQ2E
+
+#include <algorithm>
+#include <functional>
+#include <omp.h>
+#include <vector>
+
+// sorts 'values' in parallel: every thread sorts one block, then the blocks are merged pairwise.
+// small inputs and single threaded runs use std::sort, i.e. the order of equal elements is the same as before.
+// inside a parallel region (e.g. in a task) the nested loops would run on one thread, so std::sort is used as well
+template<typename T, typename Compare>
+void parallel_sort(std::vector<T> &values, Compare cmp) {
+        const int num_blocks = omp_get_max_threads();
+        if (num_blocks <= 1 || values.size() < 65536 || omp_in_parallel()) {
+                std::sort(values.begin(), values.end(), cmp);
+                return;
+        }
+
+        std::vector<size_t> bounds(num_blocks + 1);
+        for (int block = 0; block <= num_blocks; ++block) {
+                bounds[block] = values.size() * block / num_blocks;
+        }
+
+        #pragma omp parallel for
+        for (int block = 0; block < num_blocks; ++block) {
+                std::sort(values.begin() + bounds[block], values.begin() + bounds[block + 1], cmp);
+        }
+
+        for (int width = 1; width < num_blocks; width *= 2) {
+                #pragma omp parallel for
+                for (int block = 0; block < num_blocks - width; block += 2 * width) {
+                        std::inplace_merge(values.begin() + bounds[block],
+                                           values.begin() + bounds[block + width],
+                                           values.begin() + bounds[std::min(block + 2 * width, num_blocks)],
+                                           cmp);
+                }
+        }
+}
+
+template<typename T>
+void parallel_sort(std::vector<T> &values) {
+        parallel_sort(values, std::less<T>());
+}
+
+#endif /* end of include guard: PARALLEL_SORT_K3D9WQ2E */
@@ -7,8 +7,12 @@
 
 #include "random_functions.h"
 
-MersenneTwister random_functions::m_mt;
-int random_functions::m_seed = 0;
+int random_functions::m_global_seed = 0;
+std::atomic< unsigned > random_functions::m_global_generation(0);
+thread_local unsigned random_functions::m_generation = 0;
+thread_local MersenneTwister random_functions::m_mt;
+thread_local int random_functions::m_seed = 0;
+thread_local bool random_functions::m_own_stream = false;
 
 random_functions::random_functions()  {
 }
@@ -8,7 +8,9 @@
 #ifndef RANDOM_FUNCTIONS_RMEPKWYT
 #define RANDOM_FUNCTIONS_RMEPKWYT
 
+#include <atomic>
 #include <iostream>
+#include <omp.h>
 #include <random>
 #include <vector>
 
@@ -17,6 +19,10 @@
 
 typedef std::mt19937 MersenneTwister;
 
+// every thread draws from its own generator. setSeed seeds the generator of the calling
+// thread with the seed, every other thread seeds its generator with the seed plus its
+// OpenMP thread number when it draws the next time. a random_stream_guard gives a thread
+// a stream of its own that is not touched by setSeed calls of other threads.
 class random_functions {
         public:
                 random_functions();
@@ -34,11 +40,11 @@ class random_functions {
                                 std::uniform_int_distribution<unsigned int> B(0,size-1);
 
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA = A(generator());
+                                        unsigned int posB = B(generator());
 
                                         while(posB == posA) {
-                                                posB = B(m_mt);
+                                                posB = B(generator());
                                         }
 
                                         if( posA != vec[posB] && posB != vec[posA]) {
@@ -63,7 +69,7 @@ class random_functions {
                                 unsigned int size = vec.size()-4;
                                 for( unsigned int i = 0; i < size; i++) {
                                         unsigned int posA = i;
-                                        unsigned int posB = (posA + A(m_mt))%size;
+                                        unsigned int posB = (posA + A(generator()))%size;
                                         std::swap(vec[posA], vec[posB]);
                                         std::swap(vec[posA+1], vec[posB+1]); 
                                         std::swap(vec[posA+2], vec[posB+2]); 
@@ -80,8 +86,8 @@ class random_functions {
                         std::uniform_int_distribution<unsigned int> B(0,size - 4);
 
                         for( unsigned int i = 0; i < size; i++) {
-                                unsigned int posA = A(m_mt);
-                                unsigned int posB = B(m_mt);
+                                unsigned int posA = A(generator());
+                                unsigned int posB = B(generator());
                                 std::swap(vec[posA], vec[posB]); 
                                 std::swap(vec[posA+1], vec[posB+1]); 
                                 std::swap(vec[posA+2], vec[posB+2]); 
@@ -107,8 +113,8 @@ class random_functions {
                                 std::uniform_int_distribution<unsigned int> B(0,size - 4);
 
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA = A(generator());
+                                        unsigned int posB = B(generator());
                                         std::swap(vec[posA], vec[posB]); 
                                         std::swap(vec[posA+1], vec[posB+1]); 
                                         std::swap(vec[posA+2], vec[posB+2]); 
@@ -125,8 +131,8 @@ class random_functions {
                                 std::uniform_int_distribution<unsigned int> B(0,size-1);
 
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA = A(generator());
+                                        unsigned int posB = B(generator());
                                         std::swap(vec[posA], vec[posB]); 
                                 } 
                         }
@@ -151,18 +157,19 @@ class random_functions {
 
                 static bool nextBool() {
                         std::uniform_int_distribution<unsigned int> A(0,1);
-                        return (bool) A(m_mt); 
+                        return (bool) A(generator()); 
                 }
 
 
                 //including lb and rb
                 static unsigned nextInt(unsigned int lb, unsigned int rb) {
                         std::uniform_int_distribution<unsigned int> A(lb,rb);
-                        return A(m_mt); 
+                        return A(generator()); 
                 }
 
                 static double nextDouble(double lb, double rb) {
-                        double rnbr   = (double) rand() / (double) RAND_MAX; // rnd in 0,1
+                        double rnbr   = m_own_stream ? (double) generator()() / (double) MersenneTwister::max() 
+                                                     : (double) rand() / (double) RAND_MAX; // rnd in 0,1
                         double length = rb - lb;
                         rnbr         *= length;
                         rnbr         += lb;
@@ -171,14 +178,59 @@ class random_functions {
                 }
 
                 static void setSeed(int seed) {
-                        m_seed = seed;
+                        m_global_seed = seed;
+                        m_generation  = ++m_global_generation;
+                        m_seed        = seed;
+                        m_own_stream  = false;
                         srand(seed);
                         m_mt.seed(m_seed);
                 }
 
         private:
-                static int m_seed;
-                static MersenneTwister m_mt;
+                friend class random_stream_guard;
+
+                // the generator of the calling thread, reseeded if setSeed was called by another thread
+                static MersenneTwister & generator() {
+                        if( m_generation != m_global_generation && !m_own_stream ) {
+                                m_generation = m_global_generation;
+                                m_seed       = m_global_seed + omp_get_thread_num();
+                                m_mt.seed(m_seed);
+                        }
+                        return m_mt;
+                }
+
+                // the generator is per thread. rand() is shared by all threads, so a thread
+                // that got its own stream draws the doubles from its generator as well
+                static int m_global_seed;
+                static std::atomic< unsigned > m_global_generation;
+                static thread_local unsigned m_generation;
+                static thread_local int m_seed;
+                static thread_local bool m_own_stream;
+                static thread_local MersenneTwister m_mt;
+};
+
+// gives the calling thread its own deterministic stream, e.g. for a task, and
+// restores the previous stream of the thread when the guard goes out of scope
+class random_stream_guard {
+        public:
+                random_stream_guard(int seed) : m_seed(random_functions::m_seed), 
+                                                m_own_stream(random_functions::m_own_stream),
+                                                m_mt(random_functions::m_mt) {
+                        random_functions::m_seed       = seed;
+                        random_functions::m_own_stream = true;
+                        random_functions::m_mt.seed(seed);
+                }
+
+                ~random_stream_guard() {
+                        random_functions::m_seed       = m_seed;
+                        random_functions::m_own_stream = m_own_stream;
+                        random_functions::m_mt         = m_mt;
+                }
+
+        private:
+                int m_seed;
+                bool m_own_stream;
+                MersenneTwister m_mt;
 };
 
 #endif /* end of include guard: RANDOM_FUNCTIONS_RMEPKWYT */
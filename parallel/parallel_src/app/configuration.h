@@ -88,6 +88,10 @@ inline void configuration::standard( PPartitionConfig & partition_config ) {
 	partition_config.save_partition_binary 			= false;
         partition_config.vertex_degree_weights                  = false;
         partition_config.converter_evaluate                     = false;
+        partition_config.converter_output_filename              = "converted.graph";
+        partition_config.converter_memory_budget                = 1024;
+        partition_config.num_threads                            = 1;
+        partition_config.overlap_communication                  = false;
 }
 
 #endif /* end of include guard: CONFIGURATION_3APG5V7Z */
@@ -167,8 +167,8 @@ static void executeParhip(parallel_graph_access &G, PPartitionConfig &partitionC
         G.printMemoryUsage(std::cout);
 
         //compute some stats
-        EdgeWeight interPEedges = 0;
-        EdgeWeight localEdges = 0;
+        EdgeID interPEedges = 0;
+        EdgeID localEdges = 0;
         forall_local_nodes(G, node)
         {
             forall_out_edges(G, e, node)
@@ -184,8 +184,8 @@ static void executeParhip(parallel_graph_access &G, PPartitionConfig &partitionC
         }
         endfor
 
-        EdgeWeight globalInterEdges = 0;
-        EdgeWeight globalIntraEdges = 0;
+        EdgeID globalInterEdges = 0;
+        EdgeID globalIntraEdges = 0;
         MPI_Reduce(&interPEedges, &globalInterEdges, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, ROOT, communicator);
         MPI_Reduce(&localEdges, &globalIntraEdges, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, ROOT, communicator);
 
@@ -212,7 +212,7 @@ static void executeParhip(parallel_graph_access &G, PPartitionConfig &partitionC
 
         double running_time = t.elapsed();
         distributed_quality_metrics qm;
-        EdgeWeight edge_cut = qm.edge_cut(G, communicator);
+        ULONG edge_cut = qm.edge_cut(G, communicator);
         double balance = qm.balance(partitionConfig, G, communicator);
         PRINT(double
         balance_load = qm.balance_load(partitionConfig, G, communicator);)
@@ -239,11 +239,11 @@ static void executeParhip(parallel_graph_access &G, PPartitionConfig &partitionC
     while (flag) {
         std::cout << "attention: still incoming messages! rank " << rank << " from " << st.MPI_SOURCE << std::endl;
         int message_length;
-        MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+        MPI_Get_count(&st, MPI_NODEID, &message_length);
         MPI_Status rst;
         std::vector <NodeID> message;
         message.resize(message_length);
-        MPI_Recv(&message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, st.MPI_TAG, MPI_COMM_WORLD, &rst);
+        MPI_Recv(&message[0], message_length, MPI_NODEID, st.MPI_SOURCE, st.MPI_TAG, MPI_COMM_WORLD, &rst);
         MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &st);
     };
     MPI_Barrier(MPI_COMM_WORLD);
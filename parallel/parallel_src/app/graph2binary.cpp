@@ -34,15 +34,17 @@ int main(int argn, char **argv)
                 return 0;
         }
 
+        string graph_filename(argv[1]);
+        string filename(argv[2]);
+
         if( size > 1 ) {
-                std::cout <<  "currently only one process supported."  << std::endl;
+                // several processes stream the file instead of loading the whole graph on one
+                if( rank == ROOT ) std::cout <<  "Converting graph " << graph_filename  << " with " << size << " processes" << std::endl;
+                parallel_graph_io::writeGraphExternallyBinary(graph_filename, filename, MPI_COMM_WORLD);
                 MPI_Finalize();
                 return 0;
         }
 
-        string graph_filename(argv[1]);
-        string filename(argv[2]);
-
         std::cout <<  "Reading graph " << graph_filename  << std::endl;
 
         parallel_graph_access G;
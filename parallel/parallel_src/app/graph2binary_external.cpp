@@ -33,17 +33,11 @@ int main(int argn, char **argv)
                 return 0;
         }
 
-        if( size > 1 ) {
-                std::cout <<  "currently only one process supported."  << std::endl;
-                MPI_Finalize();
-                return 0;
-        }
-
         string graph_filename(argv[1]);
         string filename(argv[2]);
 
-        std::cout <<  "Reading and writing graph " << graph_filename  << std::endl;
-        parallel_graph_io::writeGraphExternallyBinary(graph_filename, filename);
+        if( rank == ROOT ) std::cout <<  "Reading and writing graph " << graph_filename  << std::endl;
+        parallel_graph_io::writeGraphExternallyBinary(graph_filename, filename, MPI_COMM_WORLD);
         
         MPI_Finalize();
         return 0;
@@ -7,6 +7,7 @@
 
 #include <argtable3.h>
 #include <iostream>
+#include <limits>
 #include <math.h>
 #include <iomanip>
 #include <mpi.h>
@@ -90,8 +91,8 @@ int main(int argn, char **argv) {
                 G.printMemoryUsage(std::cout);
 
                 //compute some stats
-                EdgeWeight interPEedges = 0;
-                EdgeWeight localEdges = 0;
+                EdgeID interPEedges = 0;
+                EdgeID localEdges = 0;
                 NodeWeight localWeight = 0;
                 forall_local_nodes(G, node) {
                         localWeight += G.getNodeWeight(node);
@@ -105,12 +106,12 @@ int main(int argn, char **argv) {
                         } endfor
                 } endfor
 
-                EdgeWeight globalInterEdges = 0;
-                EdgeWeight globalIntraEdges = 0;
+                EdgeID globalInterEdges = 0;
+                EdgeID globalIntraEdges = 0;
                 EdgeWeight globalWeight = 0;
                 MPI_Reduce(&interPEedges, &globalInterEdges, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, ROOT, communicator);
                 MPI_Reduce(&localEdges, &globalIntraEdges, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, ROOT, communicator);
-                MPI_Allreduce(&localWeight, &globalWeight, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+                MPI_Allreduce(&localWeight, &globalWeight, 1, MPI_NODEID, MPI_SUM, communicator);
 
                 if( rank == ROOT ) {
                         std::cout <<  "log> ghost edges " <<  globalInterEdges/(double)G.number_of_global_edges() << std::endl;
@@ -120,7 +121,13 @@ int main(int argn, char **argv) {
                 t.restart();
                 double epsilon = (partition_config.inbalance)/100.0;
                 if( partition_config.vertex_degree_weights ) {
-                        NodeWeight total_load = G.number_of_global_edges()+G.number_of_global_edges();
+                        // the node weights become degree+1, their sum has to fit into NodeWeight (PARHIP32BIT)
+                        if( G.number_of_global_nodes() + G.number_of_global_edges() > std::numeric_limits<NodeWeight>::max() ) {
+                                if( rank == ROOT ) std::cout <<  "total node weight is too large for 32 bit weights, use a build without PARHIP32BIT"  << std::endl;
+                                MPI_Finalize();
+                                return 0;
+                        }
+                        ULONG total_load = G.number_of_global_edges()+G.number_of_global_edges();
                         partition_config.number_of_overall_nodes = G.number_of_global_nodes();
                         partition_config.upper_bound_partition   = (1+epsilon)*ceil(total_load/(double)partition_config.k);
 
@@ -144,7 +151,7 @@ int main(int argn, char **argv) {
 
                 double running_time = t.elapsed();
                 distributed_quality_metrics qm;
-                EdgeWeight edge_cut = qm.edge_cut( G, communicator );
+                ULONG edge_cut = qm.edge_cut( G, communicator );
                 double balance  = qm.balance( partition_config, G, communicator );
                 PRINT(double balance_load  = qm.balance_load( partition_config, G, communicator );)
                 PRINT(double balance_load_dist  = qm.balance_load_dist( partition_config, G, communicator );)
@@ -169,10 +176,10 @@ int main(int argn, char **argv) {
                 while( flag ) {
                         std::cout <<  "attention: still incoming messages! rank " <<  rank <<  " from " <<  st.MPI_SOURCE << std::endl;
                         int message_length;
-                        MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                        MPI_Get_count(&st, MPI_NODEID, &message_length);
                         MPI_Status rst;
                         std::vector<NodeID> message; message.resize(message_length);
-                        MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, st.MPI_TAG, communicator, &rst); 
+                        MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, st.MPI_TAG, communicator, &rst); 
                         MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, communicator, &flag, &st);
                 };
 #endif
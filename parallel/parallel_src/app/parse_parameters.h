@@ -50,17 +50,23 @@ int parse_parameters(int argn, char **argv,
         struct arg_rex *preconfiguration               = arg_rex1(NULL, "preconfiguration", "^(ecosocial|fastsocial|ultrafastsocial|ecomesh|fastmesh|ultrafastmesh)$", "VARIANT", REG_EXTENDED, "Use a preconfiguration. (Default: fast) [ecosocial|fastsocial|ultrafastsocial|ecomesh|fastmesh|ultrafastmesh]." );
         struct arg_dbl *ht_fill_factor                 = arg_dbl0(NULL, "ht_fill_factor", NULL, "");
         struct arg_int *n                              = arg_int0(NULL, "n", NULL, "");
+        struct arg_int *num_threads                    = arg_int0(NULL, "num_threads", NULL, "Number of threads per PE used during label propagation. Default: 1.");
+        struct arg_lit *overlap_communication          = arg_lit0(NULL, "overlap_communication", "Exchange the labels of interface nodes while interior nodes are processed during label propagation. Default: disabled.");
+        struct arg_str *converter_output_filename      = arg_str0(NULL, "output_filename", "FILE", "Output file of the converter, files ending with .bgf are written in the binary format. Default: converted.graph");
+        struct arg_int *converter_memory_budget        = arg_int0(NULL, "memory_budget", NULL, "Memory in MB used for the runs of the converter. Default: 1024.");
         struct arg_end *end                            = arg_end(100);
 
-        void* argtable_fordeletion[] = {help, filename, input_partition_filename, user_seed, k, k_opt, inbalance, comm_rounds, cluster_coarsening_factor, stop_factor, evolutionary_time_limit, version, label_iterations_coarsening, label_iterations_refinement, num_tries, binary_io_window_size, initial_partitioning_algorithm, num_vcycles, no_refinement_in_last_iteration, converter_evaluate, save_partition, save_partition_binary, vertex_degree_weights, node_ordering, preconfiguration, ht_fill_factor, n, end};
+        void* argtable_fordeletion[] = {help, filename, input_partition_filename, user_seed, k, k_opt, inbalance, comm_rounds, cluster_coarsening_factor, stop_factor, evolutionary_time_limit, version, label_iterations_coarsening, label_iterations_refinement, num_tries, binary_io_window_size, initial_partitioning_algorithm, num_vcycles, no_refinement_in_last_iteration, converter_evaluate, save_partition, save_partition_binary, vertex_degree_weights, node_ordering, preconfiguration, ht_fill_factor, n, num_threads, overlap_communication, converter_output_filename, converter_memory_budget, end};
 
         // Define argtable.
         void* argtable[] = {
 #ifdef PARALLEL_LABEL_COMPRESSION
                 help, filename, user_seed, version, k, inbalance, preconfiguration, vertex_degree_weights,
-		save_partition, save_partition_binary,
+		save_partition, save_partition_binary, num_threads, overlap_communication,
 #elif defined TOOLBOX 
                 help, filename, k_opt, input_partition_filename, save_partition, save_partition_binary, converter_evaluate,
+#elif defined EDGE_LIST_CONVERTER 
+                help, filename, converter_output_filename, converter_memory_budget,
 #endif 
                  end
         };
@@ -213,6 +219,32 @@ int parse_parameters(int argn, char **argv,
                 partition_config.ht_fill_factor = ht_fill_factor->dval[0];
         }
 
+        if (num_threads->count > 0) {
+                partition_config.num_threads = num_threads->ival[0];
+        }
+
+        if (overlap_communication->count > 0) {
+                partition_config.overlap_communication = true;
+        }
+
+        if (partition_config.num_threads > 1 && partition_config.overlap_communication) {
+                int rank;
+                MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+                if( rank == ROOT ) {
+                        fprintf(stderr, "--overlap_communication is not supported with --num_threads > 1\n");
+                }
+                arg_freetable(argtable_fordeletion, sizeof(argtable_fordeletion) / sizeof(argtable_fordeletion[0]));
+                return 1;
+        }
+
+        if (converter_output_filename->count > 0) {
+                partition_config.converter_output_filename = converter_output_filename->sval[0];
+        }
+
+        if (converter_memory_budget->count > 0) {
+                partition_config.converter_memory_budget = converter_memory_budget->ival[0];
+        }
+
 
         if (evolutionary_time_limit->count > 0) {
                 int size;
@@ -68,7 +68,7 @@ int main(int argn, char **argv) {
 
         if(partition_config.converter_evaluate) {
                 distributed_quality_metrics qm;
-                EdgeWeight edge_cut = qm.edge_cut( G, communicator );
+                ULONG edge_cut = qm.edge_cut( G, communicator );
                 double balance  = qm.balance( partition_config, G, communicator );
                 double balance_load  = qm.balance_load( partition_config, G, communicator );
                 double balance_load_dist  = qm.balance_load_dist( partition_config, G, communicator );
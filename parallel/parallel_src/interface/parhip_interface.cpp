@@ -1,4 +1,5 @@
 #include <iostream>
+#include <limits>
 
 #include "parhip_interface.h"
 #include "parallel_graph_io.h"
@@ -33,8 +34,8 @@ void ParHIPPartitionKWay(idxtype *vtxdist, idxtype *xadj, idxtype *adjncy, idxty
         idxtype number_of_nodes = vtxdist[size];
 
         std::vector< NodeID > vertex_weights(local_number_of_nodes,1);
-        NodeWeight local_overall_node_weight = local_number_of_nodes;
-        NodeWeight global_node_weight = number_of_nodes;
+        ULONG local_overall_node_weight = local_number_of_nodes;
+        ULONG global_node_weight = number_of_nodes;
         if( vwgt != NULL ) {
                 local_overall_node_weight = 0;
                 global_node_weight = 0;
@@ -53,6 +54,16 @@ void ParHIPPartitionKWay(idxtype *vtxdist, idxtype *xadj, idxtype *adjncy, idxty
         unsigned long long global_number_of_edges = 0;
         MPI_Allreduce(&local_number_of_edges, &global_number_of_edges, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, *comm); 
 
+        // a build with PARHIP32BIT can only handle graphs whose node ids and total node weight fit into 32 bits,
+        // the number of edges is not limited
+        if( number_of_nodes > std::numeric_limits<NodeID>::max() 
+            || global_node_weight > std::numeric_limits<NodeWeight>::max() ) {
+                std::cout.rdbuf(backup);
+                if( rank == ROOT ) std::cerr <<  "graph has too many nodes or too much node weight for 32 bit ids, use a ParHIP build without PARHIP32BIT"  << std::endl;
+                *edgecut = -1;
+                return;
+        }
+
         parallel_graph_access G(*comm);
         G.start_construction(local_number_of_nodes, local_number_of_edges, number_of_nodes, global_number_of_edges);
         G.set_range(from, to);
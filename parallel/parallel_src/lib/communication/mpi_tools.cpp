@@ -52,11 +52,11 @@ void mpi_tools::collect_and_write_labels( MPI_Comm communicator, PPartitionConfi
                          
                         while( flag ) {
                                 int message_length;
-                                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                                MPI_Get_count(&st, MPI_NODEID, &message_length);
                                 std::vector<NodeID> message; message.resize(message_length);
 
                                 MPI_Status rst;
-                                MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, st.MPI_TAG, communicator, &rst); 
+                                MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, st.MPI_TAG, communicator, &rst); 
                                 counter++;
 
                                 for( int i = 0; i < message_length-1; i+=2) {
@@ -71,7 +71,7 @@ void mpi_tools::collect_and_write_labels( MPI_Comm communicator, PPartitionConfi
 
         } else {
                 MPI_Request rq;
-                MPI_Isend( &labels[0], labels.size(), MPI_UNSIGNED_LONG_LONG, ROOT, rank+12*size, communicator, &rq);
+                MPI_Isend( &labels[0], labels.size(), MPI_NODEID, ROOT, rank+12*size, communicator, &rq);
         }
 
         if( rank == ROOT ) {
@@ -131,11 +131,11 @@ void mpi_tools::collect_parallel_graph_to_local_graph( MPI_Comm communicator, PP
                         while(!flag) { MPI_Iprobe(i, 13*size, communicator, &flag, &st); }
                                 
                         int message_length;
-                        MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                        MPI_Get_count(&st, MPI_NODEID, &message_length);
                         std::vector<NodeID> rmessage; rmessage.resize(message_length);
 
                         MPI_Status rst;
-                        MPI_Recv( &rmessage[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, st.MPI_TAG, communicator, &rst); 
+                        MPI_Recv( &rmessage[0], message_length, MPI_NODEID, st.MPI_SOURCE, st.MPI_TAG, communicator, &rst); 
                         
                         NodeID no_nodes = rmessage[0];
                         NodeID pos = 1;
@@ -154,7 +154,7 @@ void mpi_tools::collect_parallel_graph_to_local_graph( MPI_Comm communicator, PP
                 }
         } else {
                 MPI_Request rq; 
-                MPI_Isend( &message[0], message.size(), MPI_UNSIGNED_LONG_LONG, ROOT, 13*size, communicator, &rq);
+                MPI_Isend( &message[0], message.size(), MPI_NODEID, ROOT, 13*size, communicator, &rq);
         }
 
         if( rank == ROOT ) {
@@ -251,8 +251,8 @@ void mpi_tools::alltoallv( void * sendbuf,
                         rdispl[i] = rdispls[i];
                 }
 
-                MPI_Alltoallv(sendbuf, sbktsize, sdispl, MPI_UNSIGNED_LONG_LONG, 
-                              recvbuf, rbktsize, rdispl, MPI_UNSIGNED_LONG_LONG, communicator);
+                MPI_Alltoallv(sendbuf, sbktsize, sdispl, sendtype, 
+                              recvbuf, rbktsize, rdispl, recvtype, communicator);
         } else {
                 if( rank == ROOT ) { std::cout <<  "special case all to all with counts > sizeof(int)! not tested yet!"  << std::endl; exit(0);}
         }
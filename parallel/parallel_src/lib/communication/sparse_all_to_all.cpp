@@ -0,0 +1,75 @@
+/******************************************************************************
+ * sparse_all_to_all.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include "sparse_all_to_all.h"
+
+sparse_all_to_all::sparse_all_to_all() {
+                
+}
+
+sparse_all_to_all::~sparse_all_to_all() {
+                
+}
+
+void sparse_all_to_all::exchange( MPI_Comm communicator,
+                                  const std::vector< std::vector< NodeID > > & send_buffers,
+                                  std::vector< std::vector< NodeID > > & recv_buffers,
+                                  int tag_factor ) {
+        PEID rank, size;
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
+
+        recv_buffers.clear();
+        recv_buffers.resize(size);
+        recv_buffers[rank] = send_buffers[rank];
+
+        // synchronous sends complete only after the receiver has matched them
+        std::vector< MPI_Request > requests;
+        for( PEID peID = 0; peID < size; peID++) {
+                if( peID == rank || send_buffers[peID].empty() ) continue;
+
+                MPI_Request rq;
+                MPI_Issend( const_cast< NodeID* >(&send_buffers[peID][0]),
+                            send_buffers[peID].size(),
+                            MPI_NODEID,
+                            peID, peID+tag_factor*size, communicator, &rq);
+                requests.push_back(rq);
+        }
+
+        int tag                  = rank+tag_factor*size;
+        bool barrier_active      = false;
+        int  done                = 0;
+        MPI_Request barrier_request;
+        while( !done ) {
+                int has_message = 0;
+                MPI_Status st;
+                MPI_Iprobe(MPI_ANY_SOURCE, tag, communicator, &has_message, &st);
+                if( has_message ) {
+                        int message_length;
+                        MPI_Get_count(&st, MPI_NODEID, &message_length);
+
+                        std::vector< NodeID > & message = recv_buffers[st.MPI_SOURCE];
+                        message.resize(message_length);
+
+                        MPI_Status rst;
+                        MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, tag, communicator, &rst); 
+                }
+
+                if( barrier_active ) {
+                        MPI_Test( &barrier_request, &done, MPI_STATUS_IGNORE);
+                } else {
+                        int all_sent = 1;
+                        if( !requests.empty() ) {
+                                MPI_Testall( requests.size(), &requests[0], &all_sent, MPI_STATUSES_IGNORE);
+                        }
+                        if( all_sent ) {
+                                MPI_Ibarrier( communicator, &barrier_request );
+                                barrier_active = true;
+                        }
+                }
+        }
+}
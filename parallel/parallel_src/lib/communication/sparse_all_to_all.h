@@ -0,0 +1,39 @@
+/******************************************************************************
+ * sparse_all_to_all.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef SPARSE_ALL_TO_ALL_V3LQ7Z1K
+#define SPARSE_ALL_TO_ALL_V3LQ7Z1K
+
+#include <mpi.h>
+#include <vector>
+
+#include "definitions.h"
+
+// irregular exchange in which a PE only talks to the PEs it actually has data for.
+// the receivers do not know their senders in advance, hence the termination is
+// detected by a nonblocking barrier that a PE enters once all of its synchronous
+// sends have been matched (NBX). no empty messages are exchanged, so the number
+// of messages is proportional to the number of communication partners and not to p^2.
+class sparse_all_to_all {
+public:
+        sparse_all_to_all();
+        virtual ~sparse_all_to_all();
+
+        // sends send_buffers[peID] to every PE with a non-empty buffer.
+        // afterwards recv_buffers[peID] contains the message of peID (or is empty),
+        // the own buffer send_buffers[rank] is copied to recv_buffers[rank].
+        // messages are sent with tag peID+tag_factor*size as in the rest of the code.
+        // two consecutive exchanges on the same communicator have to use different
+        // tag factors unless they are separated by a collective operation.
+        void exchange( MPI_Comm communicator,
+                       const std::vector< std::vector< NodeID > > & send_buffers,
+                       std::vector< std::vector< NodeID > > & recv_buffers,
+                       int tag_factor );
+};
+
+
+#endif /* end of include guard: SPARSE_ALL_TO_ALL_V3LQ7Z1K */
@@ -36,5 +36,5 @@ void balance_management_refinement::init() {
 
 void balance_management_refinement::update() {
         MPI_Allreduce(&m_local_block_weights[0], &m_total_block_weights[0], 
-                       m_total_num_labels, MPI_UNSIGNED_LONG_LONG, MPI_SUM, m_G->getCommunicator());
+                       m_total_num_labels, MPI_NODEID, MPI_SUM, m_G->getCommunicator());
 }
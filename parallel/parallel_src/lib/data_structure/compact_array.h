@@ -0,0 +1,86 @@
+/******************************************************************************
+ * compact_array.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef COMPACT_ARRAY_4KQ8ZT1B
+#define COMPACT_ARRAY_4KQ8ZT1B
+
+#include <limits>
+#include <vector>
+
+#include "definitions.h"
+
+// array of unsigned integers that uses 32 bits per entry as long as all stored
+// values fit and switches to 64 bits per entry once a larger value is stored
+class compact_array {
+public:
+        compact_array() : m_wide(false) {};
+        virtual ~compact_array() {};
+
+        inline ULONG operator[]( ULONG i ) const {
+                return m_wide ? m_wide_data[i] : m_narrow_data[i];
+        }
+
+        inline void set( ULONG i, ULONG value ) {
+                if( !m_wide && value > std::numeric_limits<UINT>::max() ) {
+                        widen();
+                }
+                if( m_wide ) {
+                        m_wide_data[i] = value;
+                } else {
+                        m_narrow_data[i] = (UINT)value;
+                }
+        }
+
+        inline void push_back( ULONG value ) {
+                if( !m_wide && value > std::numeric_limits<UINT>::max() ) {
+                        widen();
+                }
+                if( m_wide ) {
+                        m_wide_data.push_back(value);
+                } else {
+                        m_narrow_data.push_back((UINT)value);
+                }
+        }
+
+        void resize( ULONG n ) {
+                if( m_wide ) {
+                        m_wide_data.resize(n);
+                } else {
+                        m_narrow_data.resize(n);
+                }
+        }
+
+        // releases all memory and starts over with 32 bit entries
+        void clear() {
+                std::vector<UINT>().swap(m_narrow_data);
+                std::vector<ULONG>().swap(m_wide_data);
+                m_wide = false;
+        }
+
+        ULONG size() const {
+                return m_wide ? m_wide_data.size() : m_narrow_data.size();
+        }
+
+        // number of bytes used by the entries
+        ULONG memory() const {
+                return m_wide ? m_wide_data.size()*sizeof(ULONG) : m_narrow_data.size()*sizeof(UINT);
+        }
+
+private:
+        void widen() {
+                m_wide_data.assign(m_narrow_data.begin(), m_narrow_data.end());
+                std::vector<UINT>().swap(m_narrow_data);
+                m_wide = true;
+        }
+
+        bool               m_wide;
+        std::vector<UINT>  m_narrow_data;
+        std::vector<ULONG> m_wide_data;
+};
+
+
+#endif /* end of include guard: COMPACT_ARRAY_4KQ8ZT1B */
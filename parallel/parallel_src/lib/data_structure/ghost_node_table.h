@@ -0,0 +1,85 @@
+/******************************************************************************
+ * ghost_node_table.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef GHOST_NODE_TABLE_7HQ2M5XA
+#define GHOST_NODE_TABLE_7HQ2M5XA
+
+#include <limits>
+#include <vector>
+
+#include "definitions.h"
+
+const NodeID NOT_A_GHOST = std::numeric_limits<NodeID>::max();
+
+// open addressing table global id -> local id of ghost nodes.
+// it is only used while a graph is constructed, afterwards ghost nodes are
+// sorted by owning PE and global id and looked up in these arrays.
+class ghost_node_table {
+public:
+        ghost_node_table() : m_size(0) {};
+        virtual ~ghost_node_table() {};
+
+        // returns the local id of global_id or NOT_A_GHOST if it is not contained
+        NodeID find( NodeID global_id ) const {
+                if( m_keys.empty() ) return NOT_A_GHOST;
+                for( NodeID pos = hash(global_id);; pos = (pos + 1) & m_mask) {
+                        if( m_keys[pos] == global_id )   return m_values[pos];
+                        if( m_keys[pos] == NOT_A_GHOST ) return NOT_A_GHOST;
+                }
+        }
+
+        void insert( NodeID global_id, NodeID local_id ) {
+                if( 2*(m_size+1) > m_keys.size() ) {
+                        grow();
+                }
+                NodeID pos = hash(global_id);
+                while( m_keys[pos] != NOT_A_GHOST ) {
+                        pos = (pos + 1) & m_mask;
+                }
+                m_keys[pos]   = global_id;
+                m_values[pos] = local_id;
+                m_size++;
+        }
+
+        // releases all memory
+        void clear() {
+                std::vector<NodeID>().swap(m_keys);
+                std::vector<NodeID>().swap(m_values);
+                m_size = 0;
+        }
+
+private:
+        NodeID hash( NodeID key ) const {
+                // fibonacci hashing, consecutive global ids are spread over the table
+                return (NodeID)((key * 11400714819323198485ULL) >> 20) & m_mask;
+        }
+
+        void grow() {
+                std::vector<NodeID> old_keys;   old_keys.swap(m_keys);
+                std::vector<NodeID> old_values; old_values.swap(m_values);
+
+                NodeID capacity = old_keys.empty() ? 1024 : 2*old_keys.size();
+                m_keys.assign(capacity, NOT_A_GHOST);
+                m_values.resize(capacity);
+                m_mask = capacity - 1;
+                m_size = 0;
+
+                for( NodeID i = 0; i < old_keys.size(); i++) {
+                        if( old_keys[i] != NOT_A_GHOST ) {
+                                insert( old_keys[i], old_values[i] );
+                        }
+                }
+        }
+
+        std::vector<NodeID> m_keys;
+        std::vector<NodeID> m_values;
+        NodeID m_mask;
+        NodeID m_size;
+};
+
+
+#endif /* end of include guard: GHOST_NODE_TABLE_7HQ2M5XA */
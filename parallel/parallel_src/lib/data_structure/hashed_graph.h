@@ -8,44 +8,114 @@
 #ifndef HASHED_GRAPH_DG1JG7O0
 #define HASHED_GRAPH_DG1JG7O0
 
-#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "definitions.h"
-#include "limits.h"
 
+const NodeID EMPTY_HASHED_EDGE = std::numeric_limits<NodeID>::max();
+
+// one slot of the table. an undirected edge is stored with source < target,
+// the weight of a node is stored in the slot source == target == node.
 struct hashed_edge {
-        NodeID k;
         NodeID source;
         NodeID target;
+        NodeWeight weight;
 };
 
+// open addressing table that aggregates the weights of the edges and nodes
+// of a quotient graph. the table is allocated once for an upper bound on the
+// number of distinct entries and only grows if that bound was too small.
+class hashed_graph {
+public:
+        hashed_graph( ULONG max_entries ) : m_size(0) {
+                ULONG capacity = 1024;
+                while( 3*capacity < 4*max_entries ) capacity *= 2; // load factor at most 3/4
+                allocate(capacity);
+        };
+        virtual ~hashed_graph() {};
 
-struct compare_hashed_edge {
-        bool operator()(const hashed_edge e_1, const hashed_edge e_2) const {
-                bool eq = (e_1.source == e_2.source && e_1.target == e_2.target);
-                     eq = eq || (e_1.source == e_2.target && e_1.target == e_2.source); 
-                return eq;
+        void add_edge_weight( NodeID source, NodeID target, EdgeWeight weight ) {
+                if( source < target ) {
+                        add_weight( source, target, weight );
+                } else {
+                        add_weight( target, source, weight );
+                }
         }
-};
 
-struct data_hashed_edge{
-        NodeWeight weight;
+        void add_node_weight( NodeID node, NodeWeight weight ) {
+                add_weight( node, node, weight );
+        }
 
-        data_hashed_edge() {
-                weight = 0;
+        // the slots of the table, empty slots have source == EMPTY_HASHED_EDGE
+        const std::vector< hashed_edge > & slots() const {
+                return m_slots;
         }
-};
 
-struct hash_hashed_edge {
-       ULONG operator()(const hashed_edge e) const {
-                if(e.source < e.target) 
-                        return e.source*e.k + e.target;
-                else 
-                        return e.target*e.k + e.source;
-       }
-};
+        static bool is_node( const hashed_edge & e ) {
+                return e.source == e.target;
+        }
 
-typedef std::unordered_map<const hashed_edge, data_hashed_edge, hash_hashed_edge, compare_hashed_edge> hashed_graph;
+        ULONG size() const {
+                return m_size;
+        }
+
+        // releases all memory
+        void clear() {
+                std::vector< hashed_edge >().swap(m_slots);
+                m_size = 0;
+        }
+
+private:
+        void add_weight( NodeID source, NodeID target, NodeWeight weight ) {
+                if( 4*(m_size+1) > 3*m_slots.size() ) {
+                        grow();
+                }
+                ULONG pos = hash(source, target);
+                while( m_slots[pos].source != EMPTY_HASHED_EDGE ) {
+                        if( m_slots[pos].source == source && m_slots[pos].target == target ) {
+                                m_slots[pos].weight += weight;
+                                return;
+                        }
+                        pos = (pos + 1) & m_mask;
+                }
+                m_slots[pos].source = source;
+                m_slots[pos].target = target;
+                m_slots[pos].weight = weight;
+                m_size++;
+        }
+
+        ULONG hash( NodeID source, NodeID target ) const {
+                // fibonacci hashing, the top bits of the product select the slot
+                ULONG key = (source * 11400714819323198485ULL) ^ target;
+                return (key * 11400714819323198485ULL) >> m_shift;
+        }
+
+        void allocate( ULONG capacity ) {
+                hashed_edge empty = { EMPTY_HASHED_EDGE, EMPTY_HASHED_EDGE, 0 };
+                m_slots.assign(capacity, empty);
+                m_mask  = capacity - 1;
+                m_shift = 64;
+                for( ULONG c = capacity; c > 1; c /= 2) m_shift--;
+                m_size  = 0;
+        }
+
+        void grow() {
+                std::vector< hashed_edge > old_slots; old_slots.swap(m_slots);
+                allocate( std::max( (ULONG)1024, 2*(ULONG)old_slots.size() ) );
+                for( ULONG i = 0; i < old_slots.size(); i++) {
+                        if( old_slots[i].source != EMPTY_HASHED_EDGE ) {
+                                add_weight( old_slots[i].source, old_slots[i].target, old_slots[i].weight );
+                        }
+                }
+        }
+
+        std::vector< hashed_edge > m_slots;
+        ULONG m_mask;
+        unsigned m_shift;
+        ULONG m_size;
+};
 
 
 #endif /* end of include guard: HASHED_GRAPH_DG1JG7O0 */
@@ -5,6 +5,8 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <algorithm>
+
 #include "balance_management_coarsening.h"
 #include "balance_management_refinement.h"
 #include "parallel_graph_access.h"
@@ -33,6 +35,100 @@ parallel_graph_access::~parallel_graph_access() {
         if ( m_bm ) delete m_bm;
 }
 
+void parallel_graph_access::sort_ghost_nodes() {
+        NodeID num_ghosts = m_add_non_local_node_data.size();
+        m_ghost_offsets.assign(size+1, 0);
+
+        std::vector<PEID> ghost_pe(num_ghosts);
+        for( NodeID i = 0; i < num_ghosts; i++) {
+                ghost_pe[i] = getTargetPE(m_ghost_adddata_array_offset + i);
+                m_ghost_offsets[ghost_pe[i]+1]++;
+        }
+        for( PEID peID = 0; peID < size; peID++) {
+                m_ghost_offsets[peID+1] += m_ghost_offsets[peID];
+        }
+
+        // bucket ghosts by PE, then sort every bucket by global id
+        std::vector<NodeID> order(num_ghosts);
+        std::vector<NodeID> next(m_ghost_offsets.begin(), m_ghost_offsets.end()-1);
+        for( NodeID i = 0; i < num_ghosts; i++) {
+                order[next[ghost_pe[i]]++] = i;
+        }
+        for( PEID peID = 0; peID < size; peID++) {
+                std::sort(order.begin() + m_ghost_offsets[peID], order.begin() + m_ghost_offsets[peID+1],
+                          [&](const NodeID & lhs, const NodeID & rhs) {
+                                return m_add_non_local_node_data[lhs].globalID < m_add_non_local_node_data[rhs].globalID;
+                          });
+        }
+
+        std::vector<NodeID> new_position(num_ghosts);
+        std::vector<AdditionalNonLocalNodeData> add_data(num_ghosts);
+        for( NodeID i = 0; i < num_ghosts; i++) {
+                new_position[order[i]] = i;
+                add_data[i]            = m_add_non_local_node_data[order[i]];
+        }
+        m_add_non_local_node_data.swap(add_data);
+
+#ifdef COMPACT_PARHIP
+        compact_array* ghost_columns[] = { &m_node_labels, &m_node_blocks, &m_node_weights };
+        std::vector<NodeID> ghost_data(num_ghosts);
+        for( compact_array* column : ghost_columns ) {
+                for( NodeID i = 0; i < num_ghosts; i++) {
+                        ghost_data[i] = (*column)[m_ghost_adddata_array_offset + order[i]];
+                }
+                for( NodeID i = 0; i < num_ghosts; i++) {
+                        column->set(m_ghost_adddata_array_offset + i, ghost_data[i]);
+                }
+        }
+#else
+        std::vector<NodeData> ghost_data(num_ghosts);
+        for( NodeID i = 0; i < num_ghosts; i++) {
+                ghost_data[i] = m_nodes_data[m_ghost_adddata_array_offset + order[i]];
+        }
+        std::copy(ghost_data.begin(), ghost_data.end(), m_nodes_data.begin() + m_ghost_adddata_array_offset);
+#endif
+
+        forall_local_edges((*this), e) {
+                NodeID target = getEdgeTarget(e);
+                if( target >= m_ghost_adddata_array_offset ) {
+                        setEdgeTarget(e, m_ghost_adddata_array_offset + new_position[target - m_ghost_adddata_array_offset]);
+                }
+        } endfor
+}
+
+void parallel_graph_access::compute_send_positions() {
+        std::vector<NodeID> next_position(size, 0);
+        std::vector<bool>   packed(size, false);
+
+        // only the interface nodes get an entry
+        m_send_nodes.clear();
+        m_send_position_offsets.clear();
+        m_send_pes.clear();
+        m_send_ghost_positions.clear();
+        forall_local_nodes((*this), node) {
+                NodeID begin = m_send_pes.size();
+                forall_out_edges((*this), e, node) {
+                        NodeID target = getEdgeTarget(e);
+                        if( !is_local_node(target) ) {
+                                PEID peID = getTargetPE(target);
+                                if( !packed[peID] ) { // make sure a node is sent at most once
+                                        m_send_pes.push_back(peID);
+                                        m_send_ghost_positions.push_back(next_position[peID]++);
+                                        packed[peID] = true;
+                                }
+                        }
+                } endfor
+                if( begin == m_send_pes.size() ) continue;
+
+                m_send_nodes.push_back(node);
+                m_send_position_offsets.push_back(begin);
+                for( NodeID i = begin; i < m_send_pes.size(); i++) {
+                        packed[m_send_pes[i]] = false;
+                }
+        } endfor
+        m_send_position_offsets.push_back(m_send_pes.size());
+}
+
 void parallel_graph_access::init_balance_management( PPartitionConfig & config ) {
         if( m_bm != NULL ) {
                 delete m_bm;
@@ -63,6 +159,18 @@ void parallel_graph_access::update_ghost_node_data_finish() {
         m_gnc->update_ghost_node_data_finish();
 }
 
+void parallel_graph_access::post_ghost_node_data() {
+        m_gnc->post_ghost_node_data();
+}
+
+void parallel_graph_access::poll_ghost_node_data() {
+        m_gnc->poll_ghost_node_data();
+}
+
+void parallel_graph_access::finish_ghost_node_data() {
+        m_gnc->finish_ghost_node_data();
+}
+
 void parallel_graph_access::set_comm_rounds(ULONG comm_rounds) {
         m_comm_rounds = comm_rounds;
         set_comm_rounds_up(comm_rounds);
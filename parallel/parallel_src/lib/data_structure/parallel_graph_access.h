@@ -9,19 +9,23 @@
 #define PARALLEL_GRAPH_ACCESS_X6O9MRS8
 
 
+#include <algorithm>
 #include <mpi.h>
-#include <unordered_map>
 #include <iostream>
 #include <ostream>
 #include <fstream>
 #include <vector>
 
 #include "data_structure/balance_management.h"
+#include "data_structure/compact_array.h"
+#include "data_structure/ghost_node_table.h"
 #include "definitions.h"
 #include "partition_config.h"
 #include "tools/timer.h"
 
-struct Node {
+// the sequential graph_access of KaHIP is linked into the same binaries and defines
+// its own Node and Edge, so these need different names
+struct ParallelNode {
     EdgeID firstEdge;
 };
 struct NodeData {
@@ -31,24 +35,21 @@ struct NodeData {
     bool       is_interface_node; // save a little bit of memory
 };
 
-//struct NodeData {
-    //NodeID     label;
-    //PartitionID block:15; // a given partition of the graph (for v-cycles)
-    //NodeWeight weight:47; // save a little bit of memory
-    //bool       is_interface_node:1; // save a little bit of memory
-//};
-
-//struct AdditionalNonLocalNodeData {
-    //PEID   peID:15; // save a little bit of memory
-    //NodeID globalID:48;
-//};
-
+// with COMPACT_PARHIP the node data is stored column wise instead: labels, blocks and
+// weights in compact arrays, the interface flags in a bit vector, and ghost nodes
+// do not store their PE since it is found by a binary search in the range array
+#ifdef COMPACT_PARHIP
+struct AdditionalNonLocalNodeData {
+    NodeID globalID;
+};
+#else
 struct AdditionalNonLocalNodeData {
     PEID   peID; // save a little bit of memory
     NodeID globalID;
 };
+#endif
 
-struct Edge {
+struct ParallelEdge {
     NodeID     local_target;
     EdgeWeight weight;
 };
@@ -65,16 +66,14 @@ class parallel_graph_access;
 //handle communication of data associated with ghost nodes
 class ghost_node_communication {
 public:
-        ghost_node_communication(MPI_Comm communicator) : m_iteration_counter(0), m_first_send(true) {
+        ghost_node_communication(MPI_Comm communicator) : m_iteration_counter(0), m_first_send(true), m_overlap_received(0), m_overlap_tag_factor(15) {
                 m_communicator     = communicator;
 
                 MPI_Comm_rank( m_communicator, &m_rank);
                 MPI_Comm_size( m_communicator, &m_size);
                 
-                m_PE_packed.resize(m_size); 
                 m_adjacent_processors.resize(m_size); 
-                for( PEID peID = 0; peID < (PEID) m_PE_packed.size(); peID++) {
-                        m_PE_packed[ peID ]           = false;
+                for( PEID peID = 0; peID < (PEID) m_adjacent_processors.size(); peID++) {
                         m_adjacent_processors[ peID ] = false;
                 }
 
@@ -131,6 +130,18 @@ public:
         inline 
         void update_ghost_node_data_global();
 
+        // non-blocking variant used to overlap the label exchange with computation:
+        // post sends the labels of the interface nodes changed so far, poll integrates
+        // the messages that have already arrived and finish waits for the remaining ones
+        inline 
+        void post_ghost_node_data();
+
+        inline 
+        void poll_ghost_node_data();
+
+        inline 
+        void finish_ghost_node_data();
+
         inline
         void addLabel(NodeID node, NodeID label);
 
@@ -153,6 +164,9 @@ private:
         inline 
         void receive_messages_of_neighbors();
 
+        inline 
+        void receive_and_integrate_message( MPI_Status & st, int tag );
+
         parallel_graph_access * m_G;
         PEID m_size;
         PEID m_rank;
@@ -171,7 +185,11 @@ private:
         // store the number of adjacent processors ( a block is a neighbor iff there is an edge between the subgraphs )
         PEID m_num_adjacent; 
 
-        std::vector< bool >                   m_PE_packed;
+        // number of messages received since the last post_ghost_node_data.
+        // a neighbor can be one exchange ahead, so consecutive exchanges alternate between two tags
+        PEID m_overlap_received;
+        int  m_overlap_tag_factor;
+
         std::vector< std::vector< NodeID > >  m_send_buffers_A; // buffers to send messages
         std::vector< std::vector< NodeID > >  m_send_buffers_B; // buffers to send messages
         std::vector< std::vector< NodeID > >* m_send_buffers_ptr; // pointer to current buffers to send messages
@@ -206,7 +224,7 @@ public:
         /* ============================================================= */
         /* build methods */
         /* ============================================================= */
-        void start_construction(NodeID n, EdgeID m, NodeID global_n, NodeID global_m, bool update_comm_rounds = true) {
+        void start_construction(NodeID n, EdgeID m, NodeID global_n, EdgeID global_m, bool update_comm_rounds = true) {
                 m_building_graph             = true;
                 node                         = 0;
                 e                            = 0;
@@ -221,10 +239,12 @@ public:
 
                 //resizes property arrays
                 m_nodes.resize(n+1);
-                m_nodes_data.resize(n+1);
-                m_edges.resize(m);
+                resize_node_data(n+1);
+                resize_edges(m);
 
                 m_nodes[node].firstEdge = e;
+                m_ghost_table.clear();
+                m_add_non_local_node_data.clear();
                 m_divisor = ceil(global_n / (double)size);
                 // every PE has to make same amount communication iterations 
                 // we use ceil an check afterwards wether everyone has done the right 
@@ -266,13 +286,11 @@ public:
         };
 
         PEID get_PEID_from_range_array(NodeID node) {
-                // TODO optimize with binary search
-                for( PEID peID = 1; peID < (PEID)m_range_array.size(); peID++) {
-                        if( node < m_range_array[peID] ) {
-                                return (peID-1);
-                        }
+                std::vector<NodeID>::iterator it = std::upper_bound(m_range_array.begin(), m_range_array.end(), node);
+                if( it == m_range_array.end() ) {
+                        return -1;
                 }
-                return -1;
+                return (PEID)(it - m_range_array.begin()) - 1;
         };
 
         NodeID new_node() {
@@ -283,44 +301,42 @@ public:
 
         EdgeID new_edge(NodeID source, NodeID target) {
                 ASSERT_TRUE(m_building_graph);
-                ASSERT_TRUE(e < m_edges.size());
+                ASSERT_TRUE(e < number_of_local_edges());
 
                 // build ghost nodes on the fly
                 if( from <= target && target <= to) {
-                        m_edges[e].local_target = target - from; 
+                        setEdgeTarget(e, target - from); 
                 } else {
-                        m_nodes_data[source].is_interface_node = true;
+                        set_interface_node(source);
 
                         // check wether this is already a ghost node
-                        if(m_global_to_local_id.find(target) != m_global_to_local_id.end()) {
+                        NodeID ghost = m_ghost_table.find(target);
+                        if( ghost != NOT_A_GHOST ) {
                                 // this node is already a ghost node
-                                m_edges[e].local_target = m_global_to_local_id[target]; 
+                                setEdgeTarget(e, ghost); 
                         } else {
                                 // we need to create a new ghost node
-                                m_global_to_local_id[target] = m_num_nodes++;
-                                m_edges[e].local_target      = m_global_to_local_id[target]; 
+                                m_ghost_table.insert(target, m_num_nodes);
+                                setEdgeTarget(e, m_num_nodes++);
 
                                 //create the ghost node in the array
-                                Node dummy;
+                                ParallelNode dummy;
                                 dummy.firstEdge = 0;
                                 m_nodes.push_back(dummy);
-
-                                NodeData dummy_data; 
-                                dummy_data.label             = target;
-                                dummy_data.block             = 0;
-                                dummy_data.is_interface_node = false;
-                                dummy_data.weight            = 1;
-                                m_nodes_data.push_back(dummy_data);
+                                push_ghost_node_data(target);
 
                                 // add addtional data
                                 AdditionalNonLocalNodeData add_data;
                                 //has to be changed once we implement better load balancing 
                                 //add_data.peID     = target / m_divisor; 
-                                add_data.peID     = get_PEID_from_range_array(target);
+                                PEID peID         = get_PEID_from_range_array(target);
+#ifndef COMPACT_PARHIP
+                                add_data.peID     = peID;
+#endif
                                 add_data.globalID = target;
 
                                 m_add_non_local_node_data.push_back(add_data);
-                                m_gnc->add_adjacent_processor(add_data.peID);
+                                m_gnc->add_adjacent_processor(peID);
                         }
                 }
 
@@ -347,7 +363,7 @@ public:
 
 
         void finish_construction() {
-                m_edges.resize(e);
+                resize_edges(e);
                 m_building_graph = false;
 
                 //fill isolated sources at the end
@@ -358,6 +374,10 @@ public:
                         }
                 }
 
+                sort_ghost_nodes();
+                compute_send_positions();
+                m_ghost_table.clear();
+
                 m_gnc->init();
         };
 
@@ -382,7 +402,13 @@ public:
         NodeID number_of_local_nodes() {return m_num_local_nodes;};
         NodeID number_of_ghost_nodes() {return m_nodes.size() - m_num_local_nodes - 1;};
         NodeID number_of_global_nodes() {return m_global_n;};
-        EdgeID number_of_local_edges() {return m_edges.size();};
+        EdgeID number_of_local_edges() {
+#ifdef COMPACT_PARHIP
+                return m_edge_targets.size();
+#else
+                return m_edges.size();
+#endif
+        };
         EdgeID number_of_global_edges() {return m_global_m;};
         void set_number_of_global_edges( EdgeID global_edges) {m_global_m = global_edges;};
 
@@ -444,11 +470,31 @@ public:
         NodeID getLocalID(NodeID node) {
                 if( from <= node && node <= to ) {
                         return node - from;
+                } else if( m_building_graph ) {
+                        return m_ghost_table.find(node);
                 } else {
-                        return m_global_to_local_id[node];
+                        return getGhostLocalID(get_PEID_from_range_array(node), node);
                 }
         };
 
+        //input is a global id of a ghost node owned by peID
+        //output is the local id
+        NodeID getGhostLocalID(PEID peID, NodeID node) {
+                std::vector<AdditionalNonLocalNodeData>::iterator begin = m_add_non_local_node_data.begin() + m_ghost_offsets[peID];
+                std::vector<AdditionalNonLocalNodeData>::iterator end   = m_add_non_local_node_data.begin() + m_ghost_offsets[peID+1];
+                std::vector<AdditionalNonLocalNodeData>::iterator it    = std::lower_bound(begin, end, node, compare_global_id);
+                ASSERT_TRUE(it != end && it->globalID == node);
+
+                return m_ghost_adddata_array_offset + (it - m_add_non_local_node_data.begin());
+        };
+
+        //input is the position of a ghost node within the ghost nodes of peID, as sent by peID
+        //output is the local id
+        NodeID getGhostLocalIDByPosition(PEID peID, NodeID position) {
+                ASSERT_LT(m_ghost_offsets[peID] + position, m_ghost_offsets[peID+1]);
+                return m_ghost_adddata_array_offset + m_ghost_offsets[peID] + position;
+        };
+
         //methods for local nodes only
         NodeID getGlobalID(NodeID node);
 
@@ -470,6 +516,10 @@ public:
         void update_ghost_node_data_finish();
         void update_ghost_node_data_global();
 
+        void post_ghost_node_data();
+        void poll_ghost_node_data();
+        void finish_ghost_node_data();
+
         static void set_comm_rounds(ULONG comm_rounds); 
         static void set_comm_rounds_up(ULONG comm_rounds); 
 
@@ -480,17 +530,43 @@ public:
 #ifndef NOOUTPUT
                 out << "** approx. local memory usage on hard disk per node [MB (bytes per node)] **" << std::endl;
 
-                unsigned int memoryTotal = 0;
-                memoryTotal += printMemoryUsage(out, "nodes", (m_nodes.size()-1) * (sizeof(Node)+sizeof(NodeData)+sizeof(NodeID)+sizeof(AdditionalNonLocalNodeData)));
-                memoryTotal += printMemoryUsage(out, "edges", (m_edges.size()-1) * sizeof(Edge));
+                ULONG num_nodes     = m_nodes.size();
+                ULONG num_ghosts    = m_add_non_local_node_data.size();
+                ULONG node_memory   = num_nodes * sizeof(ParallelNode) + m_nodes_to_cnode.size() * sizeof(NodeID) 
+                                      + num_ghosts * sizeof(AdditionalNonLocalNodeData);
+#ifdef COMPACT_PARHIP
+                node_memory        += m_node_labels.memory() + m_node_blocks.memory() + m_node_weights.memory()
+                                      + (m_interface_nodes.size()+7)/8;
+                ULONG num_edges     = m_edge_targets.size();
+                ULONG edge_memory   = m_edge_targets.memory() + m_edge_weights.memory();
+#else
+                node_memory        += m_nodes_data.size() * sizeof(NodeData);
+                ULONG num_edges     = m_edges.size();
+                ULONG edge_memory   = num_edges * sizeof(ParallelEdge);
+#endif
+
+                ULONG send_memory   = (m_send_nodes.size() + m_send_position_offsets.size() + m_send_ghost_positions.size()) * sizeof(NodeID)
+                                      + m_send_pes.size() * sizeof(PEID);
+
+                ULONG memoryTotal = 0;
+                memoryTotal += printMemoryUsage(out, "nodes", node_memory);
+                memoryTotal += printMemoryUsage(out, "edges", edge_memory);
+                memoryTotal += printMemoryUsage(out, "ghost update positions", send_memory);
 
                 printMemoryUsage(out, "TOTAL", memoryTotal);
+#ifdef COMPACT_PARHIP
+                // the standard layout stores label, block, weight and interface flag in 64 bits each,
+                // target and weight of an edge in 64 bits each and the PE of a ghost node
+                ULONG standard_memory = num_nodes * (sizeof(ParallelNode) + 4*sizeof(NodeID)) + m_nodes_to_cnode.size() * sizeof(NodeID) 
+                                        + num_ghosts * 2*sizeof(NodeID) + num_edges * 2*sizeof(NodeID) + send_memory;
+                printMemoryUsage(out, "saved by compact layout", standard_memory - memoryTotal);
+#endif
                 out << std::endl;
 #endif
         }
 
         /** Prints the memory usage of one particular data structure of this UpdateableGraph. */
-        unsigned int printMemoryUsage(std::ostream& out, const std::string descr, const unsigned int mem) const {
+        ULONG printMemoryUsage(std::ostream& out, const std::string descr, const ULONG mem) const {
 #ifndef NOOUTPUT
                 unsigned int megaBytes = (unsigned int)((mem / (double)(1024*1024)) + 0.5);
                 unsigned int bytesPerNode = (unsigned int)((mem / (double)(m_nodes.size()-1)) + 0.5);
@@ -504,13 +580,39 @@ public:
         /* parallel graph data structure  */
         /* ============================================================= */
 private:
+        // renumbers the ghost nodes such that they are sorted by owning PE and global id
+        void sort_ghost_nodes();
+
+        // computes for every interface node its position in the ghost nodes of the adjacent PEs
+        void compute_send_positions();
+
+        static bool compare_global_id( const AdditionalNonLocalNodeData & lhs, NodeID global_id ) {
+                return lhs.globalID < global_id;
+        }
+
+        // storage of node and edge data, these hide the layout selected by COMPACT_PARHIP
+        void resize_node_data( NodeID n );
+        void push_ghost_node_data( NodeID global_id );
+        void set_interface_node( NodeID node );
+        void resize_edges( EdgeID m );
+        void setEdgeTarget( EdgeID e, NodeID target );
+
         // the graph representation itself
         // local and ghost nodes in one array, 
         // local nodes are stored in the beginning
         // ghost nodes in the end of the array
-        std::vector<Node>                       m_nodes; 
+        std::vector<ParallelNode>               m_nodes; 
+#ifdef COMPACT_PARHIP
+        compact_array                           m_node_labels;
+        compact_array                           m_node_blocks;
+        compact_array                           m_node_weights;
+        std::vector<bool>                       m_interface_nodes;
+        compact_array                           m_edge_targets;
+        compact_array                           m_edge_weights;
+#else
         std::vector<NodeData>                   m_nodes_data;
-        std::vector<Edge>                       m_edges;
+        std::vector<ParallelEdge>               m_edges;
+#endif
 
         //Ghost Node Stuff
         std::vector<AdditionalNonLocalNodeData> m_add_non_local_node_data;
@@ -523,7 +625,20 @@ private:
         std::vector<NodeID>                     m_range_array;
         std::vector<EdgeID>                     m_edge_range_array;
 
-        std::unordered_map<NodeID, NodeID> m_global_to_local_id;
+        // global id -> local id of ghost nodes, only used during construction
+        ghost_node_table m_ghost_table;
+
+        // ghost nodes of PE p are m_add_non_local_node_data[m_ghost_offsets[p] .. m_ghost_offsets[p+1])
+        // sorted by global id
+        std::vector<NodeID> m_ghost_offsets;
+
+        // the ghost nodes of PE p are exactly the interface nodes adjacent to p (the graph is undirected),
+        // both sorted by global id. so the interface node m_send_nodes[i] is at position m_send_ghost_positions[j] in
+        // the ghost nodes of PE m_send_pes[j] on that PE, j in [m_send_position_offsets[i], m_send_position_offsets[i+1])
+        std::vector<NodeID> m_send_nodes;
+        std::vector<NodeID> m_send_position_offsets;
+        std::vector<PEID>   m_send_pes;
+        std::vector<NodeID> m_send_ghost_positions;
 
         NodeID m_ghost_adddata_array_offset; // node id of ghost node - offset to get the position in add data  
         NodeID m_divisor; // needed to compute the target id of a ghost node
@@ -540,7 +655,7 @@ private:
         NodeID m_num_nodes; 
 
         NodeID m_global_n; // global number of nodes
-        NodeID m_global_m; // global number of edges
+        EdgeID m_global_m; // global number of edges
         static ULONG m_comm_rounds; // global number of edges
         static ULONG m_comm_rounds_up; // global number of edges
 
@@ -580,8 +695,10 @@ inline EdgeID parallel_graph_access::get_first_invalid_edge(NodeID node) {
         return m_nodes[node+1].firstEdge;
 }
 
-inline EdgeID parallel_graph_access::getNodeLabel(NodeID node) {
-#ifdef NDEBUG
+inline NodeID parallel_graph_access::getNodeLabel(NodeID node) {
+#ifdef COMPACT_PARHIP
+        return m_node_labels[node];
+#elif defined NDEBUG
         return m_nodes_data[node].label;
 #else
         return m_nodes_data.at(node).label;
@@ -589,10 +706,12 @@ inline EdgeID parallel_graph_access::getNodeLabel(NodeID node) {
 }
 
 inline void parallel_graph_access::setNodeLabel(NodeID node, NodeID label) {
-        if( m_nodes_data[node].label != label && is_interface_node(node)) {
+        if( getNodeLabel(node) != label && is_interface_node(node)) {
                 m_gnc->addLabel(node, label);
         }
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        m_node_labels.set(node, label);
+#elif defined NDEBUG
         m_nodes_data[node].label = label;
 #else
         m_nodes_data.at(node).label = label;
@@ -601,7 +720,9 @@ inline void parallel_graph_access::setNodeLabel(NodeID node, NodeID label) {
 
 inline
 NodeID parallel_graph_access::getSecondPartitionIndex(NodeID node) {
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        return m_node_blocks[node];
+#elif defined NDEBUG
         return m_nodes_data[node].block;
 #else
         return m_nodes_data.at(node).block;
@@ -610,7 +731,9 @@ NodeID parallel_graph_access::getSecondPartitionIndex(NodeID node) {
 
 inline
 void parallel_graph_access::setSecondPartitionIndex(NodeID node, NodeID block) {
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        m_node_blocks.set(node, block);
+#elif defined NDEBUG
         m_nodes_data[node].block = block;
 #else
         m_nodes_data.at(node).block = block;
@@ -618,7 +741,9 @@ void parallel_graph_access::setSecondPartitionIndex(NodeID node, NodeID block) {
 }
 
 inline void parallel_graph_access::setNodeWeight(NodeID node, NodeWeight weight) {
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        m_node_weights.set(node, weight);
+#elif defined NDEBUG
         m_nodes_data[node].weight = weight;
 #else
         m_nodes_data.at(node).weight = weight;
@@ -626,7 +751,9 @@ inline void parallel_graph_access::setNodeWeight(NodeID node, NodeWeight weight)
 }
 
 inline NodeWeight parallel_graph_access::getNodeWeight(NodeID node) {
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        return m_node_weights[node];
+#elif defined NDEBUG
         return m_nodes_data[node].weight;
 #else
         return m_nodes_data.at(node).weight;
@@ -640,7 +767,9 @@ inline EdgeID parallel_graph_access::getNodeNumGhostNodes(NodeID node) {
         return m_nodes[node+1].firstEdge-m_nodes[node].firstEdge;
 }
 inline bool parallel_graph_access::is_interface_node(NodeID node) {
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        return m_interface_nodes[node];
+#elif defined NDEBUG
         return m_nodes_data[node].is_interface_node;
 #else
         return m_nodes_data.at(node).is_interface_node;
@@ -656,7 +785,9 @@ inline bool parallel_graph_access::is_local_node(NodeID node) {
 }
 
 inline EdgeWeight parallel_graph_access::getEdgeWeight(EdgeID e) {
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        return m_edge_weights[e];
+#elif defined NDEBUG
         return m_edges[e].weight;
 #else
         return m_edges.at(e).weight;
@@ -664,7 +795,9 @@ inline EdgeWeight parallel_graph_access::getEdgeWeight(EdgeID e) {
 }
 
 inline void parallel_graph_access::setEdgeWeight(EdgeID e, EdgeWeight weight) {
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        m_edge_weights.set(e, weight);
+#elif defined NDEBUG
         m_edges[e].weight = weight;
 #else
         m_edges.at(e).weight = weight;
@@ -672,7 +805,9 @@ inline void parallel_graph_access::setEdgeWeight(EdgeID e, EdgeWeight weight) {
 }
 
 inline NodeID parallel_graph_access::getEdgeTarget(EdgeID e){
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        return m_edge_targets[e];
+#elif defined NDEBUG
         return m_edges[e].local_target;        
 #else
         return m_edges.at(e).local_target;        
@@ -681,7 +816,9 @@ inline NodeID parallel_graph_access::getEdgeTarget(EdgeID e){
 
 //function should only be called for ghost nodes
 inline PEID parallel_graph_access::getTargetPE(NodeID node) {
-#ifdef NDEBUG
+#ifdef COMPACT_PARHIP
+        return get_PEID_from_range_array(m_add_non_local_node_data[node-m_ghost_adddata_array_offset].globalID);
+#elif defined NDEBUG
         return m_add_non_local_node_data[node-m_ghost_adddata_array_offset].peID;
 #else
         ASSERT_GEQ(node, m_ghost_adddata_array_offset);
@@ -705,6 +842,58 @@ inline NodeID parallel_graph_access::getGlobalID(NodeID node) {
 
 
 
+inline void parallel_graph_access::resize_node_data(NodeID n) {
+#ifdef COMPACT_PARHIP
+        m_node_labels.resize(n);
+        m_node_blocks.resize(n);
+        m_node_weights.resize(n);
+        m_interface_nodes.resize(n, false);
+#else
+        m_nodes_data.resize(n);
+#endif
+}
+
+inline void parallel_graph_access::push_ghost_node_data(NodeID global_id) {
+#ifdef COMPACT_PARHIP
+        m_node_labels.push_back(global_id);
+        m_node_blocks.push_back(0);
+        m_node_weights.push_back(1);
+        m_interface_nodes.push_back(false);
+#else
+        NodeData dummy_data; 
+        dummy_data.label             = global_id;
+        dummy_data.block             = 0;
+        dummy_data.is_interface_node = false;
+        dummy_data.weight            = 1;
+        m_nodes_data.push_back(dummy_data);
+#endif
+}
+
+inline void parallel_graph_access::set_interface_node(NodeID node) {
+#ifdef COMPACT_PARHIP
+        m_interface_nodes[node] = true;
+#else
+        m_nodes_data[node].is_interface_node = true;
+#endif
+}
+
+inline void parallel_graph_access::resize_edges(EdgeID m) {
+#ifdef COMPACT_PARHIP
+        m_edge_targets.resize(m);
+        m_edge_weights.resize(m);
+#else
+        m_edges.resize(m);
+#endif
+}
+
+inline void parallel_graph_access::setEdgeTarget(EdgeID e, NodeID target) {
+#ifdef COMPACT_PARHIP
+        m_edge_targets.set(e, target);
+#else
+        m_edges[e].local_target = target;
+#endif
+}
+
 // this function should only be called if the graph is completely stored on the root PE
 inline int* parallel_graph_access::UNSAFE_metis_style_xadj_array() {
         int * xadj      = new int[number_of_local_nodes()+1];
@@ -722,7 +911,7 @@ inline int* parallel_graph_access::UNSAFE_metis_style_xadj_array() {
 inline int* parallel_graph_access::UNSAFE_metis_style_adjncy_array() {
         int * adjncy    = new int[number_of_local_edges()];
         forall_local_edges((*this), e) {
-                adjncy[e] = m_edges[e].local_target;
+                adjncy[e] = getEdgeTarget(e);
         } endfor 
 
         return adjncy;
@@ -732,7 +921,7 @@ inline int* parallel_graph_access::UNSAFE_metis_style_adjncy_array() {
 inline int* parallel_graph_access::UNSAFE_metis_style_vwgt_array() {
         int * vwgt      = new int[number_of_local_nodes()];
         forall_local_nodes((*this), node) {
-                vwgt[node] = m_nodes_data[node].weight;
+                vwgt[node] = getNodeWeight(node);
         } endfor
 
         return vwgt;
@@ -741,7 +930,7 @@ inline int* parallel_graph_access::UNSAFE_metis_style_vwgt_array() {
 inline int* parallel_graph_access::UNSAFE_metis_style_adjwgt_array() {
         int * adjwgt    = new int[number_of_local_edges()];
         forall_local_edges((*this), e) {
-                adjwgt[e] = m_edges[e].weight;
+                adjwgt[e] = getEdgeWeight(e);
         } endfor 
 
         return adjwgt;
@@ -794,23 +983,15 @@ inline int parallel_graph_access::build_from_metis_weighted(int n, int* xadj, in
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 inline 
 void ghost_node_communication::addLabel(NodeID node, NodeID label) {
-        forall_out_edges((*m_G), e, node) {
-                NodeID target = m_G->getEdgeTarget(e);
-                if( !m_G->is_local_node(target)  ) {
-                        PEID peID = m_G->getTargetPE(target);
-                        if( !m_PE_packed[peID] ) { // make sure a node is sent at most once
-                                (*m_send_buffers_ptr)[peID].push_back(m_G->getGlobalID(node));
-                                (*m_send_buffers_ptr)[peID].push_back(label);
-                                m_PE_packed[peID] = true;
-                        }
-                }
-        } endfor
-        forall_out_edges((*m_G), e, node) {
-                NodeID target = m_G->getEdgeTarget(e);
-                if( !m_G->is_local_node(target)  ) {
-                        m_PE_packed[m_G->getTargetPE(target)] = false;
-                }
-        } endfor
+        // the receiver applies the update by the position of the node in its ghost nodes
+        const std::vector<NodeID> & send_nodes = m_G->m_send_nodes;
+        NodeID idx = std::lower_bound(send_nodes.begin(), send_nodes.end(), node) - send_nodes.begin();
+        if( idx == send_nodes.size() || send_nodes[idx] != node ) return;
+
+        for( NodeID i = m_G->m_send_position_offsets[idx]; i < m_G->m_send_position_offsets[idx+1]; i++) {
+                (*m_send_buffers_ptr)[m_G->m_send_pes[i]].push_back(m_G->m_send_ghost_positions[i]);
+                (*m_send_buffers_ptr)[m_G->m_send_pes[i]].push_back(label);
+        }
 }
 
 // we want to interleave computation and communication
@@ -837,7 +1018,7 @@ inline void ghost_node_communication::update_ghost_node_data( bool check_iterati
                                 MPI_Request * request = new MPI_Request();
                                 MPI_Isend( &(*m_send_buffers_ptr)[peID][0], 
                                            (*m_send_buffers_ptr)[peID].size(), 
-                                           MPI_UNSIGNED_LONG_LONG, 
+                                           MPI_NODEID, 
                                            peID, m_send_tag, m_communicator, request);
                                 
                                 m_isend_requests.push_back( request );
@@ -879,7 +1060,7 @@ inline void ghost_node_communication::update_ghost_node_data( bool check_iterati
                         MPI_Request * request = new MPI_Request();
                         MPI_Isend( &(*m_send_buffers_ptr)[peID][0], 
                                    (*m_send_buffers_ptr)[peID].size(), 
-                                   MPI_UNSIGNED_LONG_LONG, 
+                                   MPI_NODEID, 
                                    peID, m_send_tag, m_communicator, request);
                         
                         m_isend_requests.push_back( request );
@@ -904,30 +1085,88 @@ void ghost_node_communication::receive_messages_of_neighbors() {
                 // wait for incomming message of an adjacent processor
                 MPI_Status st;
                 MPI_Probe(MPI_ANY_SOURCE, m_recv_tag, m_communicator,  &st);
+                receive_and_integrate_message( st, m_recv_tag );
 
-                int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                counter++;
+        }
 
-                std::vector<NodeID> message; message.resize(message_length);
-                MPI_Status rst;
-                MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, m_recv_tag, m_communicator, &rst); 
+        // wait for previous iteration to finish
+        for( unsigned i = 0; i < m_isend_requests.size(); i++) {
+                MPI_Status st;
+                MPI_Wait( m_isend_requests[i], &st);
+                delete m_isend_requests[i];
+        }
+        m_isend_requests.clear();
 
-                counter++;
+}
 
-                // now integrate the changes
-                if(message_length == 1) continue; // nothing to do
+inline 
+void ghost_node_communication::receive_and_integrate_message( MPI_Status & st, int tag ) {
+        int message_length;
+        MPI_Get_count(&st, MPI_NODEID, &message_length);
 
-                for( int i = 0; i < message_length-1; i+=2) {
-                        NodeID global_id = message[i];
-                        NodeID label     = message[i+1];
+        std::vector<NodeID> message; message.resize(message_length);
+        MPI_Status rst;
+        MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, tag, m_communicator, &rst); 
+
+        // now integrate the changes
+        if(message_length == 1) return; // nothing to do
+
+        for( int i = 0; i < message_length-1; i+=2) {
+                NodeID position = message[i];
+                NodeID label    = message[i+1];
 
-                        NodeID local_id = m_G->m_global_to_local_id[global_id];
-                        m_G->update_non_contained_block_balance(m_G->getNodeLabel(local_id), label, m_G->getNodeWeight(local_id));
-                        m_G->setNodeLabel(local_id, label);
+                NodeID local_id = m_G->getGhostLocalIDByPosition(st.MPI_SOURCE, position);
+                m_G->update_non_contained_block_balance(m_G->getNodeLabel(local_id), label, m_G->getNodeWeight(local_id));
+                m_G->setNodeLabel(local_id, label);
+        }
+}
+
+inline void ghost_node_communication::post_ghost_node_data() {
+        m_G->update_block_weights();
+        m_overlap_received   = 0;
+        m_overlap_tag_factor = m_overlap_tag_factor == 14 ? 15 : 14;
+
+        for( PEID peID = 0; peID < m_size; peID++) {
+                if( m_adjacent_processors[peID] ) {
+                        // length 1 encode no message
+                        if( (*m_send_buffers_ptr)[peID].size() == 0 ){
+                                (*m_send_buffers_ptr)[peID].push_back(0);
+                        }
+
+                        MPI_Request * request = new MPI_Request();
+                        MPI_Isend( &(*m_send_buffers_ptr)[peID][0], 
+                                   (*m_send_buffers_ptr)[peID].size(), 
+                                   MPI_NODEID, 
+                                   peID, peID+m_overlap_tag_factor*m_size, m_communicator, request);
+
+                        m_isend_requests.push_back( request );
                 }
         }
+}
+
+inline void ghost_node_communication::poll_ghost_node_data() {
+        int tag = m_rank+m_overlap_tag_factor*m_size;
+        while( m_overlap_received < m_num_adjacent ) {
+                int flag;
+                MPI_Status st;
+                MPI_Iprobe(MPI_ANY_SOURCE, tag, m_communicator, &flag, &st);
+                if( !flag ) return;
+
+                receive_and_integrate_message( st, tag );
+                m_overlap_received++;
+        }
+}
+
+inline void ghost_node_communication::finish_ghost_node_data() {
+        int tag = m_rank+m_overlap_tag_factor*m_size;
+        while( m_overlap_received < m_num_adjacent ) {
+                MPI_Status st;
+                MPI_Probe(MPI_ANY_SOURCE, tag, m_communicator, &st);
+                receive_and_integrate_message( st, tag );
+                m_overlap_received++;
+        }
 
-        // wait for previous iteration to finish
         for( unsigned i = 0; i < m_isend_requests.size(); i++) {
                 MPI_Status st;
                 MPI_Wait( m_isend_requests[i], &st);
@@ -935,6 +1174,10 @@ void ghost_node_communication::receive_messages_of_neighbors() {
         }
         m_isend_requests.clear();
 
+        for( PEID peID = 0; peID < m_size; peID++) {
+                (*m_send_buffers_ptr)[peID].clear();
+        }
+        m_G->update_block_weights();
 }
 
 inline void ghost_node_communication::update_ghost_node_data_finish() {
@@ -974,25 +1217,13 @@ inline void ghost_node_communication::update_ghost_node_data_finish() {
 inline void ghost_node_communication::update_ghost_node_data_global() {
         std::vector< std::vector< NodeID > > send_buffers; // buffers to send messages
         send_buffers.resize(m_size);
-        forall_local_nodes((*m_G), node) {
-                forall_out_edges((*m_G), e, node) {
-                        NodeID target = m_G->getEdgeTarget(e);
-                        if( !m_G->is_local_node(target)  ) {
-                                PEID peID = m_G->getTargetPE(target);
-                                if( !m_PE_packed[peID] ) { // make sure a node is sent at most once
-                                        send_buffers[peID].push_back(m_G->getGlobalID(node));
-                                        send_buffers[peID].push_back(m_G->getNodeLabel(node));
-                                        m_PE_packed[peID] = true;
-                                }
-                        }
-                } endfor
-                forall_out_edges((*m_G), e, node) {
-                        NodeID target = m_G->getEdgeTarget(e);
-                        if( !m_G->is_local_node(target)  ) {
-                                m_PE_packed[m_G->getTargetPE(target)] = false;
-                        }
-                } endfor
-        } endfor
+        for( NodeID idx = 0; idx < m_G->m_send_nodes.size(); idx++) {
+                NodeID label = m_G->getNodeLabel(m_G->m_send_nodes[idx]);
+                for( NodeID i = m_G->m_send_position_offsets[idx]; i < m_G->m_send_position_offsets[idx+1]; i++) {
+                        send_buffers[m_G->m_send_pes[i]].push_back(m_G->m_send_ghost_positions[i]);
+                        send_buffers[m_G->m_send_pes[i]].push_back(label);
+                }
+        }
 
         //send all neighbors their packages using Isends
         //a neighbor that does not receive something gets a specific token
@@ -1006,7 +1237,7 @@ inline void ghost_node_communication::update_ghost_node_data_global() {
 
                         MPI_Request rq; 
                         MPI_Isend( &send_buffers[peID][0], 
-                                    send_buffers[peID].size(), MPI_UNSIGNED_LONG_LONG, peID, peID+3*m_size, m_communicator, &rq);
+                                    send_buffers[peID].size(), MPI_NODEID, peID, peID+3*m_size, m_communicator, &rq);
                 }
         }
 
@@ -1018,21 +1249,21 @@ inline void ghost_node_communication::update_ghost_node_data_global() {
                 MPI_Probe(MPI_ANY_SOURCE, tag, m_communicator,  &st);
 
                 int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                MPI_Get_count(&st, MPI_NODEID, &message_length);
                 std::vector<NodeID> message; message.resize(message_length);
 
                 MPI_Status rst;
-                MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, tag, m_communicator, &rst); 
+                MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, tag, m_communicator, &rst); 
                 counter++;
 
                 // now integrate the changes
                 if(message_length == 1) continue; // nothing to do
 
                 for( int i = 0; i < message_length-1; i+=2) {
-                        NodeID global_id = message[i];
-                        NodeID label     = message[i+1];
+                        NodeID position = message[i];
+                        NodeID label    = message[i+1];
 
-                        m_G->setNodeLabel( m_G->m_global_to_local_id[global_id], label);
+                        m_G->setNodeLabel( m_G->getGhostLocalIDByPosition(st.MPI_SOURCE, position), label);
                 }
         }
 
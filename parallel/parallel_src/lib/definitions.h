@@ -28,13 +28,27 @@
  * ********************************************/
 //Types needed for the parallel graph ds
 //we use long since we want to partition huge graphs
+//with PARHIP32BIT node ids, block ids and weights use 32 bits, this halves the memory 
+//of the edge array and the volume of most messages. n and the total node weight of the 
+//input have to be smaller than 2^32, the number of edges is not limited: edge ids and 
+//sums over edges (m, cut, communication volume) stay 64 bits, as do counters and file 
+//offsets (ULONG) 
 typedef unsigned long long ULONG;
 typedef unsigned int UINT;
-typedef unsigned long long NodeID;
 typedef unsigned long long EdgeID;
+#ifdef PARHIP32BIT
+typedef unsigned int NodeID;
+typedef unsigned int PartitionID;
+typedef unsigned int NodeWeight;
+typedef unsigned int EdgeWeight;
+#define MPI_NODEID MPI_UNSIGNED // MPI datatype of all types above but EdgeID
+#else
+typedef unsigned long long NodeID;
 typedef unsigned long long PartitionID;
 typedef unsigned long long NodeWeight;
 typedef unsigned long long EdgeWeight;
+#define MPI_NODEID MPI_UNSIGNED_LONG_LONG // MPI datatype of all types above but EdgeID
+#endif
 typedef int PEID; 
 
 const PEID ROOT = 0;
@@ -86,6 +100,8 @@ typedef enum {
   //rank + 11*size               down propagation
   //rank + 12*size               MPI Tools
   //rank + 13*size               MPI Tools
+  //rank + 14*size               overlapped label exchange
+  //rank + 15*size                --  ""  --
   //rank + 100*size + x          Label Isends  
  
 
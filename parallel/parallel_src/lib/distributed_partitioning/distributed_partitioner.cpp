@@ -86,7 +86,7 @@ void distributed_partitioner::perform_partitioning( MPI_Comm communicator, PPart
 
 #ifndef NOOUTPUT
                 distributed_quality_metrics qm;
-                EdgeWeight edge_cut = qm.edge_cut( G, communicator );
+                ULONG edge_cut = qm.edge_cut( G, communicator );
                 double balance      = qm.balance( config, G, communicator );
 
                 if( rank == ROOT ) {
@@ -307,7 +307,7 @@ void distributed_partitioner::check_labels( MPI_Comm communicator, PPartitionCon
 
                         MPI_Request rq; int tag = peID+17*m_size;
                         MPI_Isend( &send_buffers[peID][0], 
-                                    send_buffers[peID].size(), MPI_UNSIGNED_LONG_LONG, peID, tag, communicator, &rq);
+                                    send_buffers[peID].size(), MPI_NODEID, peID, tag, communicator, &rq);
                         
                 }
         }
@@ -321,12 +321,12 @@ void distributed_partitioner::check_labels( MPI_Comm communicator, PPartitionCon
                 MPI_Probe(MPI_ANY_SOURCE, tag, communicator, &st);
                 
                 int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                MPI_Get_count(&st, MPI_NODEID, &message_length);
                 
                 std::vector<NodeID> message; message.resize(message_length);
 
                 MPI_Status rst;
-                MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, tag, communicator, &rst); 
+                MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, tag, communicator, &rst); 
                 
                 counter++;
 
@@ -393,7 +393,7 @@ void distributed_partitioner::check( MPI_Comm communicator, PPartitionConfig & c
 
                         MPI_Request rq; 
                         MPI_Isend( &send_buffers[peID][0], 
-                                    send_buffers[peID].size(), MPI_UNSIGNED_LONG_LONG, peID, peID+17*m_size, communicator, &rq);
+                                    send_buffers[peID].size(), MPI_NODEID, peID, peID+17*m_size, communicator, &rq);
                 }
         }
 
@@ -406,12 +406,12 @@ void distributed_partitioner::check( MPI_Comm communicator, PPartitionConfig & c
                 MPI_Probe(MPI_ANY_SOURCE, tag, communicator, &st);
 
                 int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                MPI_Get_count(&st, MPI_NODEID, &message_length);
                 
                 std::vector<NodeID> message; message.resize(message_length);
 
                 MPI_Status rst;
-                MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, tag, communicator, &rst); 
+                MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, tag, communicator, &rst); 
                 
                 counter++;
 
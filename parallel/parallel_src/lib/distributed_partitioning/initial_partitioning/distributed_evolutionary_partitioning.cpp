@@ -60,8 +60,8 @@ void distributed_evolutionary_partitioning::perform_partitioning( MPI_Comm commu
 
         if( config.vcycle ) {
                 MPI_Bcast(partition_map, n, MPI_INT, ROOT, communicator);
-                MPI_Bcast(&prev_cut, 1 , MPI_LONG, ROOT, communicator);
-                MPI_Bcast(&prev_max_block_weight, 1 , MPI_LONG, ROOT, communicator);
+                MPI_Bcast(&prev_cut, 1 , MPI_NODEID, ROOT, communicator);
+                MPI_Bcast(&prev_max_block_weight, 1 , MPI_NODEID, ROOT, communicator);
         }
 
         double inbalance       = config.inbalance/100.0;
@@ -22,13 +22,13 @@ random_initial_partitioning::~random_initial_partitioning() {
 void random_initial_partitioning::perform_partitioning( MPI_Comm communicator, PPartitionConfig & config, parallel_graph_access & G) {
 
         forall_local_nodes(G, node) {
-                G.setNodeLabel(node, random_functions::nextInt(0ULL, config.k-1));
+                G.setNodeLabel(node, random_functions::nextInt((PartitionID)0, config.k-1));
         } endfor
         
         G.update_ghost_node_data_global(); // exchange the labels of ghost nodes
 
         distributed_quality_metrics qm;
-        EdgeWeight edgecut = qm.edge_cut(G, communicator );
+        ULONG edgecut = qm.edge_cut(G, communicator );
         double balance = qm.balance(config, G, communicator );
 
         PEID rank;
@@ -49,7 +49,7 @@ void dspac::internal_construct(parallel_graph_access &split_graph) {
 
     NodeID global_number_of_deg_1_or_2_vertices = 0;
     MPI_Allreduce(&local_number_of_deg_1_or_2_vertices, &global_number_of_deg_1_or_2_vertices, 1,
-                  MPI_UNSIGNED_LONG_LONG, MPI_SUM, m_comm);
+                  MPI_NODEID, MPI_SUM, m_comm);
     if (rank == 0) {
         std::cout << "[dspac::internal_construct()] Up to MPI_Allreduce() took "
                   << construction_timer.elapsed() << std::endl;
@@ -65,7 +65,7 @@ void dspac::internal_construct(parallel_graph_access &split_graph) {
             - 2 * local_number_of_deg_1_or_2_vertices;
 
     assert(3 * m_input_graph.number_of_global_edges() >= 2 * global_number_of_deg_1_or_2_vertices);
-    const NodeID global_number_of_split_edges = 3 * m_input_graph.number_of_global_edges()
+    const EdgeID global_number_of_split_edges = 3 * m_input_graph.number_of_global_edges()
             - 2 * global_number_of_deg_1_or_2_vertices;
 
     // this array stores the distribution of nodes across PEs, namely PE i stores nodes
@@ -130,7 +130,7 @@ void dspac::internal_construct(parallel_graph_access &split_graph) {
             assert(count < std::numeric_limits<int>::max());
 
             MPI_Request *request = new MPI_Request;
-            MPI_Isend(buf, static_cast<int>(count), MPI_UNSIGNED_LONG_LONG, pe, 0, m_comm, request);
+            MPI_Isend(buf, static_cast<int>(count), MPI_NODEID, pe, 0, m_comm, request);
             requests.push_back(request);
         }
     }
@@ -154,7 +154,7 @@ void dspac::internal_construct(parallel_graph_access &split_graph) {
             assert(node_range_array[pe] + count <= first_split_node.size());
             assert(count < std::numeric_limits<int>::max());
 
-            MPI_Recv(buf, static_cast<int>(count), MPI_UNSIGNED_LONG_LONG, pe, 0, m_comm, MPI_STATUS_IGNORE);
+            MPI_Recv(buf, static_cast<int>(count), MPI_NODEID, pe, 0, m_comm, MPI_STATUS_IGNORE);
         }
     }
 
@@ -176,7 +176,9 @@ void dspac::internal_construct(parallel_graph_access &split_graph) {
     // now we construct the split graph
     split_graph.start_construction(local_number_of_split_nodes, local_number_of_split_edges,
                                    global_number_of_split_nodes, global_number_of_split_edges);
-    split_graph.set_range_array(edge_range_array);
+    // the split nodes are the edges of the input graph, their number fits into NodeID (see edge_balanced_graph_io)
+    std::vector<NodeID> split_node_range_array(edge_range_array.begin(), edge_range_array.end());
+    split_graph.set_range_array(split_node_range_array);
     split_graph.set_range(from, to - 1);
 
     NodeID nodes_created = 0;
@@ -365,7 +367,7 @@ bool dspac::assert_adjacency_lists_sorted() {
     return true;
 }
 
-bool dspac::assert_edge_range_array_ok(const std::vector<NodeID> &edge_range_array) {
+bool dspac::assert_edge_range_array_ok(const std::vector<EdgeID> &edge_range_array) {
     int size, rank;
     MPI_Comm_size(m_comm, &size);
     MPI_Comm_rank(m_comm, &rank);
@@ -427,7 +429,7 @@ EdgeWeight dspac::calculate_vertex_cut(PartitionID k, const std::vector<Partitio
     }
 
     EdgeWeight global_cost;
-    MPI_Reduce(&local_cost, &global_cost, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, m_comm);
+    MPI_Reduce(&local_cost, &global_cost, 1, MPI_NODEID, MPI_SUM, 0, m_comm);
     return global_cost;
 }
 
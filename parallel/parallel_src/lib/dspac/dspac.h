@@ -24,7 +24,7 @@ public:
 private:
     bool assert_adjacency_lists_sorted();
     bool assert_sanity_checks(parallel_graph_access &split_graph);
-    bool assert_edge_range_array_ok(const std::vector<NodeID> &edge_range_array);
+    bool assert_edge_range_array_ok(const std::vector<EdgeID> &edge_range_array);
     bool assert_node_range_array_ok(const std::vector<NodeID> &node_range_array);
 
     void internal_construct(parallel_graph_access &split_graph);
@@ -10,6 +10,7 @@
 #include <numeric>
 
 #include "edge_balanced_graph_io.h"
+#include "io/parallel_graph_io.h"
 
 static constexpr ULONG FILE_TYPE_VERSION = 3;
 
@@ -72,6 +73,9 @@ void edge_balanced_graph_io::read_binary_graph_edge_balanced(parallel_graph_acce
         throw std::ios_base::failure("wrong file type version");
     }
 
+    // dspac builds a split graph with one node per edge
+    parallel_graph_io::check_id_width(std::max(n, m), rank);
+
     /*
      * next, we determine the number of vertices on each PE such that the number of edges are almost evenly
      * distributed
@@ -92,9 +96,10 @@ void edge_balanced_graph_io::read_binary_graph_edge_balanced(parallel_graph_acce
     std::iota(permutation.begin(), permutation.end(), 0);
 
     // to construct the vertex range array, send 'from' to all other PEs
-    std::vector<NodeID> nodeRanges(static_cast<std::size_t>(size + 1));
-    MPI_Allgather(&from, 1, MPI_UNSIGNED_LONG_LONG, &nodeRanges[0], 1, MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD);
-    nodeRanges[size] = n;
+    std::vector<ULONG> allFrom(static_cast<std::size_t>(size));
+    MPI_Allgather(&from, 1, MPI_UNSIGNED_LONG_LONG, &allFrom[0], 1, MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD);
+    std::vector<NodeID> nodeRanges(allFrom.begin(), allFrom.end());
+    nodeRanges.push_back(n);
 
     /*
      * the last part, i.e. loading the graph, is the same as in parallel_graph_io::readGraphBinary()
@@ -116,7 +121,7 @@ void edge_balanced_graph_io::read_binary_graph_edge_balanced(parallel_graph_acce
                 ULONG peLocalNodes = peTo - peFrom;
 
                 ULONG peStartPos = (HEADER_SIZE + peFrom) * sizeof(ULONG);
-                NodeID peFirstNodeOffset, peLastNodeOffset;
+                ULONG peFirstNodeOffset, peLastNodeOffset;
 
                 in.seekg(peStartPos);
                 in.read((char *) &peFirstNodeOffset, sizeof(ULONG));
@@ -129,14 +134,14 @@ void edge_balanced_graph_io::read_binary_graph_edge_balanced(parallel_graph_acce
 
             // load and construction, just like parallel_graph_io::readGraphBinary()
             ULONG startPos = (HEADER_SIZE + from) * sizeof(ULONG);
-            NodeID *vertexOffsets = new NodeID[numberOfLocalNodes + 1];
+            ULONG *vertexOffsets = new ULONG[numberOfLocalNodes + 1];
             in.seekg(startPos);
             in.read((char *) vertexOffsets, static_cast<std::size_t>((numberOfLocalNodes + 1) * sizeof(ULONG)));
 
             ULONG edgeStartPos = vertexOffsets[0];
             EdgeID numReads = vertexOffsets[numberOfLocalNodes] - vertexOffsets[0];
             EdgeID numEdgesToRead = numReads / sizeof(ULONG);
-            EdgeID *edges = new EdgeID[numEdgesToRead];
+            ULONG *edges = new ULONG[numEdgesToRead];
             in.seekg(edgeStartPos);
             in.read((char *) edges, static_cast<std::streamsize>(numEdgesToRead * sizeof(ULONG)));
 
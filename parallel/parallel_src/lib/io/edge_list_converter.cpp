@@ -0,0 +1,333 @@
+/******************************************************************************
+ * edge_list_converter.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <cstdio>
+#include <iostream>
+#include <omp.h>
+#include <queue>
+#include <sstream>
+#include <stdlib.h>
+
+#include "edge_list_converter.h"
+#include "tools/helpers.h"
+
+// version of the binary graph format written by parallel_graph_io
+const ULONG binaryFileTypeVersionNumber = 3;
+const ULONG binary_header_count         = 3;
+
+inline bool operator==( const edge_pair & a, const edge_pair & b ) {
+        return a.source == b.source && a.target == b.target;
+}
+
+inline bool operator<( const edge_pair & a, const edge_pair & b ) {
+        return a.source < b.source || (a.source == b.source && a.target < b.target);
+}
+
+edge_list_converter::edge_list_converter( ULONG memory_budget_in_mb ) {
+        // the pairs of a run and the buffer of the radix sort
+        m_run_capacity = std::max( (ULONG)1024, memory_budget_in_mb * 1024 * 1024 / (2*sizeof(edge_pair)) );
+        m_edges        = 0;
+        m_edges_read   = 0;
+        m_selfloops    = 0;
+        m_singletons   = 0;
+}
+
+edge_list_converter::~edge_list_converter() {
+}
+
+int edge_list_converter::convert( std::string input_filename, std::string output_filename, ULONG skip_lines, EdgeListFormat format ) {
+        if( !create_runs( input_filename, output_filename, skip_lines, format ) ) {
+                return 1;
+        }
+        std::cout <<  "edges read " <<  m_edges_read  << std::endl;
+        std::cout <<  "selfloops " <<  m_selfloops  << std::endl;
+        std::cout <<  "runs " <<  m_run_filenames.size()  << std::endl;
+
+        std::string merged_filename = output_filename + ".merged";
+        merge_runs( merged_filename );
+        std::cout <<  "n " <<  m_node_ids.size() <<  " m " <<  m_edges/2  << std::endl;
+        std::cout <<  "duplicate edges " <<  m_edges_read - m_edges/2  << std::endl;
+
+        if( hasEnding(output_filename, ".bgf") ) {
+                write_binary( merged_filename, output_filename );
+        } else {
+                write_metis( merged_filename, output_filename );
+        }
+        std::remove( merged_filename.c_str() );
+
+        return 0;
+}
+
+bool edge_list_converter::create_runs( std::string input_filename, std::string output_filename, ULONG skip_lines, EdgeListFormat format ) {
+        std::ifstream in(input_filename.c_str());
+        if (!in) {
+                std::cerr << "Error opening " << input_filename << std::endl;
+                return false;
+        }
+
+        std::string line;
+        for( ULONG i = 0; i < skip_lines && std::getline(in, line); i++) {
+                std::cout <<  line  << std::endl;
+        }
+
+        std::vector< edge_pair > edges;
+        edges.reserve(m_run_capacity);
+        while( std::getline(in, line) ) {
+                const char* pos = line.c_str();
+                char* next      = NULL;
+
+                ULONG source = strtoull(pos, &next, 10);
+                if( next == pos ) continue; // empty line
+                pos = next;
+
+                // an edge list has one target per line, the columns after it are ignored
+                bool is_singleton = true;
+                bool more_targets = true;
+                while( more_targets ) {
+                        ULONG target = strtoull(pos, &next, 10);
+                        if( next == pos ) break;
+                        pos = next;
+                        is_singleton = false;
+                        more_targets = format == EDGE_LIST_ADJACENCY;
+
+                        if( source == target ) {
+                                m_selfloops++;
+                                continue;
+                        }
+
+                        if( edges.size() + 2 > m_run_capacity ) {
+                                write_run( edges, output_filename );
+                        }
+
+                        // add forward and backward edge
+                        edge_pair forward  = {source, target};
+                        edge_pair backward = {target, source};
+                        edges.push_back(forward);
+                        edges.push_back(backward);
+                        m_edges_read++;
+                }
+
+                if( is_singleton ) {
+                        m_singletons++;
+                }
+        }
+
+        if( !edges.empty() || m_run_filenames.empty() ) {
+                write_run( edges, output_filename );
+        }
+
+        return true;
+}
+
+void edge_list_converter::write_run( std::vector< edge_pair > & edges, std::string output_filename ) {
+        std::vector< edge_pair > buffer;
+        radix_sort( edges, buffer );
+        edges.erase( std::unique(edges.begin(), edges.end()), edges.end() );
+
+        std::stringstream filename;
+        filename << output_filename << ".run" << m_run_filenames.size();
+        m_run_filenames.push_back(filename.str());
+
+        std::ofstream out(filename.str().c_str(), std::ios::binary);
+        out.write((char*)(edges.data()), edges.size()*sizeof(edge_pair));
+        edges.clear();
+}
+
+void edge_list_converter::merge_runs( std::string merged_filename ) {
+        ULONG buffer_size = std::max( (ULONG)1024, m_run_capacity / (m_run_filenames.size() + 1) );
+
+        std::vector< edge_run_reader* > readers;
+        typedef std::pair< edge_pair, ULONG > queue_entry;
+        struct greater_entry {
+                bool operator()( const queue_entry & a, const queue_entry & b ) const {
+                        return b.first < a.first;
+                }
+        };
+        std::priority_queue< queue_entry, std::vector< queue_entry >, greater_entry > queue;
+        for( ULONG i = 0; i < m_run_filenames.size(); i++) {
+                readers.push_back( new edge_run_reader( m_run_filenames[i], buffer_size ) );
+                if( readers[i]->has_next() ) {
+                        queue.push( std::make_pair( readers[i]->current(), i ) );
+                }
+        }
+
+        std::ofstream out(merged_filename.c_str(), std::ios::binary);
+        std::vector< edge_pair > out_buffer;
+        out_buffer.reserve(buffer_size);
+
+        m_node_ids.clear();
+        m_edges = 0;
+        bool first = true;
+        edge_pair last = {0, 0};
+        while( !queue.empty() ) {
+                queue_entry entry = queue.top();
+                queue.pop();
+
+                ULONG run = entry.second;
+                readers[run]->next();
+                if( readers[run]->has_next() ) {
+                        queue.push( std::make_pair( readers[run]->current(), run ) );
+                }
+
+                const edge_pair & e = entry.first;
+                if( !first && e == last ) continue;
+
+                if( first || e.source != last.source ) {
+                        m_node_ids.push_back(e.source);
+                }
+                first = false;
+                last  = e;
+                m_edges++;
+
+                out_buffer.push_back(e);
+                if( out_buffer.size() == buffer_size ) {
+                        out.write((char*)(out_buffer.data()), out_buffer.size()*sizeof(edge_pair));
+                        out_buffer.clear();
+                }
+        }
+        out.write((char*)(out_buffer.data()), out_buffer.size()*sizeof(edge_pair));
+        out.close();
+
+        for( ULONG i = 0; i < readers.size(); i++) {
+                delete readers[i];
+                std::remove( m_run_filenames[i].c_str() );
+        }
+        m_run_filenames.clear();
+}
+
+void edge_list_converter::write_metis( std::string merged_filename, std::string output_filename ) {
+        std::ofstream f(output_filename.c_str());
+        f << m_node_ids.size() <<  " " <<  m_edges/2 <<   std::endl;
+
+        edge_run_reader reader( merged_filename, 1 << 16 );
+        std::stringstream lines;
+        for( ULONG node = 0; node < m_node_ids.size(); node++) {
+                while( reader.has_next() && reader.current().source == m_node_ids[node] ) {
+                        lines << " " << (new_id(reader.current().target)+1);
+                        reader.next();
+                }
+                lines << "\n";
+
+                if( lines.tellp() > (1 << 24) ) {
+                        f << lines.rdbuf();
+                        lines.str("");
+                }
+        }
+        f << lines.rdbuf();
+}
+
+void edge_list_converter::write_binary( std::string merged_filename, std::string output_filename ) {
+        ULONG n = m_node_ids.size();
+        ULONG m = m_edges;
+
+        std::ofstream f(output_filename.c_str(), std::ios::binary);
+        f.write((char*)(&binaryFileTypeVersionNumber), sizeof( ULONG ));
+        f.write((char*)(&n), sizeof( ULONG ));
+        f.write((char*)(&m), sizeof( ULONG ));
+
+        // the edges are written behind the offsets, the offsets are collected meanwhile
+        std::vector< ULONG > offsets(n+1);
+        ULONG offset = (binary_header_count + n + 1) * (sizeof(ULONG));
+        f.seekp(offset);
+
+        edge_run_reader reader( merged_filename, 1 << 16 );
+        std::vector< ULONG > edges;
+        for( ULONG node = 0; node < n; node++) {
+                offsets[node] = offset;
+                while( reader.has_next() && reader.current().source == m_node_ids[node] ) {
+                        edges.push_back(new_id(reader.current().target));
+                        offset += sizeof(ULONG);
+                        reader.next();
+                }
+
+                if( edges.size() > (1 << 20) ) {
+                        f.write((char*)(edges.data()), edges.size()*sizeof(ULONG));
+                        edges.clear();
+                }
+        }
+        f.write((char*)(edges.data()), edges.size()*sizeof(ULONG));
+        offsets[n] = offset;
+
+        f.seekp(binary_header_count * sizeof(ULONG));
+        f.write((char*)(offsets.data()), offsets.size()*sizeof(ULONG));
+}
+
+void edge_list_converter::radix_sort( std::vector< edge_pair > & edges, std::vector< edge_pair > & buffer ) {
+        ULONG n = edges.size();
+        if( n <= 1 ) return;
+        buffer.resize(n);
+
+        // bytes 0 to 7 are the bytes of the target, 8 to 15 the bytes of the source
+        ULONG source_or = 0, source_and = ~0ULL, target_or = 0, target_and = ~0ULL;
+        for( ULONG i = 0; i < n; i++) {
+                source_or  |= edges[i].source; source_and &= edges[i].source;
+                target_or  |= edges[i].target; target_and &= edges[i].target;
+        }
+        ULONG source_differs = source_or ^ source_and;
+        ULONG target_differs = target_or ^ target_and;
+
+        // the pairs are split into a fixed number of parts, the team of a region may be
+        // smaller than requested and then a thread handles several parts
+        int parts = omp_get_max_threads();
+        std::vector< std::vector< ULONG > > counts(parts, std::vector< ULONG >(256));
+
+        for( int digit = 0; digit < 16; digit++) {
+                unsigned shift = 8*(digit % 8);
+                bool on_source = digit >= 8;
+                if( (((on_source ? source_differs : target_differs) >> shift) & 255) == 0 ) continue;
+
+                #pragma omp parallel num_threads(parts)
+                {
+                        #pragma omp for schedule(static)
+                        for( int part = 0; part < parts; part++) {
+                                ULONG begin = n * part / parts;
+                                ULONG end   = n * (part+1) / parts;
+                                std::vector< ULONG > & count = counts[part];
+                                std::fill(count.begin(), count.end(), 0);
+                                for( ULONG i = begin; i < end; i++) {
+                                        count[((on_source ? edges[i].source : edges[i].target) >> shift) & 255]++;
+                                }
+                        }
+
+                        #pragma omp single
+                        {
+                                // bucket after bucket, and within a bucket part after part
+                                ULONG sum = 0;
+                                for( int bucket = 0; bucket < 256; bucket++) {
+                                        for( int j = 0; j < parts; j++) {
+                                                ULONG c = counts[j][bucket];
+                                                counts[j][bucket] = sum;
+                                                sum += c;
+                                        }
+                                }
+                        }
+
+                        #pragma omp for schedule(static)
+                        for( int part = 0; part < parts; part++) {
+                                ULONG begin = n * part / parts;
+                                ULONG end   = n * (part+1) / parts;
+                                std::vector< ULONG > & count = counts[part];
+                                for( ULONG i = begin; i < end; i++) {
+                                        buffer[count[((on_source ? edges[i].source : edges[i].target) >> shift) & 255]++] = edges[i];
+                                }
+                        }
+                }
+                edges.swap(buffer);
+        }
+}
+
+edge_run_reader::edge_run_reader( std::string filename, ULONG buffer_size ) : m_buffer_size(buffer_size) {
+        m_file.open(filename.c_str(), std::ios::binary);
+        fill();
+}
+
+void edge_run_reader::fill() {
+        m_buffer.resize(m_buffer_size);
+        m_file.read((char*)(m_buffer.data()), m_buffer_size*sizeof(edge_pair));
+        m_buffer.resize(m_file.gcount() / sizeof(edge_pair));
+        m_pos = 0;
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * edge_list_converter.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef EDGE_LIST_CONVERTER_R2XW8N5C
+#define EDGE_LIST_CONVERTER_R2XW8N5C
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "definitions.h"
+
+struct edge_pair {
+        ULONG source;
+        ULONG target;
+};
+
+// layout of the input lines
+enum EdgeListFormat {
+        EDGE_LIST_PAIRS,     // source and target, further columns (weights, timestamps) are ignored
+        EDGE_LIST_ADJACENCY  // source followed by all of its targets
+};
+
+// converts an edge list into a METIS or binary graph file using a bounded amount of memory.
+// every line of the input starts with a source that is followed by its target or, in the
+// adjacency format, by all of its targets. the edges are symmetrized and sorted in runs that fit into the memory budget,
+// the runs are written to disk and merged, duplicate edges and self-loops are removed.
+// the nodes that have at least one edge are numbered consecutively in the order of their ids.
+class edge_list_converter {
+public:
+        edge_list_converter( ULONG memory_budget_in_mb );
+        virtual ~edge_list_converter();
+
+        // output files ending with .bgf are written in the binary format
+        int convert( std::string input_filename, std::string output_filename, ULONG skip_lines, EdgeListFormat format );
+
+        ULONG number_of_selfloops()  { return m_selfloops; };
+        ULONG number_of_singletons() { return m_singletons; };
+
+private:
+        // reads the input and writes sorted runs without duplicates to disk
+        bool create_runs( std::string input_filename, std::string output_filename, ULONG skip_lines, EdgeListFormat format );
+
+        void write_run( std::vector< edge_pair > & edges, std::string output_filename );
+
+        // merges the runs into a single sorted run without duplicates and collects the node ids
+        void merge_runs( std::string merged_filename );
+
+        void write_metis( std::string merged_filename, std::string output_filename );
+        void write_binary( std::string merged_filename, std::string output_filename );
+
+        NodeID new_id( ULONG id ) {
+                return std::lower_bound(m_node_ids.begin(), m_node_ids.end(), id) - m_node_ids.begin();
+        }
+
+        // least significant digit radix sort by source and then target, the digits
+        // on which all pairs agree are skipped
+        static void radix_sort( std::vector< edge_pair > & edges, std::vector< edge_pair > & buffer );
+
+        ULONG m_run_capacity;
+        std::vector< std::string > m_run_filenames;
+
+        std::vector< ULONG > m_node_ids;
+        ULONG m_edges;
+
+        ULONG m_edges_read;
+        ULONG m_selfloops;
+        ULONG m_singletons;
+};
+
+// sequential reader of a run file
+class edge_run_reader {
+public:
+        edge_run_reader( std::string filename, ULONG buffer_size );
+        virtual ~edge_run_reader() {};
+
+        bool has_next() { return m_pos < m_buffer.size(); };
+        const edge_pair & current() { return m_buffer[m_pos]; };
+        void next() {
+                m_pos++;
+                if( m_pos == m_buffer.size() ) fill();
+        };
+
+private:
+        void fill();
+
+        std::ifstream m_file;
+        std::vector< edge_pair > m_buffer;
+        ULONG m_buffer_size;
+        ULONG m_pos;
+};
+
+
+#endif /* end of include guard: EDGE_LIST_CONVERTER_R2XW8N5C */
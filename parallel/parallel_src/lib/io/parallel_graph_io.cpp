@@ -7,6 +7,7 @@
 
 #define _FILE_OFFSET_BITS 64
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -22,6 +23,9 @@
 
 const ULONG fileTypeVersionNumber = 3;
 const ULONG header_count          = 3;
+const ULONG lineIndexVersionNumber = 1;
+const ULONG line_index_stride      = 1024;
+const ULONG max_io_chunk           = 1 << 30; // bytes per MPI_File read or write call
 
 
 parallel_graph_io::parallel_graph_io() {
@@ -58,35 +62,261 @@ int parallel_graph_io::readGraphWeighted(PPartitionConfig & config,
         return readGraphWeightedFlexible(G, filename, peID, comm_size, communicator);
 }
 
-int parallel_graph_io::readGraphWeightedFlexible(parallel_graph_access & G, 
-                                                 std::string filename, 
-                                                 PEID peID, PEID comm_size, MPI_Comm communicator) {
-        std::string line;
+void parallel_graph_io::check_id_width(ULONG n, PEID peID) {
+        if( n > std::numeric_limits<NodeID>::max() ) {
+                if( peID == ROOT ) std::cout <<  "graph has too many nodes for 32 bit node ids, use a build without PARHIP32BIT"  << std::endl;
+                MPI_Finalize(); exit(0);
+        }
+}
 
-        // open file for reading
-        std::ifstream in(filename.c_str());
-        if (!in) {
-                std::cerr << "Error opening " << filename << std::endl;
-                return 1;
+void parallel_graph_io::read_at_all(MPI_File & fh, ULONG offset, char* buffer, ULONG bytes, MPI_Comm communicator) {
+        // all PEs have to take part in every round of the collective read
+        ULONG rounds = (bytes + max_io_chunk - 1) / max_io_chunk;
+        ULONG global_rounds = 0;
+        MPI_Allreduce(&rounds, &global_rounds, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, communicator);
+
+        for( ULONG r = 0; r < global_rounds; r++) {
+                ULONG start = std::min(r*max_io_chunk, bytes);
+                ULONG count = std::min(max_io_chunk, bytes - start);
+                MPI_File_read_at_all(fh, offset + start, buffer + start, (int)count, MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+}
+
+void parallel_graph_io::read_at(MPI_File & fh, ULONG offset, char* buffer, ULONG bytes) {
+        for( ULONG start = 0; start < bytes; start += max_io_chunk) {
+                ULONG count = std::min(max_io_chunk, bytes - start);
+                MPI_File_read_at(fh, offset + start, buffer + start, (int)count, MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+}
+
+void parallel_graph_io::write_at(MPI_File & fh, ULONG offset, const char* buffer, ULONG bytes) {
+        for( ULONG start = 0; start < bytes; start += max_io_chunk) {
+                ULONG count = std::min(max_io_chunk, bytes - start);
+                MPI_File_write_at(fh, offset + start, (void*)(buffer + start), (int)count, MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+}
+
+int parallel_graph_io::read_metis_header(std::string filename, ULONG & n, ULONG & m, int & ew, 
+                                         PEID peID, MPI_Comm communicator, ULONG * data_begin) {
+        std::vector< ULONG > buffer(5, 0);
+        if( peID == ROOT ) {
+                std::ifstream in(filename.c_str());
+                if (in) {
+                        std::string line;
+                        std::getline(in,line);
+                        //skip comments
+                        while( line[0] == '%' ) {
+                                std::getline(in, line);
+                        }
+
+                        ULONG weighted = 0;
+                        std::stringstream ss(line);
+                        ss >> buffer[1];
+                        ss >> buffer[2];
+                        ss >> weighted;
+                        buffer[0] = 1;
+                        buffer[3] = weighted;
+                        buffer[4] = in.tellg();
+                } else {
+                        std::cerr << "Error opening " << filename << std::endl;
+                }
+        }
+
+        MPI_Bcast(&buffer[0], 5, MPI_UNSIGNED_LONG_LONG, ROOT, communicator);
+        if( buffer[0] == 0 ) return 1;
+
+        n  = buffer[1];
+        m  = buffer[2];
+        ew = buffer[3];
+        if( data_begin != NULL ) *data_begin = buffer[4];
+        return 0;
+}
+
+ULONG parallel_graph_io::next_line_start(MPI_File & fh, ULONG pos, ULONG file_size) {
+        if( pos == 0 || pos >= file_size ) return std::min(pos, file_size);
+
+        // the line starts behind the first line break at or after pos-1
+        std::vector< char > buffer(1 << 16);
+        for( ULONG start = pos - 1; start < file_size; start += buffer.size()) {
+                ULONG count = std::min((ULONG)buffer.size(), file_size - start);
+                read_at(fh, start, &buffer[0], count);
+                for( ULONG i = 0; i < count; i++) {
+                        if( buffer[i] == '\n' ) return start + i + 1;
+                }
         }
+        return file_size;
+}
+
+bool parallel_graph_io::read_line_block(MPI_File & fh, ULONG & pos, ULONG end, std::string & lines) {
+        if( pos >= end ) return false;
 
-        NodeID nmbNodes;
-        EdgeID nmbEdges;
+        // double the block until it contains a line break, the last line may end at end
+        ULONG block = 1 << 26;
+        for(;;) {
+                ULONG count = std::min(block, end - pos);
+                lines.resize(count);
+                read_at(fh, pos, &lines[0], count);
+                if( pos + count == end ) break;
+
+                size_t last = lines.rfind('\n');
+                if( last != std::string::npos ) {
+                        lines.resize(last + 1);
+                        break;
+                }
+                block *= 2;
+        }
+        pos += lines.size();
+        return true;
+}
 
-        std::getline(in,line);
-        //skip comments
-        while( line[0] == '%' ) {
-                std::getline(in, line);
+void parallel_graph_io::parse_targets(const char* line, const char* line_end, bool read_nw, bool read_ew, 
+                                      std::vector< ULONG > & targets) {
+        targets.clear();
+        ULONG token = 0;
+        const char* pos = line;
+        for(;;) {
+                while( pos < line_end && (*pos == ' ' || *pos == '\t' || *pos == '\r') ) pos++;
+                if( pos >= line_end ) break;
+
+                char* next = NULL;
+                ULONG value = strtoull(pos, &next, 10);
+                if( next == pos ) break;
+                pos = next;
+
+                // the node weight comes first, the weight of an edge follows its target
+                ULONG edge_token = read_nw ? token - 1 : token;
+                if( !(read_nw && token == 0) && !(read_ew && edge_token % 2 == 1) ) {
+                        targets.push_back(value);
+                }
+                token++;
         }
+}
 
+void parallel_graph_io::load_line_index(std::string filename, ULONG n, std::vector< ULONG > & index) {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        in.seekg(0, std::ios::end);
+        ULONG file_size = in.tellg();
+
+        std::string index_filename = filename + ".idx";
+        std::ifstream index_file(index_filename.c_str(), std::ios::binary);
+        if( index_file ) {
+                // header: version, size of the graph file, n, stride, number of entries
+                std::vector< ULONG > header(5, 0);
+                index_file.read((char*)(&header[0]), 5*sizeof(ULONG));
+                if( index_file && header[0] == lineIndexVersionNumber && header[1] == file_size 
+                    && header[2] == n && header[3] == line_index_stride ) {
+                        index.resize(header[4]);
+                        index_file.read((char*)(&index[0]), header[4]*sizeof(ULONG));
+                        if( index_file ) return;
+                }
+                std::cout <<  "line index " << index_filename << " is outdated"  << std::endl;
+        }
+        index_file.close();
+
+        std::cout <<  "building line index " << index_filename << " ..."  << std::endl;
+        index.clear();
+
+        // the first line that is not a comment is the header, every following line 
+        // that is not a comment belongs to the next node
+        std::vector< char > buffer(1 << 24);
+        bool header_seen = false;
+        bool line_start  = true;
+        ULONG node       = 0;
+        ULONG pos        = 0;
+        in.seekg(0, std::ios::beg);
+        while( in.read(&buffer[0], buffer.size()) || in.gcount() > 0 ) {
+                ULONG read = in.gcount();
+                for( ULONG i = 0; i < read; i++, pos++) {
+                        if( line_start && buffer[i] != '%' ) {
+                                if( header_seen ) {
+                                        if( node < n && node % line_index_stride == 0 ) index.push_back(pos);
+                                        node++;
+                                } 
+                                header_seen = true;
+                        }
+                        line_start = buffer[i] == '\n';
+                }
+        }
+        index.push_back(file_size);
+
+        std::ofstream out(index_filename.c_str(), std::ios::binary);
+        if( out ) {
+                ULONG header[5] = { lineIndexVersionNumber, file_size, n, line_index_stride, (ULONG)index.size() };
+                out.write((char*)(header), 5*sizeof(ULONG));
+                out.write((char*)(&index[0]), index.size()*sizeof(ULONG));
+        }
+}
+
+int parallel_graph_io::read_local_lines(std::string filename, ULONG n, ULONG from, ULONG to, 
+                                        PEID peID, PEID comm_size, MPI_Comm communicator, std::string & local_lines) {
+        // the root translates the node ranges of all PEs into byte ranges of the file
+        std::vector< ULONG > node_range(2);
+        node_range[0] = from;
+        node_range[1] = to + 1;
+        std::vector< ULONG > node_ranges(2*comm_size);
+        MPI_Gather(&node_range[0], 2, MPI_UNSIGNED_LONG_LONG, &node_ranges[0], 2, MPI_UNSIGNED_LONG_LONG, ROOT, communicator);
+
+        // begin and end of the byte range and the number of node lines to skip at its beginning
+        std::vector< ULONG > byte_ranges(3*comm_size, 0);
+        if( peID == ROOT ) {
+                std::vector< ULONG > index;
+                load_line_index(filename, n, index);
+
+                ULONG checkpoints = index.size() - 1;
+                for( PEID pe = 0; pe < comm_size; pe++) {
+                        ULONG first = node_ranges[2*pe];
+                        ULONG last  = std::min(node_ranges[2*pe+1], n);
+                        if( first >= last ) continue;
+
+                        ULONG begin_checkpoint = first / line_index_stride;
+                        ULONG end_checkpoint   = (last + line_index_stride - 1) / line_index_stride;
+                        byte_ranges[3*pe]   = index[begin_checkpoint];
+                        byte_ranges[3*pe+1] = index[std::min(end_checkpoint, checkpoints)];
+                        byte_ranges[3*pe+2] = first - begin_checkpoint*line_index_stride;
+                }
+        }
+
+        std::vector< ULONG > byte_range(3);
+        MPI_Scatter(&byte_ranges[0], 3, MPI_UNSIGNED_LONG_LONG, &byte_range[0], 3, MPI_UNSIGNED_LONG_LONG, ROOT, communicator);
+
+        MPI_File fh;
+        int err = MPI_File_open(communicator, (char*)filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+        if( err != MPI_SUCCESS ) {
+                if( peID == ROOT ) std::cerr << "Error opening " << filename << std::endl;
+                return 1;
+        }
+
+        std::string buffer(byte_range[1] - byte_range[0], ' ');
+        read_at_all(fh, byte_range[0], &buffer[0], buffer.size(), communicator);
+        MPI_File_close(&fh);
+
+        // skip the lines in front of the first local node
+        ULONG pos = 0;
+        ULONG skipped = 0;
+        while( pos < buffer.size() && skipped < byte_range[2] ) {
+                if( buffer[pos] != '%' ) skipped++;
+                pos = buffer.find('\n', pos);
+                pos = pos == std::string::npos ? buffer.size() : pos + 1;
+        }
+        local_lines = buffer.substr(pos);
+
+        return 0;
+}
+
+int parallel_graph_io::readGraphWeightedFlexible(parallel_graph_access & G, 
+                                                 std::string filename, 
+                                                 PEID peID, PEID comm_size, MPI_Comm communicator) {
+        std::string line;
+
+        ULONG nmbNodes;
+        ULONG nmbEdges;
         int ew = 0;
-        std::stringstream ss(line);
-        ss >> nmbNodes;
-        ss >> nmbEdges;
-        ss >> ew;
+        if( read_metis_header(filename, nmbNodes, nmbEdges, ew, peID, communicator) ) {
+                return 1;
+        }
+        check_id_width(nmbNodes, peID);
 
         if(ew != 0) {
-                in.close();
                 if(peID == 0) std::cout <<  "graph is weighted --> using a different IO routine"  << std::endl;
                 return readGraphWeightedMETIS_fixed(G, filename, peID, comm_size, communicator);
         }
@@ -102,7 +332,13 @@ int parallel_graph_io::readGraphWeightedFlexible(parallel_graph_access & G,
         std::vector< std::vector< NodeID > > local_edge_lists;
         local_edge_lists.resize(local_no_nodes);
         
-        ULONG counter  = 0;
+        std::string local_lines;
+        if( read_local_lines(filename, nmbNodes, from, to, peID, comm_size, communicator, local_lines) ) {
+                return 1;
+        }
+        std::istringstream in(local_lines);
+
+        ULONG counter  = from;
         NodeID node_counter = 0;
         EdgeID edge_counter = 0;
 
@@ -382,93 +618,129 @@ int parallel_graph_io::readGraphWeightedFlexible(parallel_graph_access & G,
         //return 0;
 //}
 
-int parallel_graph_io::writeGraphExternallyBinary(std::string input_filename, std::string output_filename) {
-
-        std::string line;
+int parallel_graph_io::writeGraphExternallyBinary(std::string input_filename, std::string output_filename, 
+                                                  MPI_Comm communicator) {
+        PEID rank, size;
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
 
-        // open file for reading
-        std::ifstream in(input_filename.c_str());
-        if (!in) {
-                std::cerr << "Error opening " << input_filename << std::endl;
+        ULONG n;
+        ULONG m;
+        int ew = 0;
+        ULONG data_begin = 0;
+        if( read_metis_header(input_filename, n, m, ew, rank, communicator, &data_begin) ) {
                 return 1;
         }
+        m *= 2;
 
-        NodeID n;
-        EdgeID m;
+        bool read_ew = ew == 1 || ew == 11;
+        bool read_nw = ew == 10 || ew == 11;
 
-        std::getline(in,line);
-        //skip comments
-        while( line[0] == '%' ) {
-                std::getline(in, line);
+        MPI_File in;
+        if( MPI_File_open(communicator, (char*)input_filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &in) != MPI_SUCCESS ) {
+                if( rank == ROOT ) std::cerr << "Error opening " << input_filename << std::endl;
+                return 1;
         }
 
-        int ew = 0;
-        std::stringstream ss(line);
-        ss >> n;
-        ss >> m;
-        ss >> ew;
-
-        m *= 2;
-
-        std::ofstream outfile;
-        outfile.open(output_filename.c_str(), std::ios::binary | std::ios::out);
-        outfile.write((char*)(&fileTypeVersionNumber), sizeof( ULONG ));
-        outfile.write((char*)(&n), sizeof( ULONG ));
-        outfile.write((char*)(&m), sizeof( ULONG ));
-        
-        NodeID offset = (header_count + n + 1) * (sizeof(ULONG));
-
-        while( std::getline(in, line) ) {
-                if (line[0] == '%') { // a comment in the file
-                        continue;
+        // every PE converts the lines that start in its share of the bytes
+        MPI_Offset size_of_file;
+        MPI_File_get_size(in, &size_of_file);
+        ULONG file_size  = size_of_file;
+        ULONG share      = ceil((file_size - data_begin) / (double)size);
+        ULONG from_byte  = std::min(data_begin + rank*share, file_size);
+        ULONG to_byte    = std::min(data_begin + (rank+1)*share, file_size);
+        ULONG begin      = rank == 0 ? data_begin : next_line_start(in, from_byte, file_size);
+        ULONG end        = next_line_start(in, to_byte, file_size);
+
+        std::string lines;
+        std::vector< ULONG > targets;
+
+        // first pass: count the local nodes and edges
+        ULONG local_nodes = 0;
+        ULONG local_edges = 0;
+        ULONG pos = begin;
+        while( read_line_block(in, pos, end, lines) ) {
+                const char* line     = lines.c_str();
+                const char* last     = line + lines.size();
+                while( line < last ) {
+                        const char* line_end = std::find(line, last, '\n');
+                        if( *line != '%' ) { // a comment in the file
+                                parse_targets(line, line_end, read_nw, read_ew, targets);
+                                local_nodes++;
+                                local_edges += targets.size();
+                        }
+                        line = line_end + 1;
                 }
+        }
 
-                std::stringstream ss(line);
-
-                EdgeID edge_counter = 0;
-                NodeID target;
-                while( ss >> target ) {
-                        edge_counter++;
-                }
-                outfile.write((char*)(&offset), sizeof( ULONG ));
-                offset += edge_counter*sizeof( ULONG );
+        ULONG first_node = 0;
+        ULONG first_edge = 0;
+        MPI_Exscan(&local_nodes, &first_node, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        MPI_Exscan(&local_edges, &first_edge, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        if( rank == 0 ) { first_node = 0; first_edge = 0; }
+
+        ULONG total_nodes = 0;
+        ULONG total_edges = 0;
+        MPI_Allreduce(&local_nodes, &total_nodes, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        MPI_Allreduce(&local_edges, &total_edges, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        if( total_nodes != n ) {
+                if( rank == ROOT ) std::cerr << "file has " << total_nodes << " adjacency lines but the header specifies " 
+                                             << n << " nodes" << std::endl;
+                MPI_File_close(&in);
+                return 1;
+        }
 
-                if( in.eof() ) {
-                        break;
-                }
+        MPI_File out;
+        if( MPI_File_open(communicator, (char*)output_filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, 
+                          MPI_INFO_NULL, &out) != MPI_SUCCESS ) {
+                if( rank == ROOT ) std::cerr << "Error opening " << output_filename << std::endl;
+                MPI_File_close(&in);
+                return 1;
         }
-        outfile.write((char*)(&offset), sizeof( ULONG ));
-        in.close();
+        ULONG edge_begin = (header_count + n + 1) * (sizeof(ULONG));
+        MPI_File_set_size(out, edge_begin + total_edges * sizeof(ULONG));
 
-        // second stream to actually write the edges
-        std::ifstream second_in(input_filename.c_str());
-        std::getline(second_in,line);
-        //skip comments
-        while( line[0] == '%' ) {
-                std::getline(second_in, line);
+        if( rank == ROOT ) {
+                ULONG header[3]   = { fileTypeVersionNumber, n, m };
+                ULONG last_offset = edge_begin + total_edges * sizeof(ULONG);
+                MPI_File_write_at(out, 0, header, 3*sizeof(ULONG), MPI_BYTE, MPI_STATUS_IGNORE);
+                MPI_File_write_at(out, (header_count + n) * sizeof(ULONG), &last_offset, sizeof(ULONG), MPI_BYTE, MPI_STATUS_IGNORE);
         }
 
-        while( std::getline(second_in, line) ) {
-                if (line[0] == '%') { // a comment in the file
-                        continue;
+        // second pass: write the offsets and the edges of the local nodes
+        ULONG node   = first_node;
+        ULONG offset = edge_begin + first_edge * sizeof(ULONG);
+        std::vector< ULONG > offsets;
+        std::vector< ULONG > edges;
+        pos = begin;
+        while( read_line_block(in, pos, end, lines) ) {
+                offsets.clear();
+                edges.clear();
+
+                const char* line     = lines.c_str();
+                const char* last     = line + lines.size();
+                while( line < last ) {
+                        const char* line_end = std::find(line, last, '\n');
+                        if( *line != '%' ) { // a comment in the file
+                                parse_targets(line, line_end, read_nw, read_ew, targets);
+                                offsets.push_back(offset + edges.size() * sizeof(ULONG));
+                                for( ULONG i = 0; i < targets.size(); i++) {
+                                        edges.push_back(targets[i] - 1);
+                                }
+                        }
+                        line = line_end + 1;
                 }
 
-                std::stringstream ss(line);
+                write_at(out, (header_count + node) * sizeof(ULONG), (const char*)offsets.data(), offsets.size()*sizeof(ULONG));
+                write_at(out, offset, (const char*)edges.data(), edges.size()*sizeof(ULONG));
+                node   += offsets.size();
+                offset += edges.size() * sizeof(ULONG);
+        }
 
-                NodeID target;
-                while( ss >> target ) {
-                        target -= 1;
-                        outfile.write((char*)(&target), sizeof( ULONG ));
-                }
+        MPI_File_close(&in);
+        MPI_File_close(&out);
 
-                if( second_in.eof() ) {
-                        break;
-                }
-        }
-        second_in.close();
-        
         return 0;
-
 }
 
 int parallel_graph_io::writeGraphSequentiallyBinary(complete_graph_access & G, std::string filename) {
@@ -483,21 +755,21 @@ int parallel_graph_io::writeGraphSequentiallyBinary(complete_graph_access & G, s
         }
 
         std::cout <<  "Writing graph " << filename  << std::endl;
-        printf("Writing graph with n = %lld, m = %lld\n", G.number_of_global_nodes(), G.number_of_global_edges());
+        printf("Writing graph with n = %lld, m = %lld\n", (ULONG)G.number_of_global_nodes(), (ULONG)G.number_of_global_edges());
 
         //write version number
         outfile.write((char*)(&fileTypeVersionNumber), sizeof( ULONG ));
 
         //write number of nodes etc
-        NodeID n = G.number_of_global_nodes();
-        NodeID m = G.number_of_global_edges();
+        ULONG n = G.number_of_global_nodes();
+        ULONG m = G.number_of_global_edges();
 
         outfile.write((char*)(&n), sizeof( ULONG ));
         outfile.write((char*)(&m), sizeof( ULONG ));
 
-        NodeID * offset_array = new NodeID[n+1];
+        ULONG * offset_array = new ULONG[n+1];
         ULONG pos              = 0;
-        NodeID offset         = (header_count + G.number_of_global_nodes() + 1) * (sizeof(ULONG));
+        ULONG offset          = (header_count + G.number_of_global_nodes() + 1) * (sizeof(ULONG));
 
         forall_local_nodes(G, node) {
                 offset_array[pos++] = offset;
@@ -508,7 +780,7 @@ int parallel_graph_io::writeGraphSequentiallyBinary(complete_graph_access & G, s
         outfile.write((char*)(offset_array), (n+1)*sizeof(ULONG));
         delete[] offset_array;
 
-        NodeID * edge_array = new NodeID[m];
+        ULONG * edge_array = new ULONG[m];
         pos = 0;
 
         // now write the edges 
@@ -530,103 +802,85 @@ int parallel_graph_io::readGraphBinary(PPartitionConfig & config, parallel_graph
                                             std::string filename, 
                                             PEID peID, PEID size, MPI_Comm communicator) { 
 
-        // read header
-        std::vector< ULONG > buffer(3, 0);
-        int success = 0;
-        if( peID == ROOT) {
-                std::cout <<  "Reading binary graph ..."  << std::endl;
-                std::ifstream file;
-                file.open(filename.c_str(), std::ios::binary | std::ios::in);
-                if(file) {
-                        success = 1;
-                        file.read((char*)(&buffer[0]), 3*sizeof(ULONG));
-                }
-                file.close();
-        }
+        if( peID == ROOT) std::cout <<  "Reading binary graph ..."  << std::endl;
 
-        MPI_Bcast(&success, 1, MPI_INT, ROOT, communicator);
+        // the window size limits the number of PEs that access the file system,
+        // i.e. the number of aggregators of the collective reads
+        PEID window_size = std::min(config.binary_io_window_size, size);
+        std::stringstream aggregators; aggregators << window_size;
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, (char*)"cb_nodes", (char*)aggregators.str().c_str());
 
-        if( !success ) {
+        MPI_File fh;
+        int err = MPI_File_open(communicator, (char*)filename.c_str(), MPI_MODE_RDONLY, info, &fh);
+        MPI_Info_free(&info);
+
+        if( err != MPI_SUCCESS ) {
                 if( peID == ROOT ) std::cout <<  "problem to open the file"  << std::endl;
                 MPI_Finalize();
                 exit(0);
         }
 
-        MPI_Bcast(&buffer[0], 3, MPI_LONG, ROOT, communicator);
+        // read header
+        std::vector< ULONG > buffer(3, 0);
+        read_at_all(fh, 0, (char*)(&buffer[0]), 3*sizeof(ULONG), communicator);
         ULONG version = buffer[0];
-        NodeID n     = buffer[1];
-        NodeID m     = buffer[2];
+        ULONG n      = buffer[1];
+        ULONG m      = buffer[2];
 
         if(peID == ROOT) std::cout <<  "version: " <<  version <<  " n: "<<  n <<  " m: " <<  m  << std::endl;
         if( version != fileTypeVersionNumber ) {
                 if(peID == ROOT) std::cout <<  "filetype version missmatch"  << std::endl;
                 MPI_Finalize(); exit(0);
         }
+        check_id_width(n, peID);
 
-        PEID window_size = std::min(config.binary_io_window_size, size);
-        PEID lowPE = 0;
-        PEID highPE = window_size;
+        ULONG from = peID * ceil(n / (double)size);
+        ULONG to   = (peID +1) * ceil(n / (double)size) - 1;
+        to = std::min(to, n-1);
 
-                
-        while ( lowPE < size ) {
-                if( peID >= lowPE && peID < highPE ) {
-                        std::ifstream file;
-                        file.open(filename.c_str(), std::ios::binary | std::ios::in);
-
-                        ULONG from = peID * ceil(n / (double)size);
-                        ULONG to   = (peID +1) * ceil(n / (double)size) - 1;
-                        to = std::min(to, n-1);
-
-                        ULONG local_no_nodes = to - from + 1;
-                        std::cout <<  "peID " <<  peID <<  " from " <<  from <<  " to " <<  to  <<  " amount " <<  local_no_nodes << std::endl;
-
-                        // read the offsets
-                        ULONG start_pos = (header_count + from)*(sizeof(ULONG));
-                        NodeID* vertex_offsets = new NodeID[local_no_nodes+1]; // we also need the next vertex offset
-                        file.seekg(start_pos);
-                        file.read((char*)(vertex_offsets), (local_no_nodes+1)*sizeof(ULONG));
-
-                        ULONG  edge_start_pos = vertex_offsets[0];
-                        EdgeID num_reads             = vertex_offsets[local_no_nodes]-vertex_offsets[0];
-                        EdgeID num_edges_to_read     = num_reads/sizeof(ULONG);
-                        EdgeID* edges = new EdgeID[num_edges_to_read]; // we also need the next vertex offset
-                        file.seekg(edge_start_pos);
-                        file.read((char*)(edges), (num_edges_to_read)*sizeof(ULONG));
-
-                        G.start_construction(local_no_nodes, num_edges_to_read, n, m);
-                        G.set_range(from, to);
-
-                        std::vector< NodeID > vertex_dist( size+1, 0 );
-                        for( PEID peID = 0; peID <= size; peID++) {
-                                vertex_dist[peID] = peID * ceil(n / (double)size); // from positions
-                        }
-                        G.set_range_array(vertex_dist);
-
-                        ULONG pos = 0;
-                        for (NodeID i = 0; i < local_no_nodes; ++i) {
-                                NodeID node = G.new_node();
-                                G.setNodeWeight(node, 1);
-                                G.setNodeLabel(node, from+node);
-                                G.setSecondPartitionIndex(node, 0);
-
-                                NodeID degree =  (vertex_offsets[i+1] - vertex_offsets[i]) / sizeof(ULONG);
-                                for( ULONG j = 0; j < degree; j++, pos++) {
-                                        NodeID target = edges[pos]; 
-                                        EdgeID e = G.new_edge(node, target);
-                                        G.setEdgeWeight(e, 1);
-                                }
-                        }
+        ULONG local_no_nodes = to - from + 1;
+        std::cout <<  "peID " <<  peID <<  " from " <<  from <<  " to " <<  to  <<  " amount " <<  local_no_nodes << std::endl;
 
-                        G.finish_construction();
+        // read the offsets
+        ULONG start_pos = (header_count + from)*(sizeof(ULONG));
+        std::vector< ULONG > vertex_offsets(local_no_nodes+1); // we also need the next vertex offset
+        read_at_all(fh, start_pos, (char*)(&vertex_offsets[0]), (local_no_nodes+1)*sizeof(ULONG), communicator);
 
-                        delete[] vertex_offsets;
-                        delete[] edges;
-                        file.close();
+        ULONG  edge_start_pos        = vertex_offsets[0];
+        ULONG  num_reads             = vertex_offsets[local_no_nodes]-vertex_offsets[0];
+        ULONG  num_edges_to_read     = num_reads/sizeof(ULONG);
+        std::vector< ULONG > edges(num_edges_to_read + 1); 
+        read_at_all(fh, edge_start_pos, (char*)(&edges[0]), num_reads, communicator);
+        MPI_File_close(&fh);
+
+        G.start_construction(local_no_nodes, num_edges_to_read, n, m);
+        G.set_range(from, to);
+
+        std::vector< NodeID > vertex_dist( size+1, 0 );
+        for( PEID peID = 0; peID <= size; peID++) {
+                vertex_dist[peID] = peID * ceil(n / (double)size); // from positions
+        }
+        G.set_range_array(vertex_dist);
+
+        ULONG pos = 0;
+        for (NodeID i = 0; i < local_no_nodes; ++i) {
+                NodeID node = G.new_node();
+                G.setNodeWeight(node, 1);
+                G.setNodeLabel(node, from+node);
+                G.setSecondPartitionIndex(node, 0);
+
+                NodeID degree =  (vertex_offsets[i+1] - vertex_offsets[i]) / sizeof(ULONG);
+                for( ULONG j = 0; j < degree; j++, pos++) {
+                        NodeID target = edges[pos]; 
+                        EdgeID e = G.new_edge(node, target);
+                        G.setEdgeWeight(e, 1);
                 }
-                lowPE  += window_size;
-                highPE += window_size;
-                MPI_Barrier(communicator);
         }
+
+        G.finish_construction();
+        MPI_Barrier(communicator);
         
         return 0;
 }
@@ -750,35 +1004,20 @@ int parallel_graph_io::writeGraphSequentially(complete_graph_access & G, std::st
 
 }
 
-// we start with the simplest version of IO 
-// where each process reads the graph sequentially
-// TODO write weighted code and fully parallel io code
+// each process reads the lines of its nodes with collective MPI-IO reads,
+// the byte ranges are taken from the line index of the file
 int parallel_graph_io::readGraphWeightedMETIS_fixed(parallel_graph_access & G, 
                                          std::string filename, 
                                          PEID peID, PEID comm_size, MPI_Comm communicator) {
         std::string line;
 
-        // open file for reading
-        std::ifstream in(filename.c_str());
-        if (!in) {
-                std::cerr << "Error opening " << filename << std::endl;
+        ULONG nmbNodes;
+        ULONG nmbEdges;
+        int ew = 0;
+        if( read_metis_header(filename, nmbNodes, nmbEdges, ew, peID, communicator) ) {
                 return 1;
         }
-
-        NodeID nmbNodes;
-        EdgeID nmbEdges;
-
-        std::getline(in,line);
-        //skip comments
-        while( line[0] == '%' ) {
-                std::getline(in, line);
-        }
-
-        int ew = 0;
-        std::stringstream ss(line);
-        ss >> nmbNodes;
-        ss >> nmbEdges;
-        ss >> ew;
+        check_id_width(nmbNodes, peID);
 
         // pe p reads the lines p*ceil(n/size) to (p+1)floor(n/size) lines of that file
         ULONG from           = peID     * ceil(nmbNodes / (double)comm_size);
@@ -808,8 +1047,13 @@ int parallel_graph_io::readGraphWeightedMETIS_fixed(parallel_graph_access & G,
                 read_nw = true;
         }
 
-        //std::getline(in, line);
-        unsigned long counter      = 0;
+        std::string local_lines;
+        if( read_local_lines(filename, nmbNodes, from, to, peID, comm_size, communicator, local_lines) ) {
+                return 1;
+        }
+        std::istringstream in(local_lines);
+
+        unsigned long counter      = from;
         NodeID node_counter = 0;
         EdgeID edge_counter = 0;
 
@@ -60,10 +60,51 @@ class parallel_graph_io {
 
                 static int writeGraphSequentiallyBinary(complete_graph_access & G, std::string filename);
 
-                static int writeGraphExternallyBinary(std::string intput_filename, std::string output_filename);
+                // streams a METIS file into a binary file, every PE converts a byte range of the input
+                static int writeGraphExternallyBinary(std::string input_filename, std::string output_filename, 
+                                MPI_Comm communicator = MPI_COMM_WORLD);
 
                 static int readGraphWeightedMETIS_fixed(parallel_graph_access & G, std::string filename, PEID peID, PEID comm_size, MPI_Comm communicator = MPI_COMM_WORLD); 
 
+                // aborts if n ids do not fit into the width of NodeID (PARHIP32BIT), 
+                // the number of edges is not limited since EdgeID always has 64 bits
+                static void check_id_width(ULONG n, PEID peID);
+
+        private:
+                // collective read of a byte range, split into pieces whose size fits into an int
+                static void read_at_all(MPI_File & fh, ULONG offset, char* buffer, ULONG bytes, MPI_Comm communicator);
+
+                // non collective read of a byte range
+                static void read_at(MPI_File & fh, ULONG offset, char* buffer, ULONG bytes);
+
+                // non collective write of a byte range, split like the reads
+                static void write_at(MPI_File & fh, ULONG offset, const char* buffer, ULONG bytes);
+
+                // the root reads the header line of a METIS file and broadcasts it together 
+                // with the byte offset of the line that follows the header
+                static int read_metis_header(std::string filename, ULONG & n, ULONG & m, int & ew, 
+                                PEID peID, MPI_Comm communicator, ULONG * data_begin = NULL);
+
+                // returns the offset of the first line that starts at or after pos
+                static ULONG next_line_start(MPI_File & fh, ULONG pos, ULONG file_size);
+
+                // reads complete lines from pos on, but not beyond end, and advances pos behind them.
+                // returns false if there is nothing left to read
+                static bool read_line_block(MPI_File & fh, ULONG & pos, ULONG end, std::string & lines);
+
+                // parses the targets of the adjacency line [line, line_end) and skips the weights
+                static void parse_targets(const char* line, const char* line_end, bool read_nw, bool read_ew, 
+                                std::vector< ULONG > & targets);
+
+                // returns the lines of the nodes from to to (and possibly a few more) of a METIS file.
+                // the byte ranges of the PEs are looked up in the line index and read collectively.
+                static int read_local_lines(std::string filename, ULONG n, ULONG from, ULONG to, 
+                                PEID peID, PEID comm_size, MPI_Comm communicator, std::string & local_lines);
+
+                // loads the line index filename.idx or builds and saves it if it is missing or outdated.
+                // entry i of the index is the byte offset of the line of node i*line_index_stride,
+                // the last entry is the size of the file.
+                static void load_line_index(std::string filename, ULONG n, std::vector< ULONG > & index);
 
 };
 
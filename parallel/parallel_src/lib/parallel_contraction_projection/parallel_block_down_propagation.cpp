@@ -5,6 +5,7 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include "communication/sparse_all_to_all.h"
 #include "parallel_block_down_propagation.h"
 
 parallel_block_down_propagation::parallel_block_down_propagation() {
@@ -46,50 +47,14 @@ void parallel_block_down_propagation::propagate_block_down( MPI_Comm communicato
                 m_messages[ peID ].push_back( block );
         }
 
-        for( PEID peID = 0; peID < size; peID++) {
-                if( peID != rank ) {
-                        if( m_messages[peID].size() == 0 ){
-                                m_messages[peID].push_back(std::numeric_limits<NodeID>::max());
-                        }
-
-                        MPI_Request rq; 
-                        MPI_Isend( &m_messages[peID][0], 
-                                   m_messages[peID].size(), 
-                                   MPI_UNSIGNED_LONG_LONG, 
-                                   peID, peID+10*size, communicator, &rq );
-                }
-        }
-
-        if( m_messages[ rank ].size() != 0 ) {
-                for( ULONG i = 0; i < (ULONG)m_messages[rank].size()-1; i+=2) {
-                        NodeID globalID   = m_messages[rank][i];
-                        NodeID node       = Q.getLocalID(globalID);
-                        NodeWeight block  = m_messages[rank][i+1];
-                        Q.setSecondPartitionIndex(node , block);
-                }
-        }
-
-        PEID counter = 0;
-        while( counter < size - 1) {
-                // wait for incomming message of an adjacent processor
-                MPI_Status st;
-                MPI_Probe(MPI_ANY_SOURCE, rank+10*size, communicator, &st);
-
-                int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
-                
-                std::vector<NodeID> incmessage; incmessage.resize(message_length);
+        sparse_all_to_all exchanger;
+        std::vector< std::vector< NodeID > > inc_blocks;
+        exchanger.exchange( communicator, m_messages, inc_blocks, 10 );
 
-                MPI_Status rst;
-                MPI_Recv( &incmessage[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+10*size, communicator, &rst); 
-                counter++;
-
-                // now integrate the changes
-                if( incmessage[0] == std::numeric_limits< NodeID >::max()) continue; // nothing to do
-
-                for( ULONG i = 0; i < incmessage.size()-1; i+=2) {
-                        NodeID globalID   = incmessage[i];
-                        NodeWeight block  = incmessage[i+1];
+        for( PEID peID = 0; peID < size; peID++) {
+                for( ULONG i = 0; i + 1 < inc_blocks[peID].size(); i+=2) {
+                        NodeID globalID   = inc_blocks[peID][i];
+                        NodeWeight block  = inc_blocks[peID][i+1];
                         NodeID node       = Q.getLocalID(globalID);
                         Q.setSecondPartitionIndex( node , block);
                 }
@@ -137,7 +102,7 @@ void parallel_block_down_propagation::update_ghost_nodes_blocks( MPI_Comm commun
 
                         MPI_Request rq;
                         MPI_Isend( &m_send_buffers[peID][0], 
-                                    m_send_buffers[peID].size(), MPI_UNSIGNED_LONG_LONG, peID, peID+11*size, communicator, &rq);
+                                    m_send_buffers[peID].size(), MPI_NODEID, peID, peID+11*size, communicator, &rq);
                 }
         }
 
@@ -149,11 +114,11 @@ void parallel_block_down_propagation::update_ghost_nodes_blocks( MPI_Comm commun
                 MPI_Probe(MPI_ANY_SOURCE, rank+11*size, communicator, &st);
                 
                 int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                MPI_Get_count(&st, MPI_NODEID, &message_length);
                 std::vector<NodeID> message; message.resize(message_length);
 
                 MPI_Status rst;
-                MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+11*size, communicator, &rst); 
+                MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, rank+11*size, communicator, &rst); 
                 counter++;
 
                 // now integrate the changes
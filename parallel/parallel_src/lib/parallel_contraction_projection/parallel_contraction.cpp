@@ -7,6 +7,7 @@
 
 #include "parallel_contraction.h"
 #include "data_structure/hashed_graph.h"
+#include "communication/sparse_all_to_all.h"
 #include "tools/helpers.h"
 
 parallel_contraction::parallel_contraction() {
@@ -38,10 +39,16 @@ void parallel_contraction::contract_to_distributed_quotient( MPI_Comm communicat
         get_nodes_to_cnodes_ghost_nodes( communicator, G );   
 
         //now we can really build the edges of the quotient graph
-        hashed_graph hG;
-        std::unordered_map< NodeID, NodeWeight > node_weights;
+        //every local node and every cut edge contributes at most one entry
+        ULONG max_entries = G.number_of_local_nodes();
+        forall_local_nodes(G, node) {
+                forall_out_edges(G, e, node) {
+                        if( G.getCNode( node ) != G.getCNode( G.getEdgeTarget(e) ) ) max_entries++;
+                } endfor
+        } endfor
 
-        build_quotient_graph_locally( G, number_of_distinct_labels, hG, node_weights);
+        hashed_graph hG( max_entries );
+        build_quotient_graph_locally( G, hG );
         
         MPI_Barrier(communicator);
 
@@ -52,7 +59,7 @@ void parallel_contraction::contract_to_distributed_quotient( MPI_Comm communicat
         m_send_buffers.resize(0); 
         std::vector< std::vector< NodeID > >(m_send_buffers).swap(m_send_buffers);
 
-        redistribute_hased_graph_and_build_graph_locally( communicator, hG, node_weights, number_of_distinct_labels, Q );
+        redistribute_hased_graph_and_build_graph_locally( communicator, hG, number_of_distinct_labels, Q );
         update_ghost_nodes_weights( communicator, Q );
 }
 
@@ -82,62 +89,16 @@ void parallel_contraction::compute_label_mapping( MPI_Comm communicator, paralle
                 }
         }
 
-        // now flood the network
-        for( PEID peID = 0; peID < size; peID++) {
-                if( peID != rank ) {
-                        if( m_messages[peID].size() == 0 ){
-                                m_messages[peID].push_back(std::numeric_limits<NodeID>::max());
-                        }
-
-                        MPI_Request rq; 
-                        MPI_Isend( &m_messages[peID][0], 
-                                    m_messages[peID].size(), 
-                                    MPI_UNSIGNED_LONG_LONG, 
-                                    peID, peID+4*size, communicator, &rq);
-                }
-        }
-        std::vector< std::vector< NodeID > > local_labels_byPE;
-        local_labels_byPE.resize(size);
-
-        for( ULONG i = 0; i < m_messages[rank].size(); i++) {
-                local_labels_byPE[rank].push_back(m_messages[rank][i]);
-        }
-
-
+        // send the labels to the PEs that own them, only PEs that share labels talk to each other
+        sparse_all_to_all exchanger;
         std::vector< std::vector< NodeID > >  inc_messages;
-        inc_messages.resize(size);
-
-        PEID counter = 0;
-        while( counter < size - 1) {
-                // wait for incomming message of an adjacent processor
-                MPI_Status st;
-                MPI_Probe(MPI_ANY_SOURCE, rank+4*size, communicator, &st);
-
-                int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
-                std::vector<NodeID> incmessage; incmessage.resize(message_length);
-
-                MPI_Status rst;
-                MPI_Recv( &incmessage[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+4*size, communicator, &rst); 
-                counter++;
-
-                PEID peID = st.MPI_SOURCE;
-                for( int i = 0; i < message_length; i++) {
-                        inc_messages[peID].push_back(incmessage[i]);
-                } // store those because we need to send them their mapping back
-
-                // now integrate the changes
-                if( incmessage[0] == std::numeric_limits< NodeID >::max()) continue; // nothing to do
-
-                for( int i = 0; i < message_length; i++) {
-                        local_labels_byPE[peID].push_back(incmessage[i]);
-                }
-        }
+        exchanger.exchange( communicator, m_messages, inc_messages, 4 );
 
+        // inc_messages[rank] contains the local labels
         std::vector< NodeID > local_labels;
         for( PEID peID = 0; peID < size; peID++) {
-                for( ULONG i = 0; i < local_labels_byPE[peID].size(); i++) {
-                        local_labels.push_back(local_labels_byPE[peID][i]);
+                for( ULONG i = 0; i < inc_messages[peID].size(); i++) {
+                        local_labels.push_back(inc_messages[peID][i]);
                 }
         }
 
@@ -161,11 +122,11 @@ void parallel_contraction::compute_label_mapping( MPI_Comm communicator, paralle
         NodeID local_num_labels  = local_labels.size();
         NodeID prefix_sum        = 0;
 
-        MPI_Scan(&local_num_labels, &prefix_sum, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator); 
+        MPI_Scan(&local_num_labels, &prefix_sum, 1, MPI_NODEID, MPI_SUM, communicator); 
 
         global_num_distinct_ids = prefix_sum;
         // Broadcast global number of ids
-        MPI_Bcast(&global_num_distinct_ids, 1, MPI_UNSIGNED_LONG_LONG, size-1, communicator); 
+        MPI_Bcast(&global_num_distinct_ids, 1, MPI_NODEID, size-1, communicator); 
 
         NodeID num_smaller_ids = prefix_sum - local_num_labels;
 
@@ -182,57 +143,19 @@ void parallel_contraction::compute_label_mapping( MPI_Comm communicator, paralle
         }
 
         // now send the processes the mapping back
-        //std::vector< std::vector< NodeID > >  m_out_messages;
         m_out_messages.resize(size);
-
         for( PEID peID = 0; peID < (PEID)size; peID++) {
-                if( peID == rank ) continue;
-
-                if( inc_messages[peID][0] == std::numeric_limits<NodeID>::max()) {
-                        m_out_messages[peID].push_back(std::numeric_limits<NodeID>::max());
-                        continue;
-                }
-
                 for( ULONG i = 0; i < inc_messages[peID].size(); i++) {
                         m_out_messages[peID].push_back( label_mapping_to_cnode[ inc_messages[peID][i] ] );
                 }
         }
 
-        for( PEID peID = 0; peID < size; peID++) {
-                if( peID != rank ) {
-                        MPI_Request rq;
-                        MPI_Isend( &m_out_messages[peID][0], 
-                                    m_out_messages[peID].size(), 
-                                    MPI_UNSIGNED_LONG_LONG, 
-                                    peID, peID+5*size, communicator, &rq);
-                }
-        }
-
-        // first the local labels 
-        for( ULONG i = 0; i < m_messages[rank].size(); i++) {
-                label_mapping[ m_messages[rank][i] ] = label_mapping_to_cnode[m_messages[rank][i]];
-        }
+        std::vector< std::vector< NodeID > >  mapped_labels;
+        exchanger.exchange( communicator, m_out_messages, mapped_labels, 5 );
 
-        counter = 0;
-        while( counter < size - 1) {
-                // wait for incomming message of an adjacent processor
-                MPI_Status st;
-                MPI_Probe(MPI_ANY_SOURCE, rank+5*size, communicator, &st);
-                
-                int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
-                std::vector<NodeID> incmessage; incmessage.resize(message_length);
-
-                MPI_Status rst;
-                MPI_Recv( &incmessage[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+5*size, communicator, &rst); 
-                counter++;
-
-                // now integrate the changes
-                if( incmessage[0] == std::numeric_limits< NodeID >::max()) continue; // nothing to do
-
-                PEID peID = st.MPI_SOURCE;
-                for( int i = 0; i < message_length; i++) {
-                        label_mapping[ m_messages[peID][i] ] = incmessage[i];
+        for( PEID peID = 0; peID < (PEID)size; peID++) {
+                for( ULONG i = 0; i < mapped_labels[peID].size(); i++) {
+                        label_mapping[ m_messages[peID][i] ] = mapped_labels[peID][i];
                 }
         }
 }
@@ -280,7 +203,7 @@ void parallel_contraction::get_nodes_to_cnodes_ghost_nodes( MPI_Comm communicato
 
                         MPI_Request rq;
                         MPI_Isend( &m_send_buffers[peID][0], 
-                                    m_send_buffers[peID].size(), MPI_UNSIGNED_LONG_LONG, peID, peID+6*size, communicator, &rq);
+                                    m_send_buffers[peID].size(), MPI_NODEID, peID, peID+6*size, communicator, &rq);
                 }
         }
 
@@ -293,11 +216,11 @@ void parallel_contraction::get_nodes_to_cnodes_ghost_nodes( MPI_Comm communicato
                 MPI_Probe(MPI_ANY_SOURCE, rank+6*size, communicator, &st);
                 
                 int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                MPI_Get_count(&st, MPI_NODEID, &message_length);
                 std::vector<NodeID> message; message.resize(message_length);
 
                 MPI_Status rst;
-                MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+6*size, communicator, &rst); 
+                MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, rank+6*size, communicator, &rst); 
                 counter++;
 
                 // now integrate the changes
@@ -313,29 +236,17 @@ void parallel_contraction::get_nodes_to_cnodes_ghost_nodes( MPI_Comm communicato
 }
 
 
-void parallel_contraction::build_quotient_graph_locally( parallel_graph_access & G, 
-                                                         NodeID number_of_distinct_labels, 
-                                                         hashed_graph & hG, 
-                                                         std::unordered_map< NodeID, NodeWeight > & node_weights) {
+void parallel_contraction::build_quotient_graph_locally( parallel_graph_access & G, hashed_graph & hG ) {
         forall_local_nodes(G, node) {
                 NodeID cur_cnode = G.getCNode( node );
-                if( node_weights.find(cur_cnode) == node_weights.end()) {
-                        node_weights[cur_cnode] = 0;
-                }
-
-                node_weights[cur_cnode] += G.getNodeWeight( node );
+                hG.add_node_weight( cur_cnode, G.getNodeWeight( node ) );
 
                 forall_out_edges(G, e, node) {
                         NodeID target       = G.getEdgeTarget(e);
                         NodeID target_cnode = G.getCNode(target);
                         if( cur_cnode != target_cnode ) {
                                 // update the edge
-                                hashed_edge he;
-                                he.k            = number_of_distinct_labels;
-                                he.source       = cur_cnode;
-                                he.target       = target_cnode;
-
-                                hG[he].weight  += G.getEdgeWeight(e);
+                                hG.add_edge_weight( cur_cnode, target_cnode, G.getEdgeWeight(e) );
                         }
                 } endfor
         } endfor
@@ -344,7 +255,6 @@ void parallel_contraction::build_quotient_graph_locally( parallel_graph_access &
 
 
 void parallel_contraction::redistribute_hased_graph_and_build_graph_locally( MPI_Comm communicator, hashed_graph &  hG, 
-                                                                             std::unordered_map< NodeID, NodeWeight > & node_weights,
                                                                              NodeID number_of_cnodes, 
                                                                              parallel_graph_access & Q  ) {
         PEID rank, size;
@@ -356,121 +266,105 @@ void parallel_contraction::redistribute_hased_graph_and_build_graph_locally( MPI
         //std::vector< std::vector< NodeID > >  messages;
         m_messages.resize(size);
 
-        //build messages
-        hashed_graph::iterator it;
-        for( it = hG.begin(); it != hG.end(); it++) {
-                data_hashed_edge & e = it->second;
-                hashed_edge he       = it->first;
+        //build messages, node weights are triples (node, node, weight)
+        const std::vector< hashed_edge > & slots = hG.slots();
+        for( ULONG i = 0; i < slots.size(); i++) {
+                const hashed_edge & he = slots[i];
+                if( he.source == EMPTY_HASHED_EDGE ) continue;
 
                 PEID peID = he.source / divisor;
                 m_messages[ peID ].push_back( he.source );
                 m_messages[ peID ].push_back( he.target );
-                m_messages[ peID ].push_back( e.weight );
+                m_messages[ peID ].push_back( he.weight );
+
+                if( hashed_graph::is_node( he ) ) continue;
 
                 peID = he.target / divisor;
                 m_messages[ peID ].push_back( he.target );
                 m_messages[ peID ].push_back( he.source );
-                m_messages[ peID ].push_back( e.weight );
+                m_messages[ peID ].push_back( he.weight );
         }
+        hG.clear();
 
-        // now flood the network
-        for( PEID peID = 0; peID < size; peID++) {
-                if( peID != rank ) {
-                        if( m_messages[peID].size() == 0 ){
-                                m_messages[peID].push_back(std::numeric_limits<NodeID>::max());
-                        }
-
-                        MPI_Request rq;
-                        MPI_Isend( &m_messages[peID][0], 
-                                    m_messages[peID].size(), 
-                                    MPI_UNSIGNED_LONG_LONG, 
-                                    peID, peID+7*size, communicator, &rq);
-                }
-        }
-
-        // build the local part of the graph
-        //
+        // send the edges and node weights to the PEs that own their endpoints
+        sparse_all_to_all exchanger;
         std::vector< std::vector< NodeID > > local_msg_byPE;
-        local_msg_byPE.resize(size);
-
-
-        if( m_messages[ rank ].size() != 0 ) {
-                local_msg_byPE[rank] = m_messages[rank];
-        }
-       
-        PEID counter = 0;
-        while( counter < size - 1) {
-                // wait for incomming message of an adjacent processor
-                MPI_Status st;
-                MPI_Probe(MPI_ANY_SOURCE, rank+7*size, communicator, &st);
-                
-                int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
-                std::vector<NodeID> incmessage; incmessage.resize(message_length);
-
-                MPI_Status rst;
-                MPI_Recv( &incmessage[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+7*size, communicator, &rst); 
-                counter++;
+        exchanger.exchange( communicator, m_messages, local_msg_byPE, 7 );
 
-                // now integrate the changes
-                if( incmessage[0] == std::numeric_limits< NodeID >::max()) continue; // nothing to do
-
-
-                PEID peID = rst.MPI_SOURCE;
-                local_msg_byPE[peID] = incmessage;
+        ULONG received_entries = 0;
+        for( PEID peID = 0; peID < size; peID++) {
+                m_messages[peID].clear();
+                received_entries += local_msg_byPE[peID].size() / 3;
         }
 
-        hashed_graph local_graph;
+        hashed_graph local_graph( received_entries );
         for( PEID peID = 0; peID < size; peID++) {
-                if(local_msg_byPE[peID].size() > 0) {
-                for( ULONG i = 0; i < local_msg_byPE[peID].size()-2; i+=3) {
-                        hashed_edge he;
-                        he.k = number_of_cnodes;
-                        he.source = local_msg_byPE[peID][i];
-                        he.target = local_msg_byPE[peID][i+1];
-
-                        local_graph[he].weight += local_msg_byPE[peID][i+2];
-                }}
+                for( ULONG i = 0; i + 2 < local_msg_byPE[peID].size(); i+=3) {
+                        NodeID source = local_msg_byPE[peID][i];
+                        NodeID target = local_msg_byPE[peID][i+1];
+                        if( source == target ) {
+                                local_graph.add_node_weight( source, local_msg_byPE[peID][i+2] );
+                        } else {
+                                local_graph.add_edge_weight( source, target, local_msg_byPE[peID][i+2] );
+                        }
+                }
+                std::vector< NodeID >().swap(local_msg_byPE[peID]);
         }
 
 
         ULONG from = rank     * ceil(number_of_cnodes / (double)size);
         ULONG to   = (rank+1) * ceil(number_of_cnodes / (double)size) - 1;
         // handle the case where we dont have local edges
-        from = std::min(from, number_of_cnodes);
-        to   = std::min(to, number_of_cnodes - 1);
+        from = std::min(from, (ULONG)number_of_cnodes);
+        to   = std::min(to, (ULONG)number_of_cnodes - 1);
         ULONG local_num_cnodes = to - from + 1;
 
         std::vector < std::vector< std::pair<NodeID, NodeWeight > > > sorted_graph;
         sorted_graph.resize( local_num_cnodes );
+        std::vector< NodeWeight > node_weights( local_num_cnodes, 0 );
 
         EdgeID edge_counter = 0;
-        for( it = local_graph.begin(); it != local_graph.end(); it++) {
-                data_hashed_edge & e = it->second;
-                hashed_edge he       = it->first;
+        const std::vector< hashed_edge > & local_slots = local_graph.slots();
+        for( ULONG i = 0; i < local_slots.size(); i++) {
+                const hashed_edge & he = local_slots[i];
+                if( he.source == EMPTY_HASHED_EDGE ) continue;
 
-                if( from <= he.target && he.target <= to) {
+                if( hashed_graph::is_node( he ) ) {
+                        node_weights[ he.source - from ] += he.weight;
+                        continue;
+                }
+
+                bool source_local = from <= he.source && he.source <= to;
+                bool target_local = from <= he.target && he.target <= to;
+                if( source_local && target_local ) {
                         std::pair< NodeID, NodeWeight > edge;
                         edge.first  = he.target;
-                        edge.second = e.weight/4;
+                        edge.second = he.weight/4;
 
                         std::pair< NodeID, NodeWeight > e_bar;
                         e_bar.first  = he.source;
-                        e_bar.second = e.weight/4;
+                        e_bar.second = he.weight/4;
 
                         sorted_graph[ he.target - from ].push_back( e_bar);
                         sorted_graph[ he.source - from ].push_back( edge );
                         edge_counter+=2;
-                } else {
+                } else if( source_local ) {
                         std::pair< NodeID, NodeWeight > edge;
                         edge.first  = he.target;
-                        edge.second = e.weight/2;
+                        edge.second = he.weight/2;
                         sorted_graph[ he.source - from ].push_back( edge );
                         edge_counter++;
+                } else {
+                        std::pair< NodeID, NodeWeight > e_bar;
+                        e_bar.first  = he.source;
+                        e_bar.second = he.weight/2;
+                        sorted_graph[ he.target - from ].push_back( e_bar );
+                        edge_counter++;
                 }
         }
+        local_graph.clear();
  
-        ULONG global_edges = 0;
+        EdgeID global_edges = 0;
         MPI_Allreduce(&edge_counter, &global_edges, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
 
         Q.start_construction(local_num_cnodes, edge_counter, number_of_cnodes, global_edges);
@@ -486,7 +380,7 @@ void parallel_contraction::redistribute_hased_graph_and_build_graph_locally( MPI
         for (NodeID i = 0; i < local_num_cnodes; ++i) {
                 NodeID node = Q.new_node();
                 NodeID globalID = from+node;
-                Q.setNodeWeight(node, 0); 
+                Q.setNodeWeight(node, node_weights[node]); 
                 Q.setNodeLabel(node, globalID);
                
                 for( EdgeID e = 0; e < sorted_graph[node].size(); e++) {
@@ -497,69 +391,6 @@ void parallel_contraction::redistribute_hased_graph_and_build_graph_locally( MPI
         }
 
         Q.finish_construction();
-
-        for( PEID peID = 0; peID < size; peID++) {
-                m_messages[peID].clear();
-        }
-        //now distribute the node weights
-        //pack messages
-        std::unordered_map< NodeID, NodeWeight >::iterator wit;
-        for( wit = node_weights.begin(); wit != node_weights.end(); wit++) {
-                NodeID node       = wit->first;
-                NodeWeight weight = wit->second;
-                PEID peID         = node / divisor;
-
-                m_messages[ peID ].push_back( node );
-                m_messages[ peID ].push_back( weight );
-        }
-
-        for( PEID peID = 0; peID < size; peID++) {
-                if( peID != rank ) {
-                        if( m_messages[peID].size() == 0 ){
-                                m_messages[peID].push_back(std::numeric_limits<NodeID>::max());
-                        }
-
-                        MPI_Request rq;
-                        MPI_Isend( &m_messages[peID][0], 
-                                    m_messages[peID].size(), 
-                                    MPI_UNSIGNED_LONG_LONG, 
-                                    peID, peID+8*size, communicator, &rq);
-                }
-        }
-
-        if( m_messages[ rank ].size() != 0 ) {
-                for( ULONG i = 0; i < m_messages[rank].size()-1; i+=2) {
-                        NodeID globalID   = m_messages[rank][i];
-                        NodeID node       = globalID - from;
-                        NodeWeight weight = m_messages[rank][i+1];
-                        Q.setNodeWeight( node , Q.getNodeWeight(node) + weight);
-                }
-        }
-
-        counter = 0;
-        while( counter < size - 1) {
-                // wait for incomming message of an adjacent processor
-                MPI_Status st;
-                MPI_Probe(MPI_ANY_SOURCE, rank+8*size, communicator, &st);
-
-                int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
-                std::vector<NodeID> incmessage; incmessage.resize(message_length);
-
-                MPI_Status rst;
-                MPI_Recv( &incmessage[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+8*size, communicator, &rst); 
-                counter++;
-
-                // now integrate the changes
-                if( incmessage[0] == std::numeric_limits< NodeID >::max()) continue; // nothing to do
-
-                for( ULONG i = 0; i < incmessage.size()-1; i+=2) {
-                        NodeID globalID   = incmessage[i];
-                        NodeWeight weight = incmessage[i+1];
-                        NodeID node       = globalID - from;
-                        Q.setNodeWeight( node , Q.getNodeWeight(node) + weight);
-                }
-        }
 }
 
 
@@ -603,7 +434,7 @@ void parallel_contraction::update_ghost_nodes_weights( MPI_Comm communicator, pa
 
                         MPI_Request rq; 
                         MPI_Isend( &m_send_buffers[peID][0], 
-                                    m_send_buffers[peID].size(), MPI_UNSIGNED_LONG_LONG, peID, peID+9*size, communicator, &rq);
+                                    m_send_buffers[peID].size(), MPI_NODEID, peID, peID+9*size, communicator, &rq);
                 }
         }
 
@@ -615,11 +446,11 @@ void parallel_contraction::update_ghost_nodes_weights( MPI_Comm communicator, pa
                 MPI_Probe(MPI_ANY_SOURCE, rank+9*size, communicator, &st);
                 
                 int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
+                MPI_Get_count(&st, MPI_NODEID, &message_length);
                 std::vector<NodeID> message; message.resize(message_length);
 
                 MPI_Status rst;
-                MPI_Recv( &message[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+9*size, communicator, &rst); 
+                MPI_Recv( &message[0], message_length, MPI_NODEID, st.MPI_SOURCE, rank+9*size, communicator, &rst); 
                 counter++;
 
                 // now integrate the changes
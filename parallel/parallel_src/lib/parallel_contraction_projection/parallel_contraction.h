@@ -8,6 +8,8 @@
 #ifndef PARALLEL_CONTRACTION_64O127GD
 #define PARALLEL_CONTRACTION_64O127GD
 
+#include <unordered_map>
+
 #include "data_structure/hashed_graph.h"
 #include "data_structure/parallel_graph_access.h"
 #include "partition_config.h"
@@ -28,13 +30,12 @@ private:
 
         void get_nodes_to_cnodes_ghost_nodes( MPI_Comm communicator, parallel_graph_access & G );   
 
-	void build_quotient_graph_locally( parallel_graph_access & G, 
-                                           NodeID number_of_distinct_labels, 
-					   hashed_graph & hG, 
-					   std::unordered_map< NodeID, NodeWeight > & node_weights);
+        // aggregates the edges and node weights of the local part of the quotient graph
+	void build_quotient_graph_locally( parallel_graph_access & G, hashed_graph & hG );
 
+        // sends every quotient edge and node weight to the PEs owning its endpoints,
+        // hG is released once its entries are packed
         void redistribute_hased_graph_and_build_graph_locally( MPI_Comm communicator, hashed_graph &  hG, 
-                                                               std::unordered_map< NodeID, NodeWeight > & node_weights,
                                                                NodeID number_of_cnodes,
                                                                parallel_graph_access & Q);
 
@@ -5,6 +5,7 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include "communication/sparse_all_to_all.h"
 #include "parallel_projection.h"
 
 parallel_projection::parallel_projection() {
@@ -44,87 +45,27 @@ void parallel_projection::parallel_project( MPI_Comm communicator, parallel_grap
                 }
         } endfor
 
-        for( PEID peID = 0; peID < size; peID++) {
-                if( peID != rank ) {
-                        if( m_messages[peID].size() == 0 ){
-                                m_messages[peID].push_back(std::numeric_limits<NodeID>::max());
-                        }
-
-                        MPI_Request rq;
-                        MPI_Isend( &m_messages[peID][0], 
-                                                m_messages[peID].size(), 
-                                                MPI_UNSIGNED_LONG_LONG, 
-                                                peID, peID+size, communicator, &rq);
-                }
-        }
+        // request the labels of the coarse nodes from the PEs that own them
+        sparse_all_to_all exchanger;
+        std::vector< std::vector< NodeID > > requests;
+        exchanger.exchange( communicator, m_messages, requests, 1 );
 
         std::vector< std::vector< NodeID > > out_messages;
         out_messages.resize(size);
-
-        PEID counter = 0;
-        while( counter < size - 1) {
-                // wait for incomming message of an adjacent processor
-                MPI_Status st;
-                MPI_Probe(MPI_ANY_SOURCE, rank+size, communicator, &st);
-                
-                int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
-                std::vector<NodeID> incmessage; incmessage.resize(message_length);
-
-                MPI_Status rst;
-                MPI_Recv( &incmessage[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, rank+size, communicator, &rst); 
-                counter++;
-
-                PEID peID = st.MPI_SOURCE;
-                // now integrate the changes
-                if( incmessage[0] == std::numeric_limits< NodeID >::max()) {
-                        out_messages[peID].push_back(std::numeric_limits< NodeID >::max());
-                        MPI_Request rq; 
-                        MPI_Isend( &out_messages[peID][0], 
-                                        out_messages[peID].size(), 
-                                        MPI_UNSIGNED_LONG_LONG, 
-                                        peID, peID+2*size, communicator, &rq);
-
-                        continue; // nothing to do
-                }
-
-
-                for( int i = 0; i < message_length; i++) {
-                        NodeID cnode = coarser.getLocalID(incmessage[i]);
+        for( PEID peID = 0; peID < size; peID++) {
+                for( ULONG i = 0; i < requests[peID].size(); i++) {
+                        NodeID cnode = coarser.getLocalID(requests[peID][i]);
                         out_messages[peID].push_back(coarser.getNodeLabel(cnode));
                 }
-
-                MPI_Request rq;
-                MPI_Isend( &out_messages[peID][0], 
-                                out_messages[peID].size(), 
-                                MPI_UNSIGNED_LONG_LONG, 
-                                peID, peID+2*size, communicator, &rq);
-
         }
 
-        counter = 0;
-        while( counter < size - 1) {
-                // wait for incomming message of an adjacent processor
-                MPI_Status st; ULONG tag = rank+2*size;
-                MPI_Probe(MPI_ANY_SOURCE, tag, communicator, &st);
+        std::vector< std::vector< NodeID > > labels;
+        exchanger.exchange( communicator, out_messages, labels, 2 );
 
-                int message_length;
-                MPI_Get_count(&st, MPI_UNSIGNED_LONG_LONG, &message_length);
-                std::vector<NodeID> incmessage; incmessage.resize(message_length);
-
-                MPI_Status rst;
-                MPI_Recv( &incmessage[0], message_length, MPI_UNSIGNED_LONG_LONG, st.MPI_SOURCE, tag, communicator, &rst); 
-                counter++;
-
-                // now integrate the changes
-                if( incmessage[0] == std::numeric_limits< NodeID >::max()) {
-                        continue; // nothing to do
-                }
-
-                PEID peID = st.MPI_SOURCE;
-                for( ULONG i = 0; i < (ULONG)incmessage.size(); i++) {
+        for( PEID peID = 0; peID < size; peID++) {
+                for( ULONG i = 0; i < labels[peID].size(); i++) {
                         std::vector< NodeID > & proj = cnode_to_nodes[m_messages[peID][i]];
-                        NodeID label = incmessage[i];
+                        NodeID label = labels[peID][i];
 
                         for( ULONG j = 0; j < proj.size(); j++) {
                                 finer.setNodeLabel(proj[j], label);
@@ -8,6 +8,8 @@
 #ifndef PARALLEL_LABEL_COMPRESS_9ME4H8DK
 #define PARALLEL_LABEL_COMPRESS_9ME4H8DK
 
+#include <omp.h>
+
 #include "data_structure/parallel_graph_access.h"
 #include "partition_config.h"
 #include "tools/random_functions.h"
@@ -25,7 +27,6 @@ class parallel_label_compress {
                                 parallel_graph_access & G, bool balance, bool for_coarsening = true) {
 
                         if( config.label_iterations == 0) return;
-                        NodeWeight cluster_upperbound = config.upper_bound_cluster;
 
                         std::vector< NodeID > permutation( G.number_of_local_nodes() );
                         if( for_coarsening ) {
@@ -35,6 +36,16 @@ class parallel_label_compress {
                                 random_functions::permutate_vector_fast( permutation, true);
                         }
 
+                        if( config.num_threads > 1 ) {
+                                perform_threaded_label_compression( config, G, balance, permutation );
+                                return;
+                        }
+
+                        if( config.overlap_communication ) {
+                                perform_overlapped_label_compression( config, G, balance, permutation );
+                                return;
+                        }
+
                         //std::unordered_map<NodeID, NodeWeight> hash_map;
                         hmap_wrapper< T > hash_map(config);
                         hash_map.init( G.get_max_degree() );
@@ -42,68 +53,206 @@ class parallel_label_compress {
                                 NodeID prev_node = 0;
                                 forall_local_nodes(G, rnode) {
                                         NodeID node = permutation[rnode]; // use the current random node
+                                        move_node( config, G, hash_map, node, prev_node, balance );
 
-                                        //move the node to the cluster that is most common in the neighborhood
-                                        //second sweep for finding max and resetting array
-                                        PartitionID max_block   = G.getNodeLabel(node);
-                                        PartitionID old_block   = G.getNodeLabel(node);
-                                        PartitionID max_value   = 0;
-                                        NodeWeight  node_weight = G.getNodeWeight(node);
-                                        bool own_block_balanced = G.getBlockSize(old_block) <= cluster_upperbound || !balance;
-
-                                        if( G.getNodeDegree(node) == 0) {
-                                                // find a block to assign it to
-                                                if(config.vcycle) {
-                                                        NodeWeight prev_block_size = G.getBlockSize( G.getNodeLabel( prev_node ) );
-                                                        bool same_block = G.getSecondPartitionIndex(prev_node)==G.getSecondPartitionIndex(node);
-                                                        if( prev_block_size  + node_weight <= cluster_upperbound && same_block ) {
-                                                                max_block = G.getNodeLabel( prev_node );
-                                                        }
-                                                } else {
-                                                        NodeWeight prev_block_size = G.getBlockSize( G.getNodeLabel( prev_node ) );
-                                                        if( prev_block_size  + node_weight <= cluster_upperbound) {
-                                                                max_block = G.getNodeLabel( prev_node );
-                                                        }
-                                                }
+                                        prev_node = node;
+                                        G.update_ghost_node_data(); 
+                                        hash_map.clear();
+
+                                } endfor
+                                G.update_ghost_node_data_finish(); 
+                        }
+                }
+
+        private:
+                // tie breaking of the sequential variants, uses the generator of the PE
+                struct pe_coin {
+                        bool operator()() { return random_functions::nextBool(); }
+                };
 
-                                        } else {
-                                                forall_out_edges(G, e, node) {
-                                                        NodeID target             = G.getEdgeTarget(e);
-                                                        PartitionID cur_block     = G.getNodeLabel(target);
-                                                        hash_map[cur_block] += G.getEdgeWeight(e);
-                                                        PartitionID cur_value     = hash_map[cur_block];
+                // tie breaking of a thread in the threaded variant
+                struct thread_coin {
+                        thread_coin( MersenneTwister & mt ) : m_mt(mt), m_coin(0,1) {}
+                        bool operator()() { return m_coin(m_mt); }
 
-                                                        bool improvement = cur_value > max_value;
-                                                        improvement |= cur_value == max_value && random_functions::nextBool();
+                        MersenneTwister & m_mt;
+                        std::uniform_int_distribution<int> m_coin;
+                };
 
-                                                        bool sizeconstraint = G.getBlockSize(cur_block) + node_weight <= cluster_upperbound;
-                                                        sizeconstraint |= cur_block == old_block;
+                //move the node to the cluster that is most common in the neighborhood
+                void move_node( PPartitionConfig & config, parallel_graph_access & G, hmap_wrapper< T > & hash_map,
+                                NodeID node, NodeID prev_node, bool balance ) {
+                        pe_coin coin;
+                        apply_move( config, G, node, prev_node, preferred_block( config, G, hash_map, node, balance, coin ) );
+                }
+
+                //the cluster that is most common in the neighborhood and that the node may move to.
+                //only reads the graph, isolated nodes keep their cluster here (see apply_move)
+                template< typename Coin >
+                PartitionID preferred_block( PPartitionConfig & config, parallel_graph_access & G, hmap_wrapper< T > & hash_map,
+                                             NodeID node, bool balance, Coin & coin ) {
+                        NodeWeight cluster_upperbound = config.upper_bound_cluster;
+
+                        //second sweep for finding max and resetting array
+                        PartitionID max_block   = G.getNodeLabel(node);
+                        PartitionID old_block   = G.getNodeLabel(node);
+                        PartitionID max_value   = 0;
+                        NodeWeight  node_weight = G.getNodeWeight(node);
+                        bool own_block_balanced = G.getBlockSize(old_block) <= cluster_upperbound || !balance;
+
+                        if( G.getNodeDegree(node) == 0) return max_block;
+
+                        forall_out_edges(G, e, node) {
+                                NodeID target             = G.getEdgeTarget(e);
+                                PartitionID cur_block     = G.getNodeLabel(target);
+                                hash_map[cur_block] += G.getEdgeWeight(e);
+                                PartitionID cur_value     = hash_map[cur_block];
+
+                                bool improvement = cur_value > max_value;
+                                improvement |= cur_value == max_value && coin();
+
+                                bool sizeconstraint = G.getBlockSize(cur_block) + node_weight <= cluster_upperbound;
+                                sizeconstraint |= cur_block == old_block;
+
+                                bool cycle = !config.vcycle;
+                                cycle |= G.getSecondPartitionIndex( node ) == G.getSecondPartitionIndex(target);
+
+                                bool balancing = own_block_balanced || cur_block != old_block;
+                                if( improvement  && sizeconstraint && cycle && balancing) {
+                                        max_value = cur_value;
+                                        max_block = cur_block;
+                                }
+                        } endfor
+
+                        return max_block;
+                }
+
+                //moves the node to max_block if the size constraint still holds. an isolated node
+                //joins the cluster of the previous node instead
+                void apply_move( PPartitionConfig & config, parallel_graph_access & G, 
+                                 NodeID node, NodeID prev_node, PartitionID max_block ) {
+                        NodeWeight cluster_upperbound = config.upper_bound_cluster;
+                        PartitionID old_block         = G.getNodeLabel(node);
+                        NodeWeight  node_weight       = G.getNodeWeight(node);
+
+                        if( G.getNodeDegree(node) == 0) {
+                                // find a block to assign it to
+                                NodeWeight prev_block_size = G.getBlockSize( G.getNodeLabel( prev_node ) );
+                                bool same_block = !config.vcycle || G.getSecondPartitionIndex(prev_node)==G.getSecondPartitionIndex(node);
+                                if( prev_block_size  + node_weight <= cluster_upperbound && same_block ) {
+                                        max_block = G.getNodeLabel( prev_node );
+                                }
+                        }
 
-                                                        bool cycle = !config.vcycle;
-                                                        cycle |= G.getSecondPartitionIndex( node ) == G.getSecondPartitionIndex(target);
+                        // the weights may have changed since max_block was chosen (threaded variant)
+                        if( old_block != max_block && G.getBlockSize(max_block) + node_weight <= cluster_upperbound ) {
+                                G.setNodeLabel(node, max_block);
 
-                                                        bool balancing = own_block_balanced || cur_block != old_block;
-                                                        if( improvement  && sizeconstraint && cycle && balancing) {
-                                                                max_value = cur_value;
-                                                                max_block = cur_block;
-                                                        }
-                                                } endfor
+                                G.setBlockSize(old_block, G.getBlockSize(old_block) - node_weight);
+                                G.setBlockSize(max_block, G.getBlockSize(max_block) + node_weight);
+                        }
+                }
+
+                // interface nodes are processed first. their new labels are sent while the interior
+                // nodes, which do not read ghost labels, are processed, so that the latency of the
+                // exchange is hidden behind local work. ghost labels arriving during an iteration are
+                // used by the interface nodes in the next one.
+                void perform_overlapped_label_compression( PPartitionConfig & config, 
+                                parallel_graph_access & G, bool balance, std::vector< NodeID > & permutation ) {
+
+                        const NodeID poll_interval = 1024;
+
+                        std::vector< NodeID > interface_nodes;
+                        std::vector< NodeID > interior_nodes;
+                        forall_local_nodes(G, rnode) {
+                                NodeID node = permutation[rnode];
+                                if( G.is_interface_node(node) ) {
+                                        interface_nodes.push_back(node);
+                                } else {
+                                        interior_nodes.push_back(node);
+                                }
+                        } endfor
+
+                        hmap_wrapper< T > hash_map(config);
+                        hash_map.init( G.get_max_degree() );
+                        for( ULONG i = 0; i < config.label_iterations; i++) {
+                                NodeID prev_node = 0;
+                                for( NodeID j = 0; j < interface_nodes.size(); j++) {
+                                        move_node( config, G, hash_map, interface_nodes[j], prev_node, balance );
+                                        prev_node = interface_nodes[j];
+                                        hash_map.clear();
+                                }
+
+                                G.post_ghost_node_data();
+                                for( NodeID j = 0; j < interior_nodes.size(); j++) {
+                                        move_node( config, G, hash_map, interior_nodes[j], prev_node, balance );
+                                        prev_node = interior_nodes[j];
+                                        hash_map.clear();
+
+                                        if( (j+1) % poll_interval == 0 ) {
+                                                G.poll_ghost_node_data();
                                         }
+                                }
+                                G.finish_ghost_node_data();
+                        }
+                }
 
-                                        if( old_block != max_block ) {
-                                                G.setNodeLabel(node, max_block);
+                // hybrid variant: the nodes of a PE are processed in chunks. the new labels of a chunk are
+                // computed by all threads using the labels at the beginning of the chunk, then they are
+                // applied sequentially so that block weights and ghost updates stay per PE.
+                void perform_threaded_label_compression( PPartitionConfig & config, 
+                                parallel_graph_access & G, bool balance, std::vector< NodeID > & permutation ) {
 
-                                                G.setBlockSize(old_block, G.getBlockSize(old_block) - node_weight);
-                                                G.setBlockSize(max_block, G.getBlockSize(max_block) + node_weight);
+                        int num_threads               = config.num_threads;
+                        NodeID n                      = G.number_of_local_nodes();
+                        NodeID chunk_size             = std::max((NodeID)1024, (NodeID)ceil(n / (double)config.comm_rounds));
+
+                        int rank;
+                        MPI_Comm_rank( G.getCommunicator(), &rank);
+
+                        std::vector< hmap_wrapper< T >* > hash_maps( num_threads );
+                        std::vector< MersenneTwister >     generators( num_threads );
+                        for( int t = 0; t < num_threads; t++) {
+                                hash_maps[t] = new hmap_wrapper< T >(config);
+                                hash_maps[t]->init( G.get_max_degree() );
+                                generators[t].seed( config.seed + rank*num_threads + t );
+                        }
+
+                        std::vector< PartitionID > new_labels( chunk_size );
+                        for( ULONG i = 0; i < config.label_iterations; i++) {
+                                for( NodeID chunk_begin = 0; chunk_begin < n; chunk_begin += chunk_size) {
+                                        NodeID chunk_end = std::min(n, chunk_begin + chunk_size);
+
+                                        #pragma omp parallel num_threads(num_threads)
+                                        {
+                                                int thread_id                = omp_get_thread_num();
+                                                hmap_wrapper< T > & hash_map = *hash_maps[thread_id];
+                                                thread_coin coin( generators[thread_id] );
+
+                                                #pragma omp for schedule(dynamic, 256)
+                                                for( NodeID rnode = chunk_begin; rnode < chunk_end; rnode++) {
+                                                        NodeID node = permutation[rnode];
+                                                        new_labels[rnode - chunk_begin] = preferred_block( config, G, hash_map, node, balance, coin );
+                                                        hash_map.clear();
+                                                }
                                         }
 
-                                        prev_node = node;
-                                        G.update_ghost_node_data(); 
-                                        hash_map.clear();
+                                        // apply the moves, block weights may have changed within the chunk
+                                        NodeID prev_node = chunk_begin > 0 ? permutation[chunk_begin-1] : 0;
+                                        for( NodeID rnode = chunk_begin; rnode < chunk_end; rnode++) {
+                                                NodeID node = permutation[rnode];
+                                                apply_move( config, G, node, prev_node, new_labels[rnode - chunk_begin] );
 
-                                } endfor
+                                                prev_node = node;
+                                                G.update_ghost_node_data(); 
+                                        }
+                                }
                                 G.update_ghost_node_data_finish(); 
                         }
+
+                        for( int t = 0; t < num_threads; t++) {
+                                delete hash_maps[t];
+                        }
                 }
 
 };
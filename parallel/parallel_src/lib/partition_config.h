@@ -118,9 +118,17 @@ struct PPartitionConfig
 
         bool converter_evaluate;
 
+        std::string converter_output_filename;
+
+        ULONG converter_memory_budget; // in MB
+
         //=======================================
         //===============Shared Mem OMP==========
         //=======================================
+        int num_threads; // threads per PE used for label propagation
+
+        bool overlap_communication; // exchange interface labels while interior nodes are processed
+
         void LogDump(FILE *out) const {
         }
 };
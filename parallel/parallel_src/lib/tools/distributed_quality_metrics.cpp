@@ -16,8 +16,8 @@ distributed_quality_metrics::~distributed_quality_metrics() {
                         
 }
 
-EdgeWeight distributed_quality_metrics::edge_cut_second( parallel_graph_access & G, MPI_Comm communicator ) {
-        EdgeWeight local_cut = 0;
+ULONG distributed_quality_metrics::edge_cut_second( parallel_graph_access & G, MPI_Comm communicator ) {
+        ULONG local_cut = 0;
         forall_local_nodes(G, node) {
                 forall_out_edges(G, e, node) {
                         NodeID target = G.getEdgeTarget(e);
@@ -27,7 +27,7 @@ EdgeWeight distributed_quality_metrics::edge_cut_second( parallel_graph_access &
                 } endfor
         } endfor
 
-        EdgeWeight global_cut = 0;
+        ULONG global_cut = 0;
         MPI_Allreduce(&local_cut, &global_cut, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
 
         return global_cut/2;
@@ -47,8 +47,8 @@ EdgeWeight distributed_quality_metrics::local_edge_cut( parallel_graph_access &
         return local_cut/2;
 }
 
-EdgeWeight distributed_quality_metrics::edge_cut( parallel_graph_access & G, MPI_Comm communicator ) {
-        EdgeWeight local_cut = 0;
+ULONG distributed_quality_metrics::edge_cut( parallel_graph_access & G, MPI_Comm communicator ) {
+        ULONG local_cut = 0;
         forall_local_nodes(G, node) {
                 forall_out_edges(G, e, node) {
                         NodeID target = G.getEdgeTarget(e);
@@ -58,7 +58,7 @@ EdgeWeight distributed_quality_metrics::edge_cut( parallel_graph_access & G, MPI
                 } endfor
         } endfor
 
-        EdgeWeight global_cut = 0;
+        ULONG global_cut = 0;
         MPI_Allreduce(&local_cut, &global_cut, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
 
         return global_cut/2;
@@ -99,10 +99,10 @@ double distributed_quality_metrics::balance( PPartitionConfig & config, parallel
         } endfor
 
         std::vector<PartitionID> overall_weights(config.k, 0);
-        MPI_Allreduce(&block_weights[0], &overall_weights[0], config.k, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        MPI_Allreduce(&block_weights[0], &overall_weights[0], config.k, MPI_NODEID, MPI_SUM, communicator);
 
         NodeWeight graph_vertex_weight = 0;
-        MPI_Allreduce(&local_graph_vertex_weight, &graph_vertex_weight, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        MPI_Allreduce(&local_graph_vertex_weight, &graph_vertex_weight, 1, MPI_NODEID, MPI_SUM, communicator);
 
         double balance_part_weight = ceil(graph_vertex_weight / (double)config.k);
         double cur_max             = -1;
@@ -130,10 +130,10 @@ double distributed_quality_metrics::balance_second( PPartitionConfig & config, p
         } endfor
 
         std::vector<PartitionID> overall_weights(config.k, 0);
-        MPI_Allreduce(&block_weights[0], &overall_weights[0], config.k, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        MPI_Allreduce(&block_weights[0], &overall_weights[0], config.k, MPI_NODEID, MPI_SUM, communicator);
 
         NodeWeight graph_vertex_weight = 0;
-        MPI_Allreduce(&local_graph_vertex_weight, &graph_vertex_weight, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        MPI_Allreduce(&local_graph_vertex_weight, &graph_vertex_weight, 1, MPI_NODEID, MPI_SUM, communicator);
 
         double balance_part_weight = ceil(graph_vertex_weight / (double)config.k);
         double cur_max             = -1;
@@ -151,19 +151,19 @@ double distributed_quality_metrics::balance_second( PPartitionConfig & config, p
 
 
 double distributed_quality_metrics::balance_load( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator ) {
-        std::vector<NodeWeight> block_weights(config.k, 0);
+        std::vector<ULONG> block_weights(config.k, 0);
 
-        NodeWeight local_weight = 0;
+        ULONG local_weight = 0;
         forall_local_nodes(G, n) {
                 PartitionID curPartition     = G.getNodeLabel(n);
                 block_weights[curPartition] += G.getNodeWeight(n)+G.getNodeDegree(n);
                 local_weight   += G.getNodeWeight(n)+G.getNodeDegree(n);
         } endfor
 
-        std::vector<PartitionID> overall_weights(config.k, 0);
+        std::vector<ULONG> overall_weights(config.k, 0);
         MPI_Allreduce(&block_weights[0], &overall_weights[0], config.k, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
 
-        NodeWeight total_weight = 0;
+        ULONG total_weight = 0;
         MPI_Allreduce(&local_weight, &total_weight, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
 
         double balance_part_weight = ceil(total_weight / (double)config.k);
@@ -187,18 +187,18 @@ double distributed_quality_metrics::balance_load_dist( PPartitionConfig & config
         MPI_Comm_rank( communicator, &rank);
         MPI_Comm_size( communicator, &size);
         
-        std::vector<NodeWeight> block_weights(size, 0);
+        std::vector<ULONG> block_weights(size, 0);
         
-        NodeWeight local_weight = 0;
+        ULONG local_weight = 0;
         forall_local_nodes(G, n) {
                 block_weights[rank] += G.getNodeWeight(n)+G.getNodeDegree(n);
                 local_weight   += G.getNodeWeight(n)+G.getNodeDegree(n);
         } endfor
 
-        std::vector<PartitionID> overall_weights(size, 0);
+        std::vector<ULONG> overall_weights(size, 0);
         MPI_Allreduce(&block_weights[0], &overall_weights[0], size, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
 
-        NodeWeight total_weight = 0;
+        ULONG total_weight = 0;
         MPI_Allreduce(&local_weight, &total_weight, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
 
         double balance_part_weight = ceil(total_weight / (double)size);
@@ -217,11 +217,11 @@ double distributed_quality_metrics::balance_load_dist( PPartitionConfig & config
 }
 
 // measure the communication volume of the current graph distribution
-EdgeWeight distributed_quality_metrics::comm_vol( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator ) {
-        EdgeWeight local_comm_vol = 0; int rank;
+ULONG distributed_quality_metrics::comm_vol( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator ) {
+        ULONG local_comm_vol = 0; int rank;
         MPI_Comm_rank( communicator, &rank);
 
-        std::vector<PartitionID> block_volume(config.k, 0);
+        std::vector<ULONG> block_volume(config.k, 0);
         forall_local_nodes(G, node) {
                 std::vector<bool> block_incident(config.k, false);
                 PartitionID block = G.getNodeLabel( node );
@@ -239,16 +239,16 @@ EdgeWeight distributed_quality_metrics::comm_vol( PPartitionConfig & config, par
                 block_volume[block] += num_incident_blocks;
         } endfor
 
-        std::vector<PartitionID> overall_weights(config.k, 0);
+        std::vector<ULONG> overall_weights(config.k, 0);
         MPI_Allreduce(&block_volume[0], &overall_weights[0], config.k, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
 
         if( rank == ROOT ) {
-                EdgeWeight total_comm_vol = 0;
+                ULONG total_comm_vol = 0;
                 for( PEID i = 0; i < (PEID)overall_weights.size(); i++) {
                         total_comm_vol += overall_weights[i];
                 }
-                EdgeWeight max_comm_vol = *(std::max_element(overall_weights.begin(), overall_weights.end()));
-                EdgeWeight min_comm_vol = *(std::min_element(overall_weights.begin(), overall_weights.end()));
+                ULONG max_comm_vol = *(std::max_element(overall_weights.begin(), overall_weights.end()));
+                ULONG min_comm_vol = *(std::min_element(overall_weights.begin(), overall_weights.end()));
 
                 std::cout <<  "log> total vol part " <<  total_comm_vol << std::endl;
                 std::cout <<  "log> max vol part " <<  max_comm_vol << std::endl;
@@ -260,8 +260,8 @@ EdgeWeight distributed_quality_metrics::comm_vol( PPartitionConfig & config, par
 }
 
 // measure the communication volume of the current graph distribution
-EdgeWeight distributed_quality_metrics::comm_vol_dist( parallel_graph_access & G, MPI_Comm communicator ) {
-        EdgeWeight local_comm_vol = 0;
+ULONG distributed_quality_metrics::comm_vol_dist( parallel_graph_access & G, MPI_Comm communicator ) {
+        ULONG local_comm_vol = 0;
         int rank, size;
         MPI_Comm_rank( communicator, &rank);
         MPI_Comm_size( communicator, &size);
@@ -284,9 +284,9 @@ EdgeWeight distributed_quality_metrics::comm_vol_dist( parallel_graph_access & G
                 local_comm_vol += num_incident_blocks;
         } endfor
 
-        EdgeWeight total_comm_vol = 0;
-        EdgeWeight max_comm_vol   = 0;
-        EdgeWeight min_comm_vol   = 0;
+        ULONG total_comm_vol = 0;
+        ULONG max_comm_vol   = 0;
+        ULONG min_comm_vol   = 0;
 
         MPI_Reduce(&local_comm_vol, &total_comm_vol, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, ROOT, communicator);
         MPI_Reduce(&local_comm_vol, &max_comm_vol, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, ROOT, communicator);
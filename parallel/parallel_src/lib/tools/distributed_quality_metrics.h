@@ -18,15 +18,16 @@ public:
         virtual ~distributed_quality_metrics();
 
         EdgeWeight local_edge_cut( parallel_graph_access & G, int * partition_map, MPI_Comm communicator );
-        EdgeWeight edge_cut( parallel_graph_access & G, MPI_Comm communicator );
-        EdgeWeight edge_cut_second( parallel_graph_access & G, MPI_Comm communicator  );
+        // sums over all edges are 64 bits wide, also with PARHIP32BIT 
+        ULONG edge_cut( parallel_graph_access & G, MPI_Comm communicator );
+        ULONG edge_cut_second( parallel_graph_access & G, MPI_Comm communicator  );
         NodeWeight local_max_block_weight( PPartitionConfig & config, parallel_graph_access & G, int * partition_map, MPI_Comm communicator  );
         double balance( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator  );
         double balance_load( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator  );
         double balance_load_dist( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator  );
         double balance_second( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator  );
-	EdgeWeight comm_vol( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator  );
-	EdgeWeight comm_vol_dist( parallel_graph_access & G, MPI_Comm communicator );
+	ULONG comm_vol( PPartitionConfig & config, parallel_graph_access & G, MPI_Comm communicator  );
+	ULONG comm_vol_dist( parallel_graph_access & G, MPI_Comm communicator );
 };
 
 
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * edge_list_converter_test.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "io/edge_list_converter.h"
+
+// converts a small input in both formats and compares the METIS output with the expected graph.
+// usage: edge_list_converter_test <work directory>
+
+static std::string convert( const std::string & directory, const std::string & input, EdgeListFormat format ) {
+        std::string input_filename  = directory + "/edge_list_converter_test.txt";
+        std::string output_filename = directory + "/edge_list_converter_test.graph";
+        std::ofstream(input_filename.c_str()) << input;
+
+        edge_list_converter converter(1);
+        if( converter.convert(input_filename, output_filename, 1, format) ) return "";
+
+        std::ifstream in(output_filename.c_str());
+        std::stringstream graph;
+        graph << in.rdbuf();
+        std::remove(input_filename.c_str());
+        std::remove(output_filename.c_str());
+        return graph.str();
+}
+
+static bool check( const std::string & name, const std::string & result, const std::string & expected ) {
+        if( result == expected ) return true;
+        std::cerr <<  name << ": expected\n" << expected << "got\n" << result << std::endl;
+        return false;
+}
+
+int main(int argn, char **argv) {
+        if( argn != 2 ) {
+                std::cerr <<  "usage: " << argv[0] << " directory"  << std::endl;
+                return 1;
+        }
+        std::string directory(argv[1]);
+
+        // a triangle with a third column, e.g. weights or timestamps, that must not become targets
+        std::string weighted_edge_list = "% source target weight\n"
+                                         "10 20 100\n"
+                                         "20 30 7\n"
+                                         "30 10 5\n"
+                                         "30 30 40\n";
+        std::string triangle = "3 3\n 2 3\n 1 3\n 1 2\n";
+
+        // the same triangle given as adjacency lines
+        std::string adjacency = "% source targets\n"
+                                "10 20 30\n"
+                                "20 30\n";
+
+        bool ok = check("edge list", convert(directory, weighted_edge_list, EDGE_LIST_PAIRS), triangle);
+        ok = check("adjacency", convert(directory, adjacency, EDGE_LIST_ADJACENCY), triangle) && ok;
+        return ok ? 0 : 1;
+}
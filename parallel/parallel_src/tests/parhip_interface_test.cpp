@@ -0,0 +1,94 @@
+/******************************************************************************
+ * parhip_interface_test.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <mpi.h>
+
+#include "parhip_interface.h"
+
+// partitions a grid through the library interface and checks the reported cut. with
+// PARHIP32BIT node ids and node weights have 32 bits while edge ids keep 64 bits, so
+// the interface has to reject a graph whose total node weight does not fit instead of
+// truncating it
+int main(int argn, char **argv) {
+        MPI_Init(&argn, &argv);
+        MPI_Comm comm = MPI_COMM_WORLD;
+        int rank, size;
+        MPI_Comm_rank( comm, &rank);
+        MPI_Comm_size( comm, &size);
+
+        const idxtype side = 32;
+        const idxtype n    = side*side;
+        std::vector< idxtype > vtxdist(size+1);
+        for( int p = 0; p <= size; p++) {
+                vtxdist[p] = p*n/size;
+        }
+
+        std::vector< idxtype > xadj(1, 0);
+        std::vector< idxtype > adjncy;
+        for( idxtype node = vtxdist[rank]; node < vtxdist[rank+1]; node++) {
+                idxtype row = node / side, col = node % side;
+                if( row > 0 )        adjncy.push_back(node - side);
+                if( col > 0 )        adjncy.push_back(node - 1);
+                if( col + 1 < side ) adjncy.push_back(node + 1);
+                if( row + 1 < side ) adjncy.push_back(node + side);
+                xadj.push_back(adjncy.size());
+        }
+
+        int nparts       = 4;
+        double imbalance = 0.03;
+        int edgecut      = 0;
+        std::vector< idxtype > part(xadj.size() - 1);
+        ParHIPPartitionKWay(vtxdist.data(), xadj.data(), adjncy.data(), NULL, NULL, &nparts, &imbalance, true, 0, FASTMESH, &edgecut, part.data(), &comm);
+
+        std::vector< int > counts(size), displs(size);
+        for( int p = 0; p < size; p++) {
+                counts[p] = vtxdist[p+1] - vtxdist[p];
+                displs[p] = vtxdist[p];
+        }
+        std::vector< idxtype > global_part(n);
+        MPI_Allgatherv(part.data(), part.size(), MPI_UNSIGNED_LONG_LONG, global_part.data(), counts.data(), displs.data(), MPI_UNSIGNED_LONG_LONG, comm);
+
+        int failed = 0;
+        long long cut = 0;
+        for( idxtype node = 0; node < n; node++) {
+                if( global_part[node] >= (idxtype)nparts ) failed = 1;
+        }
+        for( idxtype i = 0; i + 1 < xadj.size(); i++) {
+                for( idxtype e = xadj[i]; e < xadj[i+1]; e++) {
+                        if( global_part[vtxdist[rank] + i] != global_part[adjncy[e]] ) cut++;
+                }
+        }
+        long long global_cut = 0;
+        MPI_Allreduce(&cut, &global_cut, 1, MPI_LONG_LONG, MPI_SUM, comm);
+        if( edgecut < 0 || global_cut/2 != edgecut ) failed = 1;
+        if( rank == 0 && failed ) std::cerr <<  "grid: reported cut " << edgecut << ", actual cut " << global_cut/2 << std::endl;
+
+#ifdef PARHIP32BIT
+        // every PE has one isolated node of weight 2^32, the interface has to bail out
+        // before the weight is stored
+        std::vector< idxtype > heavy_vtxdist(size+1);
+        for( int p = 0; p <= size; p++) {
+                heavy_vtxdist[p] = p;
+        }
+        idxtype heavy_xadj[2] = {0, 0};
+        idxtype heavy_vwgt[1] = {1ULL << 32};
+        idxtype heavy_part[1] = {0};
+        int heavy_edgecut     = 0;
+        ParHIPPartitionKWay(heavy_vtxdist.data(), heavy_xadj, NULL, heavy_vwgt, NULL, &nparts, &imbalance, true, 0, FASTMESH, &heavy_edgecut, heavy_part, &comm);
+        if( heavy_edgecut != -1 ) {
+                if( rank == 0 ) std::cerr <<  "node weight 2^32 was not rejected by the 32 bit build"  << std::endl;
+                failed = 1;
+        }
+#endif
+
+        int any_failed = 0;
+        MPI_Allreduce(&failed, &any_failed, 1, MPI_INT, MPI_MAX, comm);
+        MPI_Finalize();
+        return any_failed;
+}
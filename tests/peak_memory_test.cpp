@@ -0,0 +1,88 @@
+/******************************************************************************
+ * peak_memory_test.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// runs kaffpa on a grid with and without the given memory saving options, e.g.
+// --hierarchy_memory_budget or --compress_finest_level, and compares the peak resident
+// set sizes of both runs. the run with the options has to stay clearly below the other one.
+// usage: peak_memory_test <kaffpa binary> <work directory> <options>...
+
+static void write_grid(const std::string & filename, int side) {
+        std::ofstream f(filename.c_str());
+        f << side*side << " " << 2*side*(side-1) << "\n";
+        for( int row = 0; row < side; row++) {
+                for( int col = 0; col < side; col++) {
+                        int node = row*side + col + 1;
+                        if( row > 0 )        f << node - side << " ";
+                        if( col > 0 )        f << node - 1 << " ";
+                        if( col + 1 < side ) f << node + 1 << " ";
+                        if( row + 1 < side ) f << node + side << " ";
+                        f << "\n";
+                }
+        }
+}
+
+// peak resident set size of the run in KB, -1 if the run failed
+static long peak_rss(const std::string & kaffpa, const std::string & graph, const std::vector< std::string > & options) {
+        std::vector< std::string > args = { kaffpa, graph, "--k=16", "--preconfiguration=fast", 
+                                            "--output_filename=" + graph + ".part" };
+        args.insert(args.end(), options.begin(), options.end());
+
+        pid_t pid = fork();
+        if( pid == 0 ) {
+                std::vector< char* > argv;
+                for( std::string & arg : args ) argv.push_back(&arg[0]);
+                argv.push_back(NULL);
+                if( freopen("/dev/null", "w", stdout) == NULL ) _exit(1);
+                execv(kaffpa.c_str(), argv.data());
+                _exit(1);
+        }
+
+        int status = 0;
+        struct rusage usage;
+        if( pid < 0 || wait4(pid, &status, 0, &usage) != pid ) return -1;
+        if( !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) return -1;
+        return usage.ru_maxrss;
+}
+
+int main(int argn, char **argv) {
+        if( argn < 4 ) {
+                std::cerr <<  "usage: " << argv[0] << " kaffpa directory options"  << std::endl;
+                return 1;
+        }
+        std::string kaffpa(argv[1]);
+        std::string directory(argv[2]);
+        std::vector< std::string > options(argv + 3, argv + argn);
+        // several tests may run in the same directory at once
+        std::string graph = directory + "/peak_memory_test." + std::to_string(getpid()) + ".graph";
+        write_grid(graph, 800);
+
+        long plain  = peak_rss(kaffpa, graph, std::vector< std::string >());
+        long saving = peak_rss(kaffpa, graph, options);
+        unlink(graph.c_str());
+        unlink((graph + ".part").c_str());
+
+        std::string joined;
+        for( const std::string & option : options ) joined += " " + option;
+        std::cout <<  "peak rss " << plain/1024 << " MB, with" << joined << " " << saving/1024 << " MB"  << std::endl;
+        if( plain < 0 || saving < 0 ) {
+                std::cerr <<  "kaffpa failed"  << std::endl;
+                return 1;
+        }
+        if( 10*saving > 9*plain ) {
+                std::cerr <<  "the options did not lower the peak resident set size"  << std::endl;
+                return 1;
+        }
+        return 0;
+}